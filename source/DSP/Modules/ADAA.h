@@ -0,0 +1,379 @@
+//
+// Created by Landon Viator on 11/8/25.
+//
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+#include <vector>
+
+namespace viator::dsp::adaa
+{
+    // Antiderivative Anti-Aliasing (ADAA) für statische Kennlinien.
+    //
+    // Statt f(x) wird der Mittelwert von f zwischen den letzten Samples
+    // ausgegeben, gerechnet über die Stammfunktionen: erste Ordnung über F1,
+    // zweite Ordnung über F2. Das dämpft Aliasing grob wie zusätzliches 2-4x
+    // Oversampling, mit 2x Oversampling davor reicht es meist statt 8x/16x.
+    //
+    //   - Ordnung 1 verzögert um ein halbes Sample, Ordnung 2 um ein ganzes,
+    //     beide dämpfen die Höhen leicht (wie ein kurzer Mittelwertfilter).
+    //   - Liegen die Samples zu nah beieinander (Auslöschung in der
+    //     Differenz), wird auf f bzw. F1 in der Mitte zurückgefallen.
+    //   - Gerechnet wird in double, die Differenzen großer Stammfunktionen
+    //     sind in float zu ungenau.
+    //
+    // Eine Kennlinie (Shape) hat f(x), F1(x) und F2(x) in double. Parameter
+    // (Drive usw.) stecken im Shape; ändern sie sich, rechnet nur das neue
+    // Sample mit dem neuen Wert, die Historie bleibt (Fehler nur während
+    // einer Rampe).
+    enum class Order
+    {
+        kOff,
+        kFirst,
+        kSecond
+    };
+
+    inline const juce::StringArray items = { "AA Off", "ADAA 1", "ADAA 2" };
+
+    inline constexpr double kTolerance = 1.0e-5;
+
+    class FirstOrder
+    {
+    public:
+        template <typename Shape>
+        void reset(const Shape &shape, const double x = 0.0)
+        {
+            m_x1 = x;
+            m_f1_x1 = shape.F1(x);
+        }
+
+        template <typename Shape>
+        float process(const Shape &shape, const float input)
+        {
+            const double x = input;
+            const double f1_x = shape.F1(x);
+            const double dx = x - m_x1;
+
+            const double yn = std::abs(dx) < kTolerance
+                                  ? shape.f(0.5 * (x + m_x1))
+                                  : (f1_x - m_f1_x1) / dx;
+
+            m_x1 = x;
+            m_f1_x1 = f1_x;
+            return static_cast<float>(yn);
+        }
+
+    private:
+        double m_x1 = 0.0;
+        double m_f1_x1 = 0.0;
+    };
+
+    class SecondOrder
+    {
+    public:
+        template <typename Shape>
+        void reset(const Shape &shape, const double x = 0.0)
+        {
+            m_x1 = x;
+            m_x2 = x;
+            m_f2_x1 = shape.F2(x);
+            m_d1 = shape.F1(x);
+        }
+
+        template <typename Shape>
+        float process(const Shape &shape, const float input)
+        {
+            const double x = input;
+            const double f2_x = shape.F2(x);
+
+            // Mittelwert von F1 zwischen x und x1
+            const double dx = x - m_x1;
+            const double d1 = std::abs(dx) < kTolerance
+                                  ? shape.F1(0.5 * (x + m_x1))
+                                  : (f2_x - m_f2_x1) / dx;
+
+            double yn;
+            const double dx2 = x - m_x2;
+
+            if (std::abs(dx2) >= kTolerance)
+            {
+                yn = 2.0 * (d1 - m_d1) / dx2;
+            }
+            else
+            {
+                // x ≈ x2: Grenzwert um die Mitte der beiden
+                const double mid = 0.5 * (x + m_x2);
+                const double delta = mid - m_x1;
+
+                yn = std::abs(delta) < kTolerance
+                         ? shape.f(0.5 * (mid + m_x1))
+                         : 2.0 / delta * (shape.F1(mid) + (m_f2_x1 - shape.F2(mid)) / delta);
+            }
+
+            m_x2 = m_x1;
+            m_x1 = x;
+            m_f2_x1 = f2_x;
+            m_d1 = d1;
+            return static_cast<float>(yn);
+        }
+
+    private:
+        double m_x1 = 0.0;
+        double m_x2 = 0.0;
+        double m_f2_x1 = 0.0;
+        double m_d1 = 0.0;
+    };
+
+    // Beide Ordnungen für einen Kanal, umschalten setzt die Historie auf x
+    // zurück (sonst knackt es mit alten Werten). Ohne ADAA rechnet der Aufrufer
+    // die Kennlinie selbst und ruft nur bypass().
+    class Processor
+    {
+    public:
+        void bypass() { m_order = Order::kOff; }
+
+        template <typename Shape>
+        float process(const Shape &shape, const float input, const Order order)
+        {
+            if (order != m_order)
+            {
+                m_order = order;
+                m_first.reset(shape, input);
+                m_second.reset(shape, input);
+            }
+
+            switch (order)
+            {
+                case Order::kFirst: return m_first.process(shape, input);
+                case Order::kSecond: return m_second.process(shape, input);
+                case Order::kOff: break;
+            }
+
+            return static_cast<float>(shape.f(input));
+        }
+
+        template <typename Shape>
+        void reset(const Shape &shape)
+        {
+            m_first.reset(shape);
+            m_second.reset(shape);
+        }
+
+    private:
+        Order m_order = Order::kOff;
+        FirstOrder m_first;
+        SecondOrder m_second;
+    };
+
+    //==============================================================================
+    // Kennlinien mit geschlossenen Stammfunktionen
+
+    // clamp(x, -1, 1)
+    struct HardClip
+    {
+        double f(const double x) const { return juce::jlimit(-1.0, 1.0, x); }
+
+        double F1(const double x) const
+        {
+            return std::abs(x) <= 1.0 ? 0.5 * x * x : std::abs(x) - 0.5;
+        }
+
+        double F2(const double x) const
+        {
+            if (std::abs(x) <= 1.0)
+                return x * x * x / 6.0;
+
+            const double sign = x > 0.0 ? 1.0 : -1.0;
+            return sign * (0.5 * x * x + 1.0 / 6.0) - 0.5 * x;
+        }
+    };
+
+    // atan(x)
+    struct Atan
+    {
+        double f(const double x) const { return std::atan(x); }
+
+        double F1(const double x) const
+        {
+            return x * std::atan(x) - 0.5 * std::log1p(x * x);
+        }
+
+        double F2(const double x) const
+        {
+            return 0.5 * (x * x - 1.0) * std::atan(x) + 0.5 * x - 0.5 * x * std::log1p(x * x);
+        }
+    };
+
+    // x + k / 2pi * sin(2pi x), ConsoleModule
+    struct SineFold
+    {
+        double k = 0.0;
+
+        double f(const double x) const
+        {
+            return x + k / two_pi * std::sin(two_pi * x);
+        }
+
+        double F1(const double x) const
+        {
+            return 0.5 * x * x - k / (two_pi * two_pi) * std::cos(two_pi * x);
+        }
+
+        double F2(const double x) const
+        {
+            return x * x * x / 6.0 - k / (two_pi * two_pi * two_pi) * std::sin(two_pi * x);
+        }
+
+        static constexpr double two_pi = juce::MathConstants<double>::twoPi;
+    };
+
+    // Poletti Waveshaper aus dem MasterBus: u = k * x,
+    // x >= 0: u / (1 + u / lp), x < 0: u / (1 - u / ln). k, lp, ln > 0.
+    struct Poletti
+    {
+        double k = 1.0;
+        double lp = 1.0;
+        double ln = 1.0;
+
+        double f(const double x) const
+        {
+            const double u = k * x;
+            return x >= 0.0 ? u / (1.0 + u / lp) : u / (1.0 - u / ln);
+        }
+
+        double F1(const double x) const
+        {
+            if (x >= 0.0)
+                return lp * x - lp * lp / k * std::log1p(k * x / lp);
+
+            return -ln * x - ln * ln / k * std::log1p(-k * x / ln);
+        }
+
+        double F2(const double x) const
+        {
+            if (x >= 0.0)
+            {
+                const double a = k / lp;
+                return 0.5 * lp * x * x - lp * lp * lp / (k * k) * (1.0 + a * x) * std::log1p(a * x)
+                       + lp * lp / k * x;
+            }
+
+            const double b = k / ln;
+            return -0.5 * ln * x * x + ln * ln * ln / (k * k) * (1.0 - b * x) * std::log1p(-b * x)
+                   + ln * ln / k * x;
+        }
+    };
+
+    //==============================================================================
+    // Für Kennlinien ohne geschlossene Stammfunktion (Tube): f, F1 und F2 auf
+    // einem Raster, dazwischen kubisch nach Hermite mit den exakten
+    // Ableitungen F1' = f und F2' = F1. Außerhalb von [-range, range] gilt f
+    // als konstant, die Kennlinie muss dort also in der Sättigung sein.
+    //
+    // Bauen (Konstruktor) alloziert, nur Message Thread bzw. einmalig statisch.
+    class TabulatedShape
+    {
+    public:
+        template <typename Function>
+        TabulatedShape(Function &&function, const double range, const int size)
+            : m_range(range), m_step(2.0 * range / (size - 1)),
+              m_f(static_cast<size_t>(size)), m_f1(static_cast<size_t>(size)), m_f2(static_cast<size_t>(size))
+        {
+            jassert(size > 1 && range > 0.0);
+
+            // Simpson für F1, Trapez mit Endkorrektur (F1' = f) für F2,
+            // jeweils mit feineren Schritten zwischen den Stützstellen
+            constexpr int sub_steps = 8;
+            const double h = m_step / sub_steps;
+
+            double x = -range;
+            double fx = function(x);
+            double f1 = 0.0;
+            double f2 = 0.0;
+
+            m_f[0] = fx;
+
+            for (size_t i = 1; i < m_f.size(); ++i)
+            {
+                for (int s = 0; s < sub_steps; ++s)
+                {
+                    const double f_mid = function(x + 0.5 * h);
+                    const double f_next = function(x + h);
+                    const double f1_next = f1 + h / 6.0 * (fx + 4.0 * f_mid + f_next);
+
+                    f2 += 0.5 * h * (f1 + f1_next) - h * h / 12.0 * (f_next - fx);
+                    f1 = f1_next;
+                    fx = f_next;
+                    x += h;
+                }
+
+                m_f[i] = fx;
+                m_f1[i] = f1;
+                m_f2[i] = f2;
+            }
+        }
+
+        double f(const double x) const
+        {
+            if (x <= -m_range) return m_f.front();
+            if (x >= m_range) return m_f.back();
+
+            size_t index;
+            const double t = locate(x, index);
+            return m_f[index] + t * (m_f[index + 1] - m_f[index]);
+        }
+
+        double F1(const double x) const
+        {
+            if (x <= -m_range) return m_f1.front() + m_f.front() * (x + m_range);
+            if (x >= m_range) return m_f1.back() + m_f.back() * (x - m_range);
+
+            return hermite(m_f1, m_f, x);
+        }
+
+        double F2(const double x) const
+        {
+            if (x <= -m_range)
+            {
+                const double d = x + m_range;
+                return m_f2.front() + m_f1.front() * d + 0.5 * m_f.front() * d * d;
+            }
+
+            if (x >= m_range)
+            {
+                const double d = x - m_range;
+                return m_f2.back() + m_f1.back() * d + 0.5 * m_f.back() * d * d;
+            }
+
+            return hermite(m_f2, m_f1, x);
+        }
+
+    private:
+        double locate(const double x, size_t &index) const
+        {
+            const double position = (x + m_range) / m_step;
+            index = juce::jmin(static_cast<size_t>(position), m_f.size() - 2);
+            return position - static_cast<double>(index);
+        }
+
+        // values mit Ableitung slopes, kubisch zwischen zwei Stützstellen
+        double hermite(const std::vector<double> &values, const std::vector<double> &slopes, const double x) const
+        {
+            size_t index;
+            const double t = locate(x, index);
+            const double t2 = t * t;
+            const double t3 = t2 * t;
+
+            return (2.0 * t3 - 3.0 * t2 + 1.0) * values[index]
+                   + (t3 - 2.0 * t2 + t) * m_step * slopes[index]
+                   + (-2.0 * t3 + 3.0 * t2) * values[index + 1]
+                   + (t3 - t2) * m_step * slopes[index + 1];
+        }
+
+        const double m_range;
+        const double m_step;
+        std::vector<double> m_f, m_f1, m_f2;
+    };
+}
@@ -4,44 +4,207 @@
 
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include "BlockSmoother.h"
+#include <array>
+#include <concepts>
+#include <span>
+#include <vector>
 
 namespace viator::dsp
 {
+    // Ein Kanal eines Blocks, so wie ihn der Kernel eines Moduls bekommt.
+    // samples liegt am Stück, Input-Gain ist schon drin.
+    template <typename SampleType>
+    struct ChannelContext
+    {
+        std::span<SampleType> samples;
+        size_t channel;
+    };
+
+    // Kernel über einen ganzen Kanal-Block
+    template <typename Module, typename SampleType>
+    concept BlockKernel = requires(Module &module, ChannelContext<SampleType> &context)
+    {
+        module.processChannel(context);
+    };
+
+    // Kernel pro Sample, nicht virtuell: die Schleife steht in der Basis und
+    // der Compiler sieht den Kernel komplett (inline, vektorisierbar)
+    template <typename Module, typename SampleType>
+    concept SampleKernel = requires(Module &module, SampleType xn, size_t channel)
+    {
+        { module.processSample(xn, channel) } -> std::convertible_to<SampleType>;
+    };
+
+    // CRTP-Basis für die DSP-Module: Derived hat entweder processChannel()
+    // (BlockKernel) oder processSample(xn, channel) (SampleKernel), optional
+    // prepareModule(spec). Kein virtual, kein Aufruf pro Sample über einen Pointer.
+    // Die Kernels müssen public sein, die Concepts prüfen von außen.
+    //
+    // Input, Output und Mix werden hier blockweise gerechnet: läuft ein
+    // Smoother nicht, ist es eine Multiplikation mit einer Konstanten (bzw.
+    // gar nichts bei 1), sonst kommt die Rampe vom BlockSmoother und geht
+    // mit FloatVectorOperations drauf. Eigene Smoother der Module sind auch
+    // BlockSmoother, prepareModule() bekommt die Blockgröße in spec.
+    //
+    // SimdWidth: Hinweis für die Puffer (Länge auf ein Vielfaches gerundet),
+    // 0 = Breite von SIMDRegister auf dieser Plattform.
+    template <typename Derived, typename SampleType = float, size_t SimdWidth = 0>
     class BaseDspModule
     {
     public:
-        BaseDspModule() = default;
+        static constexpr size_t kMaxChannels = 2;
+        static constexpr int kNumScratch = 2;
+
+       #if JUCE_USE_SIMD
+        static constexpr size_t kSimdWidth = SimdWidth > 0 ? SimdWidth
+                                                           : juce::dsp::SIMDRegister<SampleType>::SIMDNumElements;
+       #else
+        static constexpr size_t kSimdWidth = SimdWidth > 0 ? SimdWidth : 1;
+       #endif
+
+        BaseDspModule()
+        {
+            for (size_t i = 0; i < kMaxChannels; ++i)
+            {
+                m_input_smoothers[i].setCurrentAndTargetValue(1);
+                m_output_smoothers[i].setCurrentAndTargetValue(1);
+                m_mix_smoothers[i].setCurrentAndTargetValue(1);
+            }
+        }
 
-        void prepare(juce::dsp::ProcessSpec& spec)
+        void prepare(const juce::dsp::ProcessSpec &spec)
         {
-            for (int i = 0; i < m_input_smoothers.size(); ++i)
+            const auto sample_rate = spec.sampleRate <= 0.0 ? 44100.0 : spec.sampleRate;
+
+            m_max_block_size = juce::jmax(1, static_cast<int>(spec.maximumBlockSize));
+            const auto padded = (static_cast<size_t>(m_max_block_size) + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+
+            for (size_t i = 0; i < kMaxChannels; ++i)
+            {
+                m_input_smoothers[i].prepare(sample_rate, 0.02, m_max_block_size);
+                m_output_smoothers[i].prepare(sample_rate, 0.02, m_max_block_size);
+                m_mix_smoothers[i].prepare(sample_rate, 0.02, m_max_block_size);
+            }
+
+            m_dry.assign(padded, SampleType(0));
+
+            for (size_t i = 0; i < m_scratch.size(); ++i)
             {
-                m_input_smoothers[i].reset(spec.sampleRate, 0.02);
-                m_output_smoothers[i].reset(spec.sampleRate, 0.02);
-                m_mix_smoothers[i].reset(spec.sampleRate, 0.02);
+                m_scratch_storage[i].assign(padded + kAlignReserve, SampleType(0));
+                m_scratch[i] = alignScratch(m_scratch_storage[i].data());
+            }
+
+            if constexpr (requires { derived().prepareModule(spec); })
+            {
+                derived().prepareModule(spec);
             }
         }
 
-        void processBlock(juce::dsp::AudioBlock<float>& block, const int num_samples)
+        void processBlock(juce::dsp::AudioBlock<SampleType> &block, const int num_samples)
         {
-            for (size_t channel = 0; channel < block.getNumChannels(); ++channel) {
-                auto *data = block.getChannelPointer(channel);
-                for (size_t sample = 0; sample < num_samples; ++sample) {
-                    const float xn = data[sample];
-                    const float yn = processSample(xn);
-                    data[sample] = yn;
+            const auto num_channels = juce::jmin(block.getNumChannels(), kMaxChannels);
+
+            // Größere Blöcke als angekündigt in Stücken, die Puffer reichen nur so weit
+            for (int offset = 0; offset < num_samples; offset += m_max_block_size)
+            {
+                const auto length = juce::jmin(m_max_block_size, num_samples - offset);
+
+                for (size_t channel = 0; channel < num_channels; ++channel)
+                {
+                    processChannelBlock(block.getChannelPointer(channel) + offset, channel, length);
                 }
             }
         }
 
-        virtual float processSample(float xn) = 0;
+        using Smoothers = std::array<BlockSmoother<SampleType>, kMaxChannels>;
 
-        std::array<juce::SmoothedValue<float>, 2>& getInputs() { return m_input_smoothers; }
-        std::array<juce::SmoothedValue<float>, 2>& getOutputs() { return m_output_smoothers; }
-        std::array<juce::SmoothedValue<float>, 2>& getMixes() { return m_mix_smoothers; }
+        Smoothers &getInputs() { return m_input_smoothers; }
+        Smoothers &getOutputs() { return m_output_smoothers; }
+        Smoothers &getMixes() { return m_mix_smoothers; }
+
+    protected:
+        // Puffer für eigene Rampen der Module, slot < kNumScratch. SIMD-aligned
+        // und auf volle Breite aufgerundet, geht also direkt in SIMD-Kernels.
+        SampleType *getScratch(const int slot) { return m_scratch[static_cast<size_t>(slot)]; }
 
     private:
+        // Reserve hinter den Scratch-Puffern fürs Ausrichten
+        static constexpr size_t kAlignReserve = 16;
+
+        Derived &derived() { return static_cast<Derived &>(*this); }
+
+        static SampleType *alignScratch(SampleType *pointer)
+        {
+           #if JUCE_USE_SIMD
+            return juce::dsp::SIMDRegister<SampleType>::getNextSIMDAlignedPtr(pointer);
+           #else
+            return pointer;
+           #endif
+        }
+
+        void processChannelBlock(SampleType *data, const size_t channel, const int num_samples)
+        {
+            const auto mix = m_mix_smoothers[channel].getRamp(num_samples);
+            const bool use_mix = !mix.isConstant() || mix.value < SampleType(1);
+
+            if (use_mix)
+            {
+                juce::FloatVectorOperations::copy(m_dry.data(), data, num_samples);
+            }
+
+            applyGain(m_input_smoothers[channel], data, num_samples);
+
+            if constexpr (BlockKernel<Derived, SampleType>)
+            {
+                ChannelContext<SampleType> context{std::span<SampleType>(data, static_cast<size_t>(num_samples)), channel};
+                derived().processChannel(context);
+            }
+            else
+            {
+                static_assert(SampleKernel<Derived, SampleType>,
+                              "Module braucht processChannel(ChannelContext&) oder processSample(xn, channel)");
+
+                auto &module = derived();
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    data[sample] = module.processSample(data[sample], channel);
+                }
+            }
+
+            applyGain(m_output_smoothers[channel], data, num_samples);
+
+            if (use_mix)
+            {
+                // dry + (wet - dry) * mix
+                juce::FloatVectorOperations::subtract(data, m_dry.data(), num_samples);
+                if (mix.isConstant())
+                    juce::FloatVectorOperations::multiply(data, mix.value, num_samples);
+                else
+                    juce::FloatVectorOperations::multiply(data, mix.values, num_samples);
+                juce::FloatVectorOperations::add(data, m_dry.data(), num_samples);
+            }
+        }
+
+        static void applyGain(BlockSmoother<SampleType> &smoother, SampleType *data, const int num_samples)
+        {
+            const auto gain = smoother.getRamp(num_samples);
+
+            if (!gain.isConstant())
+            {
+                juce::FloatVectorOperations::multiply(data, gain.values, num_samples);
+            }
+            else if (gain.value != SampleType(1))
+            {
+                juce::FloatVectorOperations::multiply(data, gain.value, num_samples);
+            }
+        }
+
+        Smoothers m_input_smoothers, m_output_smoothers, m_mix_smoothers;
 
-        std::array<juce::SmoothedValue<float>, 2> m_input_smoothers, m_output_smoothers, m_mix_smoothers;
+        int m_max_block_size{512};
+        std::vector<SampleType> m_dry;
+        std::array<std::vector<SampleType>, kNumScratch> m_scratch_storage;
+        std::array<SampleType *, kNumScratch> m_scratch{};
     };
 }
@@ -0,0 +1,120 @@
+//
+// Created by Landon Viator on 11/22/25.
+//
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+
+namespace viator::dsp
+{
+    // Ein Parameter für einen Block: entweder konstant (values == nullptr,
+    // dann gilt value) oder eine Rampe values[0 .. num_samples).
+    template <typename SampleType>
+    struct ParameterRamp
+    {
+        const SampleType *values{nullptr};
+        SampleType value{};
+
+        bool isConstant() const { return values == nullptr; }
+
+        SampleType operator[](const int sample) const { return values != nullptr ? values[sample] : value; }
+
+        // kernel(at) mit at(sample) -> Wert. Wird für den konstanten und den
+        // Rampen-Fall getrennt instanziiert, im konstanten Fall sieht der
+        // Compiler also nur eine Konstante (kein Load, keine Verzweigung).
+        template <typename Kernel>
+        decltype(auto) visit(Kernel &&kernel) const
+        {
+            if (values == nullptr)
+                return kernel([constant = value](int) { return constant; });
+
+            return kernel([ramp = values](const int sample) { return ramp[sample]; });
+        }
+    };
+
+    // juce::SmoothedValue, aber blockweise: getRamp() schreibt die Rampe für
+    // den ganzen Block in einen eigenen (aligned) Puffer, oder meldet
+    // konstant, wenn der Wert steht. Im eingeschwungenen Zustand kostet das
+    // also nichts, kein getNextValue() pro Sample mehr.
+    //
+    // SmoothingType: juce::ValueSmoothingTypes::Linear oder Multiplicative.
+    template <typename SampleType = float, typename SmoothingType = juce::ValueSmoothingTypes::Linear>
+    class BlockSmoother
+    {
+    public:
+        explicit BlockSmoother(const SampleType initial = SampleType(0))
+        {
+            m_smoother.setCurrentAndTargetValue(initial);
+        }
+
+        // Nicht im Audio Thread, alloziert. max_block_size: längste Rampe,
+        // die getRamp() liefern muss.
+        void prepare(const double sample_rate, const double ramp_seconds, const int max_block_size)
+        {
+            m_smoother.reset(sample_rate <= 0.0 ? 44100.0 : sample_rate, ramp_seconds);
+
+            m_max_block_size = juce::jmax(1, max_block_size);
+            m_storage.assign(static_cast<size_t>(m_max_block_size) + 16, SampleType(0));
+           #if JUCE_USE_SIMD
+            m_ramp = juce::dsp::SIMDRegister<SampleType>::getNextSIMDAlignedPtr(m_storage.data());
+           #else
+            m_ramp = m_storage.data();
+           #endif
+        }
+
+        void setTargetValue(const SampleType value) { m_smoother.setTargetValue(value); }
+        void setCurrentAndTargetValue(const SampleType value) { m_smoother.setCurrentAndTargetValue(value); }
+
+        SampleType getTargetValue() const { return m_smoother.getTargetValue(); }
+        SampleType getCurrentValue() const { return m_smoother.getCurrentValue(); }
+        bool isSmoothing() const { return m_smoother.isSmoothing(); }
+        int getMaxBlockSize() const { return m_max_block_size; }
+
+        SampleType skip(const int num_steps) { return m_smoother.skip(num_steps); }
+
+        // Rampe für num_samples. num_steps: um wie viele Schritte der Smoother
+        // weiterläuft, wenn der Block eine andere Rate hat als die aus
+        // prepare() (oversampled). Dann wird linear von Anfang bis Ende über
+        // den Block gestreckt.
+        ParameterRamp<SampleType> getRamp(const int num_samples, const int num_steps = -1)
+        {
+            if (!m_smoother.isSmoothing())
+                return { nullptr, m_smoother.getTargetValue() };
+
+            jassert(m_ramp != nullptr && num_samples <= m_max_block_size);
+            const auto length = juce::jmin(num_samples, m_max_block_size);
+
+            if (num_steps < 0 || num_steps == length)
+            {
+                for (int sample = 0; sample < length; ++sample)
+                {
+                    m_ramp[sample] = m_smoother.getNextValue();
+                }
+            }
+            else
+            {
+                const auto start = m_smoother.getCurrentValue();
+                const auto end = m_smoother.skip(num_steps);
+                const auto step = (end - start) / static_cast<SampleType>(length);
+
+                for (int sample = 0; sample < length; ++sample)
+                {
+                    m_ramp[sample] = start + step * static_cast<SampleType>(sample + 1);
+                }
+            }
+
+            return { m_ramp, m_ramp[length - 1] };
+        }
+
+    private:
+        juce::SmoothedValue<SampleType, SmoothingType> m_smoother;
+
+        int m_max_block_size{0};
+        std::vector<SampleType> m_storage;
+        SampleType *m_ramp{nullptr};
+
+        JUCE_DECLARE_NON_COPYABLE(BlockSmoother)
+    };
+}
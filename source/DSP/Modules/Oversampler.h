@@ -0,0 +1,662 @@
+//
+// Created by Landon Viator on 11/19/25.
+//
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <vector>
+
+namespace viator::dsp
+{
+    // Oversampler aus kaskadierten 2X-Stufen mit Polyphasen-FIR, als Ersatz
+    // für juce::dsp::Oversampling (gleiche Schnittstelle: initProcessing,
+    // processSamplesUp/Down, reset, getLatencyInSamples).
+    //
+    //   - Jede Stufe ist in zwei Zweige zerlegt (gerade/ungerade Taps), es
+    //     wird also nie mit eingefügten Nullen gerechnet. Beim linearphasigen
+    //     Halbband ist ein Zweig ein reines Delay, der andere ein FIR.
+    //   - Die FIRs rechnen mit SIMDRegister über die Taps. Stereo kann
+    //     verschränkt laufen (L R L R in einem Register), dann teilen sich
+    //     beide Kanäle eine Historie und eine Multiplikation pro Tap-Paar.
+    //   - Linearphasig: Latenz exakt (Filtermitte), kein Phasengang.
+    //     Minimalphasig: aus dem gleichen Prototyp über das Cepstrum, deutlich
+    //     weniger Latenz, dafür Phasendrehung in den Höhen. Gemeldet wird die
+    //     Gruppenlaufzeit bei DC.
+    //   - Qualität = Sperrdämpfung und Durchlassbereich der ersten Stufe, die
+    //     weiteren Stufen haben mehr Übergangsbereich und werden kürzer.
+    //
+    // Konstruktor und initProcessing() allozieren (Message Thread oder
+    // Hintergrund), die process-Funktionen nie.
+    class Oversampler
+    {
+    public:
+        enum class Phase
+        {
+            kLinear,
+            kMinimum
+        };
+
+        enum class Quality
+        {
+            kLow,
+            kMedium,
+            kHigh
+        };
+
+        // factor wie bei juce::dsp::Oversampling: 1 = 2X .. 4 = 16X
+        Oversampler(const size_t numChannels, const size_t factor, const Phase phase = Phase::kLinear,
+                    const Quality quality = Quality::kHigh, const bool interleaveStereo = true)
+            : m_num_channels(static_cast<int>(numChannels)), m_factor(static_cast<int>(factor))
+        {
+            jassert(numChannels > 0 && factor > 0 && factor <= 4);
+
+            const bool interleave = interleaveStereo && m_num_channels == 2;
+            const int stride = interleave ? 2 : 1;
+
+            // Reserviert, die Zweige zeigen in ihre eigenen Puffer
+            m_stages.reserve(static_cast<size_t>(m_factor));
+
+            for (int stage = 0; stage < m_factor; ++stage)
+            {
+                const auto taps = design(stage, phase, quality);
+                m_latency += static_cast<float>(getGroupDelay(taps) / (1 << stage));
+
+                auto &groups = m_stages.emplace_back();
+                groups.reserve(static_cast<size_t>(m_num_channels / stride));
+                for (int channel = 0; channel < m_num_channels; channel += stride)
+                {
+                    groups.emplace_back(taps, channel, stride);
+                }
+            }
+
+            m_input_pointers.resize(static_cast<size_t>(m_num_channels));
+            m_output_pointers.resize(static_cast<size_t>(m_num_channels));
+        }
+
+        void initProcessing(const size_t maximumNumberOfSamplesBeforeOversampling)
+        {
+            m_max_samples = static_cast<int>(maximumNumberOfSamplesBeforeOversampling);
+            m_buffers.resize(m_stages.size());
+
+            for (size_t stage = 0; stage < m_stages.size(); ++stage)
+            {
+                for (auto &group: m_stages[stage])
+                {
+                    group.prepare(m_max_samples << stage);
+                }
+
+                m_buffers[stage].setSize(m_num_channels, m_max_samples << (stage + 1), false, true);
+            }
+
+            m_discard.setSize(1, m_max_samples, false, true);
+        }
+
+        void reset()
+        {
+            for (auto &stage: m_stages)
+            {
+                for (auto &group: stage)
+                {
+                    group.reset();
+                }
+            }
+        }
+
+        // In Samples der Basisrate, Hoch- und Runterrechnen zusammen
+        float getLatencyInSamples() const { return m_latency; }
+
+        size_t getOversamplingFactor() const { return static_cast<size_t>(1) << m_factor; }
+
+        // Weniger Kanäle als angelegt gehen auch (z.B. Mono Host), die
+        // fehlenden rechnen mit Kanal 0 mit und werden verworfen
+        juce::dsp::AudioBlock<float> processSamplesUp(const juce::dsp::AudioBlock<const float> &inputBlock)
+        {
+            const auto num_samples = static_cast<int>(inputBlock.getNumSamples());
+            const auto num_channels = static_cast<int>(inputBlock.getNumChannels());
+            jassert(num_samples <= m_max_samples);
+            jassert(num_channels > 0 && num_channels <= m_num_channels);
+
+            for (int channel = 0; channel < m_num_channels; ++channel)
+            {
+                m_input_pointers[static_cast<size_t>(channel)] = inputBlock.getChannelPointer(
+                    static_cast<size_t>(juce::jmin(channel, num_channels - 1)));
+            }
+
+            const float *const *source = m_input_pointers.data();
+
+            for (size_t stage = 0; stage < m_stages.size(); ++stage)
+            {
+                auto *const *destination = m_buffers[stage].getArrayOfWritePointers();
+
+                for (auto &group: m_stages[stage])
+                {
+                    group.up(source, destination, num_samples << stage);
+                }
+
+                source = m_buffers[stage].getArrayOfReadPointers();
+            }
+
+            return juce::dsp::AudioBlock<float>(m_buffers.back().getArrayOfWritePointers(),
+                                                static_cast<size_t>(num_channels),
+                                                static_cast<size_t>(num_samples << m_factor));
+        }
+
+        // Liest den Block aus processSamplesUp() (in place bearbeitet)
+        void processSamplesDown(juce::dsp::AudioBlock<float> &outputBlock)
+        {
+            const auto num_samples = static_cast<int>(outputBlock.getNumSamples());
+            const auto num_channels = static_cast<int>(outputBlock.getNumChannels());
+            jassert(num_samples <= m_max_samples);
+            jassert(num_channels > 0 && num_channels <= m_num_channels);
+
+            for (int channel = 0; channel < m_num_channels; ++channel)
+            {
+                m_output_pointers[static_cast<size_t>(channel)] = channel < num_channels
+                                                                      ? outputBlock.getChannelPointer(static_cast<size_t>(channel))
+                                                                      : m_discard.getWritePointer(0);
+            }
+
+            for (int stage = m_factor - 1; stage >= 0; --stage)
+            {
+                const auto *const *source = m_buffers[static_cast<size_t>(stage)].getArrayOfReadPointers();
+                auto *const *destination = stage > 0
+                                               ? m_buffers[static_cast<size_t>(stage) - 1].getArrayOfWritePointers()
+                                               : m_output_pointers.data();
+
+                for (auto &group: m_stages[static_cast<size_t>(stage)])
+                {
+                    group.down(source, destination, num_samples << stage);
+                }
+            }
+        }
+
+    private:
+       #if JUCE_USE_SIMD
+        using Vector = juce::dsp::SIMDRegister<float>;
+        static constexpr int kLanes = static_cast<int>(Vector::SIMDNumElements);
+       #else
+        static constexpr int kLanes = 4;
+       #endif
+
+        // Ein Polyphasen-Zweig für stride verschränkte Kanäle. Entweder ein FIR
+        // oder, wenn nur ein Tap ungleich 0 ist, ein Delay mit Gain.
+        //
+        // Die Historie ist linear: vorne die letzten num_taps - 1 Samples vom
+        // letzten Block, dahinter der neue Block. Das Fenster für Sample i
+        // beginnt bei i * stride. Damit jede Ladung aligned ist, gibt es die
+        // (umgedrehten) Koeffizienten kLanes mal, jeweils um ein Element
+        // weiter nach hinten geschoben.
+        class Branch
+        {
+        public:
+            // taps[k] wirkt auf das Sample vor k Samples
+            Branch(const std::vector<double> &taps, const int stride)
+                : m_num_taps(juce::jmax(1, static_cast<int>(taps.size()))), m_stride(stride)
+            {
+                int non_zero = 0;
+                for (size_t k = 0; k < taps.size(); ++k)
+                {
+                    if (taps[k] != 0.0)
+                    {
+                        ++non_zero;
+                        m_delay = static_cast<int>(k);
+                        m_gain = static_cast<float>(taps[k]);
+                    }
+                }
+
+                m_is_delay = non_zero <= 1;
+                if (m_is_delay)
+                {
+                    m_num_taps = m_delay + 1;
+                    return;
+                }
+
+                m_padded_length = roundUp(kLanes - 1 + m_num_taps * m_stride);
+                m_coefficient_storage.assign(static_cast<size_t>(m_padded_length * kLanes + kLanes), 0.0f);
+                m_coefficients = align(m_coefficient_storage.data());
+
+                for (int offset = 0; offset < kLanes; ++offset)
+                {
+                    auto *copy = m_coefficients + offset * m_padded_length;
+                    for (int k = 0; k < m_num_taps; ++k)
+                    {
+                        for (int channel = 0; channel < m_stride; ++channel)
+                        {
+                            const auto index = offset + (m_num_taps - 1 - k) * m_stride + channel;
+                            if (index < m_padded_length)
+                                copy[index] = static_cast<float>(taps[static_cast<size_t>(k)]);
+                        }
+                    }
+                }
+            }
+
+            void prepare(const int max_samples)
+            {
+                // Hinten Platz für das Überlesen der letzten Ladung
+                const auto size = (m_num_taps - 1 + max_samples) * m_stride + m_padded_length + 2 * kLanes;
+                m_history_storage.assign(static_cast<size_t>(size), 0.0f);
+                m_history = align(m_history_storage.data());
+            }
+
+            void reset()
+            {
+                std::fill(m_history_storage.begin(), m_history_storage.end(), 0.0f);
+            }
+
+            // Schreibposition für Sample i des Blocks, stride Kanäle hintereinander
+            float *getInput(const int sample) const
+            {
+                return m_history + (m_num_taps - 1 + sample) * m_stride;
+            }
+
+            // Ergebnis für Sample i, out hat stride Werte
+            void compute(const int sample, float *out) const
+            {
+                const auto start = sample * m_stride;
+
+                if (m_is_delay)
+                {
+                    for (int channel = 0; channel < m_stride; ++channel)
+                        out[channel] = m_gain * m_history[start + channel];
+
+                    return;
+                }
+
+                const auto offset = start % kLanes;
+                const float *x = m_history + (start - offset);
+                const float *c = m_coefficients + offset * m_padded_length;
+
+               #if JUCE_USE_SIMD
+                auto sum = Vector::expand(0.0f);
+                for (int i = 0; i < m_padded_length; i += kLanes)
+                {
+                    sum += Vector::fromRawArray(x + i) * Vector::fromRawArray(c + i);
+                }
+
+                if (m_stride == 1)
+                {
+                    out[0] = sum.sum();
+                    return;
+                }
+
+                // Lanes abwechselnd L R, offset ist bei stride 2 immer gerade
+                for (int channel = 0; channel < m_stride; ++channel)
+                {
+                    out[channel] = 0.0f;
+                    for (int lane = channel; lane < kLanes; lane += m_stride)
+                        out[channel] += sum.get(static_cast<size_t>(lane));
+                }
+               #else
+                for (int channel = 0; channel < m_stride; ++channel)
+                    out[channel] = 0.0f;
+
+                for (int i = 0; i < m_padded_length; ++i)
+                    out[i % m_stride] += x[i] * c[i];
+               #endif
+            }
+
+            // Nach dem Block: die letzten num_taps - 1 Samples nach vorne
+            void finish(const int num_samples)
+            {
+                if (m_num_taps > 1)
+                {
+                    std::memmove(m_history, m_history + num_samples * m_stride,
+                                 sizeof(float) * static_cast<size_t>((m_num_taps - 1) * m_stride));
+                }
+            }
+
+        private:
+            static int roundUp(const int size) { return (size + kLanes - 1) / kLanes * kLanes; }
+
+            static float *align(float *pointer)
+            {
+               #if JUCE_USE_SIMD
+                return Vector::getNextSIMDAlignedPtr(pointer);
+               #else
+                return pointer;
+               #endif
+            }
+
+            int m_num_taps;
+            const int m_stride;
+            bool m_is_delay{false};
+            int m_delay{0};
+            float m_gain{1.0f};
+
+            int m_padded_length{0};
+            std::vector<float> m_coefficient_storage;
+            float *m_coefficients{nullptr};
+
+            std::vector<float> m_history_storage;
+            float *m_history{nullptr};
+        };
+
+        // Eine 2X-Stufe für eine Kanalgruppe (ein Kanal oder Stereo verschränkt).
+        //
+        // Hoch: y[2n] = 2 * sum h[2k] x[n-k], y[2n+1] = 2 * sum h[2k+1] x[n-k]
+        // Runter: y[n] = sum h[2k] v[2n-2k] + sum h[2k+1] v[2n-1-2k]
+        class Group
+        {
+        public:
+            Group(const std::vector<double> &taps, const int first_channel, const int stride)
+                : m_first_channel(first_channel), m_stride(stride),
+                  m_up_even(getPhase(taps, 0, 2.0, false), stride),
+                  m_up_odd(getPhase(taps, 1, 2.0, false), stride),
+                  m_down_even(getPhase(taps, 0, 1.0, false), stride),
+                  m_down_odd(getPhase(taps, 1, 1.0, true), stride)
+            {
+            }
+
+            void prepare(const int max_input_samples)
+            {
+                m_up_even.prepare(max_input_samples);
+                m_up_odd.prepare(max_input_samples);
+                m_down_even.prepare(max_input_samples);
+                m_down_odd.prepare(max_input_samples);
+            }
+
+            void reset()
+            {
+                m_up_even.reset();
+                m_up_odd.reset();
+                m_down_even.reset();
+                m_down_odd.reset();
+            }
+
+            // num_samples Eingang, 2 * num_samples Ausgang
+            void up(const float *const *input, float *const *output, const int num_samples)
+            {
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    auto *even = m_up_even.getInput(sample);
+                    auto *odd = m_up_odd.getInput(sample);
+
+                    for (int channel = 0; channel < m_stride; ++channel)
+                    {
+                        even[channel] = odd[channel] = input[m_first_channel + channel][sample];
+                    }
+                }
+
+                std::array<float, 2> even{}, odd{};
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    m_up_even.compute(sample, even.data());
+                    m_up_odd.compute(sample, odd.data());
+
+                    for (int channel = 0; channel < m_stride; ++channel)
+                    {
+                        output[m_first_channel + channel][2 * sample] = even[static_cast<size_t>(channel)];
+                        output[m_first_channel + channel][2 * sample + 1] = odd[static_cast<size_t>(channel)];
+                    }
+                }
+
+                m_up_even.finish(num_samples);
+                m_up_odd.finish(num_samples);
+            }
+
+            // 2 * num_samples Eingang, num_samples Ausgang
+            void down(const float *const *input, float *const *output, const int num_samples)
+            {
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    auto *even = m_down_even.getInput(sample);
+                    auto *odd = m_down_odd.getInput(sample);
+
+                    for (int channel = 0; channel < m_stride; ++channel)
+                    {
+                        even[channel] = input[m_first_channel + channel][2 * sample];
+                        odd[channel] = input[m_first_channel + channel][2 * sample + 1];
+                    }
+                }
+
+                std::array<float, 2> even{}, odd{};
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    m_down_even.compute(sample, even.data());
+                    m_down_odd.compute(sample, odd.data());
+
+                    for (int channel = 0; channel < m_stride; ++channel)
+                    {
+                        output[m_first_channel + channel][sample] = even[static_cast<size_t>(channel)]
+                                                                    + odd[static_cast<size_t>(channel)];
+                    }
+                }
+
+                m_down_even.finish(num_samples);
+                m_down_odd.finish(num_samples);
+            }
+
+        private:
+            // Jeder zweite Tap ab phase, delayed: ein Sample später (ungerader
+            // Zweig beim Runterrechnen liest v[2n-1-2k])
+            static std::vector<double> getPhase(const std::vector<double> &taps, const size_t phase, const double gain,
+                                                const bool delayed)
+            {
+                std::vector<double> result(delayed ? 1 : 0, 0.0);
+                for (size_t k = phase; k < taps.size(); k += 2)
+                {
+                    result.push_back(taps[k] * gain);
+                }
+
+                return result;
+            }
+
+            const int m_first_channel;
+            const int m_stride;
+            Branch m_up_even, m_up_odd, m_down_even, m_down_odd;
+        };
+
+        //==============================================================================
+        // Filterentwurf, alles in double
+
+        struct Specification
+        {
+            double attenuation_db;
+            double pass_edge;   // Anteil der Basisrate, bis dahin bleibt das Signal unangetastet
+        };
+
+        static Specification getSpecification(const Quality quality)
+        {
+            switch (quality)
+            {
+                case Quality::kLow: return {70.0, 0.40};
+                case Quality::kMedium: return {90.0, 0.43};
+                case Quality::kHigh: break;
+            }
+
+            return {110.0, 0.45};
+        }
+
+        // Halbband mit Kaiser-Fenster, Länge 4m - 1: Mitte 0.5, jeder zweite
+        // Tap neben der Mitte exakt 0. Stufe s braucht nur bis pass_edge / 2^s
+        // der eigenen Eingangsrate sauber zu sein.
+        static std::vector<double> design(const int stage, const Phase phase, const Quality quality)
+        {
+            const auto specification = getSpecification(quality);
+            const auto attenuation = specification.attenuation_db;
+            const double transition = 0.5 - specification.pass_edge / (1 << stage);
+
+            // Kaiser: Länge ≈ (A - 8) / (2.285 * 2pi * Übergangsbreite)
+            const double estimated = (attenuation - 8.0) / (2.285 * juce::MathConstants<double>::twoPi * transition);
+            const int m = juce::jmax(2, static_cast<int>(std::ceil((estimated + 1.0) / 4.0)));
+            const int length = 4 * m - 1;
+            const int centre = 2 * m - 1;
+            const double beta = 0.1102 * (attenuation - 8.7);
+
+            std::vector<double> taps(static_cast<size_t>(length), 0.0);
+            double side_sum = 0.0;
+
+            for (int n = 0; n < length; ++n)
+            {
+                const int offset = n - centre;
+                if (offset == 0 || offset % 2 == 0)
+                    continue;
+
+                const double position = 2.0 * n / (length - 1) - 1.0;
+                const double window = besselI0(beta * std::sqrt(juce::jmax(0.0, 1.0 - position * position)))
+                                      / besselI0(beta);
+                const double x = juce::MathConstants<double>::pi * offset;
+
+                taps[static_cast<size_t>(n)] = std::sin(0.5 * x) / x * window;
+                side_sum += taps[static_cast<size_t>(n)];
+            }
+
+            // Gain bei DC genau 1, ohne die Nullen anzufassen
+            for (int n = 0; n < length; ++n)
+            {
+                if (n != centre)
+                    taps[static_cast<size_t>(n)] *= 0.5 / side_sum;
+            }
+
+            taps[static_cast<size_t>(centre)] = 0.5;
+
+            if (phase == Phase::kMinimum)
+            {
+                taps = toMinimumPhase(taps, attenuation);
+            }
+
+            return taps;
+        }
+
+        // Homomorph über das reelle Cepstrum: log|H| → Cepstrum kausal falten
+        // → exp → minimalphasige Antwort mit (fast) gleichem Betrag. Die
+        // Nullstellen im Sperrbereich werden unter der Sperrdämpfung gekappt.
+        static std::vector<double> toMinimumPhase(const std::vector<double> &taps, const double attenuation_db)
+        {
+            size_t size = 4096;
+            while (size < 32 * taps.size())
+                size *= 2;
+
+            std::vector<std::complex<double> > spectrum(size);
+            for (size_t n = 0; n < taps.size(); ++n)
+                spectrum[n] = taps[n];
+
+            fft(spectrum, false);
+
+            const double floor = std::pow(10.0, -(attenuation_db + 20.0) / 20.0);
+            for (auto &bin: spectrum)
+                bin = std::log(juce::jmax(floor, std::abs(bin)));
+
+            fft(spectrum, true);
+
+            for (size_t n = 1; n < size / 2; ++n)
+                spectrum[n] = 2.0 * spectrum[n].real();
+
+            spectrum[0] = spectrum[0].real();
+            spectrum[size / 2] = spectrum[size / 2].real();
+            for (size_t n = size / 2 + 1; n < size; ++n)
+                spectrum[n] = 0.0;
+
+            fft(spectrum, false);
+
+            for (auto &bin: spectrum)
+                bin = std::exp(bin);
+
+            fft(spectrum, true);
+
+            std::vector<double> result(taps.size());
+            double sum = 0.0;
+            for (size_t n = 0; n < result.size(); ++n)
+            {
+                result[n] = spectrum[n].real();
+                sum += result[n];
+            }
+
+            for (auto &tap: result)
+                tap /= sum;
+
+            return result;
+        }
+
+        // Radix 2, inverse inklusive 1/N
+        static void fft(std::vector<std::complex<double> > &data, const bool inverse)
+        {
+            const auto size = data.size();
+
+            for (size_t i = 1, j = 0; i < size; ++i)
+            {
+                size_t bit = size >> 1;
+                for (; j & bit; bit >>= 1)
+                    j ^= bit;
+
+                j ^= bit;
+                if (i < j)
+                    std::swap(data[i], data[j]);
+            }
+
+            for (size_t length = 2; length <= size; length <<= 1)
+            {
+                const double angle = (inverse ? 1.0 : -1.0) * juce::MathConstants<double>::twoPi / static_cast<double>(length);
+                const std::complex<double> step(std::cos(angle), std::sin(angle));
+
+                for (size_t start = 0; start < size; start += length)
+                {
+                    std::complex<double> w(1.0, 0.0);
+                    for (size_t k = 0; k < length / 2; ++k)
+                    {
+                        const auto a = data[start + k];
+                        const auto b = data[start + k + length / 2] * w;
+                        data[start + k] = a + b;
+                        data[start + k + length / 2] = a - b;
+                        w *= step;
+                    }
+                }
+            }
+
+            if (inverse)
+            {
+                for (auto &value: data)
+                    value /= static_cast<double>(size);
+            }
+        }
+
+        static double besselI0(const double x)
+        {
+            double sum = 1.0;
+            double term = 1.0;
+            for (int k = 1; k < 50; ++k)
+            {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+                if (term < 1.0e-12 * sum)
+                    break;
+            }
+
+            return sum;
+        }
+
+        // Gruppenlaufzeit bei DC in Samples der hohen Rate
+        static double getGroupDelay(const std::vector<double> &taps)
+        {
+            double moment = 0.0;
+            double sum = 0.0;
+            for (size_t n = 0; n < taps.size(); ++n)
+            {
+                moment += static_cast<double>(n) * taps[n];
+                sum += taps[n];
+            }
+
+            return moment / sum;
+        }
+
+        const int m_num_channels;
+        const int m_factor;
+        int m_max_samples{0};
+        float m_latency{0.0f};
+
+        // [Stufe][Kanalgruppe], Stufe 0 ist Basisrate → 2X
+        std::vector<std::vector<Group> > m_stages;
+        std::vector<juce::AudioBuffer<float> > m_buffers;   // Ausgang jeder Stufe beim Hochrechnen
+        juce::AudioBuffer<float> m_discard;                 // Ziel für Kanäle, die der Block nicht hat
+
+        std::vector<const float *> m_input_pointers;
+        std::vector<float *> m_output_pointers;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Oversampler)
+    };
+}
@@ -11,33 +11,33 @@
 #pragma once
 
 #include "juce_dsp/juce_dsp.h"
+#include <vector>
+#include "ADAA.h"
+#include "BaseDspModule.h"
+#include "BlockSmoother.h"
+#include "../Math/FastMath.h"
 
 namespace viator::dsp
 {
+    // Auf der BaseDspModule-Basis: Blockaufteilung, In/Out/Mix und der
+    // aligned Scratch (für den SIMD-Shaper) kommen von dort
     template<typename SampleType>
-    class Tube
+    class Tube : public BaseDspModule<Tube<SampleType>, float>
     {
     public:
         Tube() = default;
 
-        void prepare(juce::dsp::ProcessSpec &spec)
+        void prepareModule(const juce::dsp::ProcessSpec &spec)
         {
-            for (auto &drive: m_drive_smoothers)
-            {
-                drive.reset(spec.sampleRate, 0.02);
-                drive.setCurrentAndTargetValue(1.0f);
-            }
-
-            for (auto &drive: m_drive_comp_smoothers)
-            {
-                drive.reset(spec.sampleRate, 0.02);
-                drive.setCurrentAndTargetValue(1.0f);
-            }
+            const auto max_block_size = juce::jmax(1, static_cast<int>(spec.maximumBlockSize));
 
-            for (auto &drive: m_mix_smoothers)
+            for (auto *smoothers: { &m_drive_smoothers, &m_drive_comp_smoothers })
             {
-                drive.reset(spec.sampleRate, 0.02);
-                drive.setCurrentAndTargetValue(1.0f);
+                for (auto &smoother: *smoothers)
+                {
+                    smoother.prepare(spec.sampleRate, 0.02, max_block_size);
+                    smoother.setCurrentAndTargetValue(1.0f);
+                }
             }
 
             for (auto &filter: m_dc_filters)
@@ -53,30 +53,57 @@ namespace viator::dsp
                 filter.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
                 filter.setCutoffFrequency(10000.0f);
             }
+
+            for (auto &aa: m_anti_aliasing)
+            {
+                aa.reset(getTubeShape());
+            }
         }
 
-        void processBlock(juce::dsp::AudioBlock<float> &block, const int num_samples)
+        // Kernel für BaseDspModule: Drive, Shaper (SIMD bzw. ADAA), dann die
+        // Filter und der Drive-Ausgleich. Geformt wird im aligned Scratch.
+        void processChannel(ChannelContext<float> &context)
         {
-            for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            auto *data = context.samples.data();
+            const auto channel = context.channel;
+            const auto num_samples = static_cast<int>(context.samples.size());
+            auto *shaped = this->getScratch(0);
+
+            const auto drive = m_drive_smoothers[channel].getRamp(num_samples);
+            if (drive.isConstant())
+                juce::FloatVectorOperations::multiply(shaped, data, drive.value, num_samples);
+            else
+                juce::FloatVectorOperations::multiply(shaped, data, drive.values, num_samples);
+
+            if (m_aa_order == adaa::Order::kOff)
+            {
+                m_anti_aliasing[channel].bypass();
+                processShaperBlock(shaped, num_samples);
+            }
+            else
             {
-                auto *data = block.getChannelPointer(channel);
-                for (size_t sample = 0; sample < num_samples; ++sample)
+                for (int sample = 0; sample < num_samples; ++sample)
                 {
-                    float xn = data[sample];
-                    const float drive = m_drive_smoothers[channel].getNextValue();
-                    const float drive_comp = m_drive_comp_smoothers[channel].getNextValue();
-                    float yn = xn * drive;
-                    yn = processConduction(yn, 1.5f);
-                    yn = processTube(yn, 1.0f, 1.5f, 1.0f, 4.0f, -1.5f);
-                    yn = m_dc_filters[channel].processSample(static_cast<int>(channel), yn);
-                    yn = m_miller_cap_filter[channel].processSample(static_cast<int>(channel), yn);
-                    yn *= 0.35f * drive_comp;
-                    data[sample] = yn;
+                    shaped[sample] = m_anti_aliasing[channel].process(getTubeShape(), shaped[sample], m_aa_order);
                 }
             }
+
+            // Die Filter sind rekursiv, die bleiben pro Sample
+            auto &dc_filter = m_dc_filters[channel];
+            auto &miller_filter = m_miller_cap_filter[channel];
+
+            m_drive_comp_smoothers[channel].getRamp(num_samples).visit([&](auto gain)
+            {
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    float yn = dc_filter.processSample(static_cast<int>(channel), shaped[sample]);
+                    yn = miller_filter.processSample(static_cast<int>(channel), yn);
+                    data[sample] = yn * 0.35f * gain(sample);
+                }
+            });
         }
 
-        inline float processConduction(const float xn, const float thresh)
+        static inline float processConduction(const float xn, const float thresh)
         {
             const auto mask = static_cast<float>(xn >= 0.0f);
 
@@ -87,7 +114,7 @@ namespace viator::dsp
             return (1.0f - mask) * xn + compressionFactor * xn * mask;
         }
 
-        inline float processTube(float xn, const float k, const float thresh, const float offset, const float
+        static inline float processTube(float xn, const float k, const float thresh, const float offset, const float
         clip_pos, const float clip_neg)
         {
             xn += offset;
@@ -134,6 +161,34 @@ namespace viator::dsp
             return yn - offset;
         }
 
+       #if JUCE_USE_SIMD
+        // Conduction + Tube wie oben, aber für alle Lanes ohne Verzweigung:
+        // jeder Zweig wird gerechnet und per Maske ausgewählt. Konstanten
+        // (thresh 1.5, offset 1, clip +4 / -1.5, k = 1) sind eingesetzt,
+        // tanh(k) kürzt sich in kTanhScale.
+        //
+        // Ab xn ≈ 4.7 hängt der Ausgang ohnehin am oberen Clip, clip_delta
+        // darf also auf 8 begrenzt werden, exp läuft nur auf [-2.6, 0].
+        static math::FloatVector processShaper(const math::FloatVector xn)
+        {
+            using Vector = math::FloatVector;
+
+            const auto positive = Vector::greaterThanOrEqual(xn, Vector::expand(0.0f));
+            const auto clip_delta = math::clamp(xn - 1.5f, 0.0f, 8.0f);
+            const auto compression = math::expBounded(clip_delta * -0.3241584f) * 0.545f + 0.447f;
+            const auto conducted = xn * math::select(positive, compression, Vector::expand(1.0f));
+
+            const auto x = math::clamp(conducted + 1.0f, -1.5f, 4.0f);
+            const auto u = (x - 1.5f) * (1.0f / 2.5f);
+            const auto upper = u * (Vector::expand(3.75f) - u * u * 1.25f) + 1.5f;
+            const auto lower = math::tanhUnit(x * (1.0f / 1.5f)) * kTanhScale;
+
+            const auto yn = math::select(Vector::greaterThan(x, Vector::expand(1.5f)), upper,
+                                         math::select(Vector::greaterThan(x, Vector::expand(0.0f)), x, lower));
+            return yn - 1.0f;
+        }
+       #endif
+
         void setDrive(const float value)
         {
             for (auto &drive: m_drive_smoothers)
@@ -147,15 +202,55 @@ namespace viator::dsp
                 const auto comp_scaled = juce::jlimit(-15.0f, 0.0f, raw_comp);
                 drive.setTargetValue(juce::Decibels::decibelsToGain(comp_scaled));
             }
+        }
+
+        void setAntiAliasing(const adaa::Order order)
+        {
+            m_aa_order = order;
+        }
 
-            for (auto &drive: m_mix_smoothers)
+        // Conduction + Tube als eine Kennlinie, keine geschlossene Stammfunktion.
+        // Wird beim ersten Aufruf gebaut (prepare), danach nur gelesen.
+        static const adaa::TabulatedShape &getTubeShape()
+        {
+            static const adaa::TabulatedShape shape([](const double x)
+                                                    {
+                                                        const auto yn = processConduction(static_cast<float>(x), 1.5f);
+                                                        return static_cast<double>(processTube(yn, 1.0f, 1.5f, 1.0f, 4.0f, -1.5f));
+                                                    }, 16.0, 4096);
+            return shape;
+        }
+
+        // Conduction + Tube in place auf dem aligned Puffer, bis zur nächsten
+        // vollen Breite (der Rest hinten ist Scratch). Public für die Tests.
+        static void processShaperBlock(float *data, const int num_samples)
+        {
+           #if JUCE_USE_SIMD
+            for (int sample = 0; sample < num_samples; sample += kLanes)
             {
-                drive.setTargetValue(value * 0.01f);
+                processShaper(math::FloatVector::fromRawArray(data + sample)).copyToRawArray(data + sample);
             }
+           #else
+            for (int sample = 0; sample < num_samples; ++sample)
+            {
+                data[sample] = processTube(processConduction(data[sample], 1.5f), 1.0f, 1.5f, 1.0f, 4.0f, -1.5f);
+            }
+           #endif
         }
 
     private:
-        std::array<juce::SmoothedValue<float>, 2> m_drive_smoothers, m_drive_comp_smoothers, m_mix_smoothers;
+       #if JUCE_USE_SIMD
+        static constexpr int kLanes = static_cast<int>(math::FloatVector::SIMDNumElements);
+       #else
+        static constexpr int kLanes = 1;
+       #endif
+
+        static constexpr float kTanhScale = 1.969552928f;   // 1.5 / tanh(1)
+
+        std::array<BlockSmoother<float>, 2> m_drive_smoothers, m_drive_comp_smoothers;
+
+        adaa::Order m_aa_order = adaa::Order::kOff;
+        std::array<adaa::Processor, 2> m_anti_aliasing;
         std::array<juce::dsp::LinkwitzRileyFilter<float>, 2> m_dc_filters, m_miller_cap_filter;
     };
 }
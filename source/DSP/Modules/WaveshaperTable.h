@@ -0,0 +1,317 @@
+//
+// Created by Landon Viator on 11/21/25.
+//
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "BlockSmoother.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace viator::dsp
+{
+    // Ein Hintergrund-Thread für alle Tabellen im Prozess. Die Tabellen
+    // melden sich an (nicht im Audio Thread) und werden bei jedem Wecken
+    // gefragt, ob sie etwas zu bauen haben.
+    class WaveshaperTableBuilder : private juce::Thread
+    {
+    public:
+        struct Client
+        {
+            virtual ~Client() = default;
+
+            // Builder Thread
+            virtual void buildRequested() = 0;
+        };
+
+        WaveshaperTableBuilder() : juce::Thread("Mix2Go Waveshaper Tables")
+        {
+            startThread(juce::Thread::Priority::low);
+        }
+
+        ~WaveshaperTableBuilder() override
+        {
+            signalThreadShouldExit();
+            m_wake.signal();
+            stopThread(1000);
+        }
+
+        void add(Client *client)
+        {
+            const juce::ScopedLock lock(m_lock);
+            m_clients.addIfNotAlreadyThere(client);
+        }
+
+        // Wartet, falls der Client gerade baut
+        void remove(Client *client)
+        {
+            const juce::ScopedLock lock(m_lock);
+            m_clients.removeFirstMatchingValue(client);
+        }
+
+        // Audio Thread
+        void wake() { m_wake.signal(); }
+
+    private:
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                m_wake.wait(100);
+
+                const juce::ScopedLock lock(m_lock);
+                for (auto *client: m_clients)
+                {
+                    client->buildRequested();
+                }
+            }
+        }
+
+        juce::CriticalSection m_lock;
+        juce::Array<Client *> m_clients;
+        juce::WaitableEvent m_wake;
+    };
+
+    // Tabelle für eine gedächtnislose Kennlinie y = curve(x, drive).
+    //
+    // Für den Drive, auf den der Smoother zuläuft, wird im Hintergrund eine
+    // Tabelle gebaut (size Punkte auf [-range, range], Catmull-Rom Hermite
+    // dazwischen). Im Audio Thread ist es dann Lookup + Interpolation statt
+    // der Kennlinie.
+    //
+    //   - Steht der Drive auf dem Wert einer Tabelle: nur diese Tabelle.
+    //   - Läuft der Smoother zwischen zwei fertigen, nahen Tabellen: beide
+    //     lesen und nach der Position des Drives zwischen ihnen überblenden.
+    //   - Sonst (noch keine Tabelle, schnelle Automation, x außerhalb des
+    //     Bereichs): curve direkt.
+    //
+    // Drei feste Slots (aktuell, nächste, im Bau), alles in der Konstruktion
+    // angelegt. Der Audio Thread alloziert und löscht nie, der Builder
+    // schreibt nur in den angefragten Slot.
+    //
+    // Für den Clipper Soft Clip (atan) etwa 3x schneller als std::atan pro
+    // Sample (~6 gegen 15-22 ns, WaveshaperTable Benchmark in tests/). Der
+    // Fehler wächst mit dem Drive, bei 30 dB -80 dB, bei 12 dB -106 dB.
+    template<typename Curve>
+    class WaveshaperTable : private WaveshaperTableBuilder::Client
+    {
+    public:
+        explicit WaveshaperTable(Curve curve = {}, const float range = 8.0f, const int size = 4096)
+            : m_curve(curve), m_range(range), m_size(juce::jmax(4, size)),
+              m_step(2.0f * range / static_cast<float>(m_size - 1)), m_inverse_step(1.0f / m_step)
+        {
+            for (auto &table: m_tables)
+            {
+                // Ein Punkt Rand auf jeder Seite für Catmull-Rom
+                table.values.assign(static_cast<size_t>(m_size + 2), 0.0f);
+            }
+
+            m_builder->add(this);
+        }
+
+        ~WaveshaperTable() override
+        {
+            m_builder->remove(this);
+        }
+
+        // Audio Thread, in place. drive: Rampe bzw. Konstante für den Block
+        // (vom BlockSmoother), target: Ziel des Smoothers.
+        void process(float *data, const ParameterRamp<float> &drive, const int num_samples, const float target)
+        {
+            if (num_samples <= 0)
+                return;
+
+            adoptBuiltTable();
+
+            const auto first = drive[0];
+            const auto last = drive[num_samples - 1];
+
+            // Am Ziel angekommen: die nächste Tabelle wird die aktuelle
+            if (m_next >= 0 && first == last && matches(m_next, last))
+            {
+                m_current = m_next;
+                m_next = -1;
+            }
+
+            requestTable(target);
+
+            if (m_current >= 0 && first == last && matches(m_current, first))
+            {
+                processTable(data, drive, num_samples);
+            }
+            else if (m_current >= 0 && m_next >= 0 && isBetween(first) && isBetween(last))
+            {
+                processCrossfade(data, drive, num_samples);
+            }
+            else
+            {
+                drive.visit([&](auto at)
+                {
+                    for (int sample = 0; sample < num_samples; ++sample)
+                    {
+                        data[sample] = m_curve(data[sample], at(sample));
+                    }
+                });
+            }
+        }
+
+        const Curve &getCurve() const { return m_curve; }
+
+    private:
+        struct Table
+        {
+            std::vector<float> values;
+            float drive{0.0f};
+        };
+
+        enum RequestState
+        {
+            kIdle,
+            kRequested,
+            kReady
+        };
+
+        bool matches(const int slot, const float drive) const
+        {
+            return std::abs(m_tables[static_cast<size_t>(slot)].drive - drive) <= 1.0e-6f * juce::jmax(1.0f, std::abs(drive));
+        }
+
+        bool isBetween(const float drive) const
+        {
+            const auto a = m_tables[static_cast<size_t>(m_current)].drive;
+            const auto b = m_tables[static_cast<size_t>(m_next)].drive;
+            const auto low = juce::jmin(a, b);
+            const auto high = juce::jmax(a, b);
+
+            // Überblenden ist linear im Drive, die Kennlinie nicht. Bei großen
+            // Sprüngen wäre der Fehler in der Mitte hörbar, dann lieber direkt.
+            return drive >= low && drive <= high && a != b && high <= low * kMaxCrossfadeRatio;
+        }
+
+        void adoptBuiltTable()
+        {
+            if (m_request_state.load(std::memory_order_acquire) != kReady)
+                return;
+
+            // Ist der Drive inzwischen woanders hin, bleibt der Slot einfach frei
+            const auto slot = m_request_slot.load(std::memory_order_relaxed);
+            if (m_current < 0)
+                m_current = slot;
+            else
+                m_next = slot;
+
+            m_request_state.store(kIdle, std::memory_order_release);
+        }
+
+        void requestTable(const float target)
+        {
+            if (m_request_state.load(std::memory_order_acquire) != kIdle)
+                return;
+
+            if ((m_current >= 0 && matches(m_current, target)) || (m_next >= 0 && matches(m_next, target)))
+                return;
+
+            // Neues Ziel, die alte nächste Tabelle passt nicht mehr
+            if (m_next >= 0 && m_current >= 0)
+                m_next = -1;
+
+            int slot = 0;
+            while (slot == m_current || slot == m_next)
+                ++slot;
+
+            m_request_slot.store(slot, std::memory_order_relaxed);
+            m_request_drive.store(target, std::memory_order_relaxed);
+            m_request_state.store(kRequested, std::memory_order_release);
+            m_builder->wake();
+        }
+
+        void buildRequested() override
+        {
+            if (m_request_state.load(std::memory_order_acquire) != kRequested)
+                return;
+
+            auto &table = m_tables[static_cast<size_t>(m_request_slot.load(std::memory_order_relaxed))];
+            table.drive = m_request_drive.load(std::memory_order_relaxed);
+
+            for (int i = 0; i < m_size + 2; ++i)
+            {
+                const auto x = -m_range + static_cast<float>(i - 1) * m_step;
+                table.values[static_cast<size_t>(i)] = m_curve(x, table.drive);
+            }
+
+            m_request_state.store(kReady, std::memory_order_release);
+        }
+
+        // Catmull-Rom zwischen values[i + 1] und values[i + 2]
+        float lookup(const Table &table, const float x) const
+        {
+            const auto position = (x + m_range) * m_inverse_step;
+            const auto index = juce::jmin(static_cast<int>(position), m_size - 2);
+            const auto t = position - static_cast<float>(index);
+            const auto *v = table.values.data() + index;
+
+            return v[1] + 0.5f * t * (v[2] - v[0]
+                                      + t * (2.0f * v[0] - 5.0f * v[1] + 4.0f * v[2] - v[3]
+                                             + t * (3.0f * (v[1] - v[2]) + v[3] - v[0])));
+        }
+
+        bool isInRange(const float x) const { return std::abs(x) < m_range; }
+
+        void processTable(float *data, const ParameterRamp<float> &drive, const int num_samples) const
+        {
+            const auto &table = m_tables[static_cast<size_t>(m_current)];
+
+            for (int sample = 0; sample < num_samples; ++sample)
+            {
+                const auto x = data[sample];
+                data[sample] = isInRange(x) ? lookup(table, x) : m_curve(x, drive[sample]);
+            }
+        }
+
+        void processCrossfade(float *data, const ParameterRamp<float> &drive, const int num_samples) const
+        {
+            const auto &from = m_tables[static_cast<size_t>(m_current)];
+            const auto &to = m_tables[static_cast<size_t>(m_next)];
+            const auto scale = 1.0f / (to.drive - from.drive);
+
+            for (int sample = 0; sample < num_samples; ++sample)
+            {
+                const auto x = data[sample];
+                if (!isInRange(x))
+                {
+                    data[sample] = m_curve(x, drive[sample]);
+                    continue;
+                }
+
+                const auto a = lookup(from, x);
+                const auto b = lookup(to, x);
+                data[sample] = a + (b - a) * ((drive[sample] - from.drive) * scale);
+            }
+        }
+
+        static constexpr float kMaxCrossfadeRatio = 1.25f;
+
+        const Curve m_curve;
+        const float m_range;
+        const int m_size;
+        const float m_step;
+        const float m_inverse_step;
+
+        std::array<Table, 3> m_tables;
+
+        // Nur Audio Thread, Slot-Index oder -1
+        int m_current{-1};
+        int m_next{-1};
+
+        std::atomic<int> m_request_state{kIdle};
+        std::atomic<int> m_request_slot{0};
+        std::atomic<float> m_request_drive{0.0f};
+
+        juce::SharedResourcePointer<WaveshaperTableBuilder> m_builder;
+
+        JUCE_DECLARE_NON_COPYABLE(WaveshaperTable)
+    };
+}
@@ -5,6 +5,7 @@
 #pragma once
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include <atomic>
 
 namespace viator::dsp::processors
 {
@@ -25,6 +26,57 @@ class BaseProcessor : public juce::AudioProcessor
 
     void setProcessorID(const int id) { m_processor_id = id; }
 
+    // Stage-Steuerung in der Chain, umgesetzt zentral im ChainExecutor.
+    // Bypass = Eingang unverändert durch, Mute = Stille, Mix = Dry/Wet.
+    // Setter von jedem Thread, die Rampen (20 ms) macht der Audio Thread.
+    struct StageState
+    {
+        std::atomic<bool> bypassed { false };
+        std::atomic<bool> muted { false };
+        std::atomic<float> mix { 1.0f };
+
+        // Nur Audio Thread (bzw. ChainExecutor::prepareStage)
+        juce::SmoothedValue<float> wet_gain { 1.0f };
+        juce::SmoothedValue<float> dry_gain { 0.0f };
+
+        // Dry um getLatencySamples() verzögert, Ring mit dry_latency Samples
+        juce::AudioBuffer<float> dry_delay;
+        int dry_latency { 0 };
+        int dry_delay_position { 0 };
+    };
+
+    void setBypassed(const bool should_bypass) { m_stage_state.bypassed = should_bypass; }
+    bool isBypassed() const { return m_stage_state.bypassed; }
+
+    void setMuted(const bool should_mute) { m_stage_state.muted = should_mute; }
+    bool isMuted() const { return m_stage_state.muted; }
+
+    void setMix(const float mix) { m_stage_state.mix = juce::jlimit(0.0f, 1.0f, mix); }
+    float getMix() const { return m_stage_state.mix; }
+
+    StageState& getStageState() { return m_stage_state; }
+
+    // Routing im Rack: parallel zum vorherigen Processor (gleicher Eingang,
+    // die Ausgänge werden vor dem nächsten seriellen Processor summiert).
+    // Nur Message Thread, wirkt beim nächsten publishChain().
+    void setParallelToPrevious(const bool is_parallel) { m_parallel_to_previous = is_parallel; }
+    bool isParallelToPrevious() const { return m_parallel_to_previous; }
+
+    // Chain-Oversampling: ist es an, rechnet der ChainExecutor einmal am
+    // Anfang einer Reihe solcher Processors hoch und am Ende wieder runter,
+    // dazwischen läuft processOversampled() statt processBlock().
+    // factor = Index in globals::Oversampling (1 = 2X .. 4 = 16X), buffer hat
+    // dann sampleRate * 2^factor. Vorbereitet werden alle Faktoren in prepareToPlay().
+    // processOversampled() hat keine eigene Latenz, getLatencySamples() gilt
+    // nur für processBlock(). Die Latenz der Reihe meldet der ChainExecutor.
+    virtual bool supportsChainOversampling() const { return false; }
+
+    virtual void processOversampled(juce::AudioBuffer<float>& buffer, const int factor)
+    {
+        juce::ignoreUnused(buffer, factor);
+        jassertfalse;
+    }
+
     void getStateInformation(juce::MemoryBlock &destData) override
     {
         juce::MemoryOutputStream stream(destData, false);
@@ -44,6 +96,9 @@ private:
 
     int m_processor_id { -1 };
 
+    StageState m_stage_state;
+    bool m_parallel_to_previous { false };
+
     //==============================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BaseProcessor)
     };
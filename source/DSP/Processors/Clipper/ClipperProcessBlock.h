@@ -4,6 +4,10 @@
 
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include "../../Modules/ADAA.h"
+#include "../../Modules/BlockSmoother.h"
+#include "../../Modules/Oversampler.h"
+#include "../../Modules/WaveshaperTable.h"
 
 namespace ClipperParameters
 {
@@ -19,6 +23,9 @@ namespace ClipperParameters
     inline const juce::String clipTypeID = "clipTypeID";
     inline const juce::String clipTypeName = "Type";
 
+    inline const juce::String antiAliasingChoiceID = "antiAliasingChoiceID";
+    inline const juce::String antiAliasingChoiceName = "Anti-Aliasing";
+
     struct parameters {
         explicit parameters(const juce::AudioProcessorValueTreeState &state, int id)
         {
@@ -30,12 +37,15 @@ namespace ClipperParameters
                 clipTypeID + juce::String(id)));
             muteParam = dynamic_cast<juce::AudioParameterBool *>(state.getParameter(
                 muteID + juce::String(id)));
+            antiAliasingParam = dynamic_cast<juce::AudioParameterChoice *>(state.getParameter(
+                antiAliasingChoiceID + juce::String(id)));
         }
 
         juce::AudioParameterChoice *oversamplingParam{nullptr};
         juce::AudioParameterFloat *driveParam{nullptr};
         juce::AudioParameterChoice *typeParam{nullptr};
         juce::AudioParameterBool *muteParam{nullptr};
+        juce::AudioParameterChoice *antiAliasingParam{nullptr};
     };
 }
 
@@ -52,43 +62,116 @@ namespace viator::dsp
             kHardClip
         };
 
-        void prepare(const double sample_rate, const int samples_per_block, const int num_channels, int factor)
+        // Latenz vom Oversampler in Samples der Basisrate, ohne Ausgleich
+        static float getOversamplingLatency(const int factor)
+        {
+            static const auto latencies = []
+            {
+                std::array<float, 5> result{};
+                for (int i = 1; i < static_cast<int>(result.size()); ++i)
+                {
+                    result[i] = createOversampler(1, i)->getLatencyInSamples();
+                }
+                return result;
+            }();
+
+            return latencies[static_cast<size_t>(juce::jlimit(0, static_cast<int>(latencies.size()) - 1, factor))];
+        }
+
+        // Gemeinsame Latenz aller Faktoren (ganze Samples). Jeder Block wird auf
+        // sie verzögert, so passen verschiedene Faktoren beim Umschalten zusammen.
+        // +1, weil die Lagrange-Verzögerung mindestens ein Sample braucht.
+        static int getAlignedLatency()
+        {
+            float latency = 0.0f;
+            for (int factor = 1; factor <= 4; ++factor)
+            {
+                latency = juce::jmax(latency, getOversamplingLatency(factor));
+            }
+
+            return static_cast<int>(std::ceil(latency)) + 1;
+        }
+
+        // factor 0: kein eigener Oversampler (Off bzw. Chain-Oversampling).
+        // latency_samples: Gesamtlatenz in Samples von sample_rate, der Rest
+        // nach dem Oversampler wird mit einer Verzögerung aufgefüllt.
+        void prepare(const double sample_rate, const int samples_per_block, const int num_channels, int factor,
+                     const float latency_samples = 0.0f)
         {
             juce::dsp::ProcessSpec spec{};
             spec.sampleRate = sample_rate;
             spec.maximumBlockSize = samples_per_block;
             spec.numChannels = num_channels;
 
-            m_oversampler = std::make_unique<juce::dsp::Oversampling<float> >(spec.numChannels,
-                                                                              factor,
-                                                                              juce::dsp::Oversampling<
-                                                                                  float>::FilterType::filterHalfBandPolyphaseIIR,
-                                                                              true);
-            m_oversampler->initProcessing(spec.maximumBlockSize);
+            m_oversampler.reset();
+            if (factor > 0)
+            {
+                m_oversampler = createOversampler(num_channels, factor);
+                m_oversampler->initProcessing(spec.maximumBlockSize);
+            }
+
+            const auto own_latency = m_oversampler ? m_oversampler->getLatencyInSamples() : 0.0f;
+            const auto pad = juce::jmax(0.0f, latency_samples - own_latency);
+            m_latency_pad.setMaximumDelayInSamples(static_cast<int>(std::ceil(pad)) + 4);
+            m_latency_pad.prepare(spec);
+            m_latency_pad.setDelay(pad);
+            m_has_latency_pad = pad > 0.0f;
+
+            // clip() läuft mit der hohen Rate, also Rampen bis samples_per_block << factor
+            const auto max_ramp = juce::jmax(1, samples_per_block << factor);
 
             for (auto &drive: m_drive_smoothers)
             {
-                drive.reset(spec.sampleRate <= 0 ? 44100.0f : spec.sampleRate, 0.02);
+                drive.prepare(spec.sampleRate, 0.02, max_ramp);
             }
 
             for (auto &drive: m_drive_comp_smoothers)
             {
-                drive.reset(spec.sampleRate <= 0 ? 44100.0f : spec.sampleRate, 0.02);
+                drive.prepare(spec.sampleRate, 0.02, max_ramp);
+            }
+
+            for (auto &aa: m_anti_aliasing)
+            {
+                aa.reset(adaa::HardClip{});
             }
         }
 
         void process(juce::AudioBuffer<float> &buffer, const int num_samples)
         {
             juce::dsp::AudioBlock<float> block(buffer);
-            const auto up_sampled_block = m_oversampler->processSamplesUp(block);
-            switch (m_current_type)
+
+            if (m_oversampler == nullptr)
             {
-                case DistortionType::kSoftClip: softClip(up_sampled_block, buffer.getNumSamples());
-                    break;
-                case DistortionType::kHardClip: hardClip(up_sampled_block, buffer.getNumSamples());
-                    break;
+                processDirect(block);
+                return;
             }
+
+            const auto up_sampled_block = m_oversampler->processSamplesUp(block);
+            clip(up_sampled_block);
             m_oversampler->processSamplesDown(block);
+            padLatency(block);
+        }
+
+        // Ohne eigenes Oversampling, block hat schon die Rate aus prepare()
+        // (Off oder Chain-Oversampling im ChainExecutor)
+        void processDirect(const juce::dsp::AudioBlock<float> &block)
+        {
+            clip(block);
+            padLatency(block);
+        }
+
+        // Smoother direkt aufs Ziel, für einen frisch gebauten Block
+        void skipSmoothing()
+        {
+            for (auto &drive: m_drive_smoothers)
+            {
+                drive.setCurrentAndTargetValue(drive.getTargetValue());
+            }
+
+            for (auto &drive: m_drive_comp_smoothers)
+            {
+                drive.setCurrentAndTargetValue(drive.getTargetValue());
+            }
         }
 
         void updateParameters(ClipperParameters::parameters &parameters)
@@ -114,43 +197,159 @@ namespace viator::dsp
 
             const auto type = parameters.typeParam->getIndex();
             m_current_type = static_cast<DistortionType>(type);
+
+            if (parameters.antiAliasingParam)
+            {
+                m_aa_order = static_cast<adaa::Order>(parameters.antiAliasingParam->getIndex());
+            }
         }
 
     private:
-        std::unique_ptr<juce::dsp::Oversampling<float> > m_oversampler;
-        std::array<juce::SmoothedValue<float>, 2> m_drive_smoothers, m_drive_comp_smoothers;
+        // Linearphasig: die Latenz ist exakt, der Ausgleich passt also genau
+        static std::unique_ptr<Oversampler> createOversampler(const int num_channels, const int factor)
+        {
+            return std::make_unique<Oversampler>(static_cast<size_t>(num_channels), static_cast<size_t>(factor),
+                                                 Oversampler::Phase::kLinear, Oversampler::Quality::kHigh);
+        }
+
+        // In Stücken, die in die Rampen der Smoother passen
+        void clip(const juce::dsp::AudioBlock<float> &block)
+        {
+            const auto total = static_cast<int>(block.getNumSamples());
+            const auto max_samples = m_drive_smoothers[0].getMaxBlockSize();
+            jassert(max_samples > 0);   // prepare() vergessen?
+            if (max_samples <= 0)
+                return;
+
+            for (int offset = 0; offset < total; offset += max_samples)
+            {
+                const auto num_samples = juce::jmin(max_samples, total - offset);
+                const auto chunk = block.getSubBlock(static_cast<size_t>(offset), static_cast<size_t>(num_samples));
+
+                switch (m_current_type)
+                {
+                    case DistortionType::kSoftClip: softClip(chunk, num_samples);
+                        break;
+                    case DistortionType::kHardClip: hardClip(chunk, num_samples);
+                        break;
+                }
+            }
+        }
+
+        void padLatency(const juce::dsp::AudioBlock<float> &block)
+        {
+            if (!m_has_latency_pad)
+                return;
+
+            for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            {
+                auto *data = block.getChannelPointer(channel);
+                for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+                {
+                    m_latency_pad.pushSample(static_cast<int>(channel), data[sample]);
+                    data[sample] = m_latency_pad.popSample(static_cast<int>(channel));
+                }
+            }
+        }
+
+        std::unique_ptr<Oversampler> m_oversampler;
+        juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> m_latency_pad;
+        bool m_has_latency_pad{false};
+        std::array<BlockSmoother<float>, 2> m_drive_smoothers, m_drive_comp_smoothers;
         static constexpr float m_two_by_pi = 2.0f / juce::MathConstants<float>::pi;
         DistortionType m_current_type = DistortionType::kSoftClip;
         int m_should_compensate{true};
 
+        // ADAA statt (oder zusätzlich zu) Oversampling, pro Kanal eine Historie
+        adaa::Order m_aa_order = adaa::Order::kOff;
+        std::array<adaa::Processor, 2> m_anti_aliasing;
+
+        // 4 / pi * atan(drive * x), Drive-Ausgleich kommt danach
+        struct SoftClipCurve
+        {
+            float operator()(const float x, const float drive) const
+            {
+                return std::atan(x * drive) * (4.0f / juce::MathConstants<float>::pi);
+            }
+        };
+
+        WaveshaperTable<SoftClipCurve> m_soft_clip_table;
+
         void softClip(const juce::dsp::AudioBlock<float> &block, const int num_samples)
         {
+            if (m_aa_order == adaa::Order::kOff)
+            {
+                softClipTable(block, num_samples);
+                return;
+            }
+
             for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
             {
                 auto *data = block.getChannelPointer(channel);
-                for (size_t sample = 0; sample < num_samples; ++sample)
+                const auto drive = m_drive_smoothers[channel].getRamp(num_samples);
+                const auto drive_comp = m_drive_comp_smoothers[channel].getRamp(num_samples);
+                auto &anti_aliasing = m_anti_aliasing[channel];
+
+                for (int sample = 0; sample < num_samples; ++sample)
                 {
-                    const auto drive_comp = m_drive_comp_smoothers[channel].getNextValue();
-                    const float xn = data[sample] * m_drive_smoothers[channel].getNextValue();
-                    const float yn = m_two_by_pi * std::atan(xn) * 2.0f;
-                    data[sample] = yn * drive_comp;
+                    const float xn = data[sample] * drive[sample];
+                    const float yn = anti_aliasing.process(adaa::Atan{}, xn, m_aa_order);
+                    data[sample] = m_two_by_pi * yn * 2.0f * drive_comp[sample];
                 }
             }
         }
 
+        // Ohne ADAA: Kennlinie aus der Tabelle für den aktuellen Drive
+        void softClipTable(const juce::dsp::AudioBlock<float> &block, const int num_samples)
+        {
+            for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            {
+                auto *data = block.getChannelPointer(channel);
+                auto &drive = m_drive_smoothers[channel];
+                m_anti_aliasing[channel].bypass();
+
+                m_soft_clip_table.process(data, drive.getRamp(num_samples), num_samples, drive.getTargetValue());
+                applyGain(m_drive_comp_smoothers[channel], data, num_samples);
+            }
+        }
+
         void hardClip(const juce::dsp::AudioBlock<float> &block, const int num_samples)
         {
             for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
             {
                 auto *data = block.getChannelPointer(channel);
-                for (size_t sample = 0; sample < num_samples; ++sample)
+
+                if (m_aa_order == adaa::Order::kOff)
                 {
-                    const auto drive_comp = m_drive_comp_smoothers[channel].getNextValue();
-                    const float xn = data[sample] * m_drive_smoothers[channel].getNextValue();
-                    const float yn = std::clamp(xn, -1.0f, 1.0f);
-                    data[sample] = yn * drive_comp;
+                    // Ohne ADAA geht alles mit FloatVectorOperations
+                    m_anti_aliasing[channel].bypass();
+                    applyGain(m_drive_smoothers[channel], data, num_samples);
+                    juce::FloatVectorOperations::clip(data, data, -1.0f, 1.0f, num_samples);
+                    applyGain(m_drive_comp_smoothers[channel], data, num_samples);
+                    continue;
+                }
+
+                const auto drive = m_drive_smoothers[channel].getRamp(num_samples);
+                const auto drive_comp = m_drive_comp_smoothers[channel].getRamp(num_samples);
+                auto &anti_aliasing = m_anti_aliasing[channel];
+
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    const float xn = data[sample] * drive[sample];
+                    data[sample] = anti_aliasing.process(adaa::HardClip{}, xn, m_aa_order) * drive_comp[sample];
                 }
             }
         }
+
+        // data *= Rampe bzw. Konstante, bei 1 gar nichts
+        static void applyGain(BlockSmoother<float> &smoother, float *data, const int num_samples)
+        {
+            const auto gain = smoother.getRamp(num_samples);
+
+            if (!gain.isConstant())
+                juce::FloatVectorOperations::multiply(data, gain.values, num_samples);
+            else if (gain.value != 1.0f)
+                juce::FloatVectorOperations::multiply(data, gain.value, num_samples);
+        }
     };
 }
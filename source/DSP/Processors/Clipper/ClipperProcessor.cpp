@@ -16,10 +16,24 @@ namespace viator::dsp::processors
         getTreeState().addParameterListener(ClipperParameters::oversamplingChoiceID + juce::String(id), this);
         getTreeState().addParameterListener(ClipperParameters::driveID + juce::String(id), this);
         getTreeState().addParameterListener(ClipperParameters::clipTypeID + juce::String(id), this);
+
+        // Jeder Faktor wird auf die gleiche Latenz verzögert, sie ändert sich also nie.
+        // Gilt nur für processBlock(), processOversampled() hat keine eigene Latenz.
+        setLatencySamples(viator::dsp::ClipperProcessBlock::getAlignedLatency());
     }
 
     ClipperProcessor::~ClipperProcessor()
     {
+        cancelPendingUpdate();
+
+        // Ein laufender Job schreibt noch nach m_pending
+        while (m_jobs_in_flight.load() > 0)
+        {
+            juce::Thread::sleep(1);
+        }
+
+        delete m_pending.exchange(nullptr);
+        delete m_retired.exchange(nullptr);
     }
 
     juce::AudioProcessorValueTreeState::ParameterLayout ClipperProcessor::createParameterLayout(const int id)
@@ -50,11 +64,113 @@ namespace viator::dsp::processors
             ClipperParameters::muteName + juce::String(id),
             false));
 
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID{ClipperParameters::antiAliasingChoiceID + juce::String(id), 1},
+            ClipperParameters::antiAliasingChoiceName + juce::String(id),
+            viator::dsp::adaa::items, 0));
+
         return {params.begin(), params.end()};
     }
 
     void ClipperProcessor::parameterChanged(const juce::String &parameterID, float newValue)
     {
+        juce::ignoreUnused(newValue);
+
+        // Kann aus dem Audio Thread kommen, gebaut wird im Worker
+        if (parameterID.startsWith(ClipperParameters::oversamplingChoiceID))
+        {
+            triggerAsyncUpdate();
+        }
+    }
+
+    int ClipperProcessor::getOversamplingChoice() const
+    {
+        return juce::jlimit(0, static_cast<int>(viator::globals::Oversampling::items.size()) - 1,
+                            m_parameters->oversamplingParam->getIndex());
+    }
+
+    void ClipperProcessor::handleAsyncUpdate()
+    {
+        if (auto *retired = m_retired.exchange(nullptr))
+        {
+            m_worker->pool.addJob([retired] { delete retired; });
+        }
+
+        // Erst wenn die laufende Umschaltung durch ist, meldet sich der Audio Thread wieder
+        if (m_switching.load())
+            return;
+
+        const auto factor = getOversamplingChoice();
+        if (factor == m_active_factor.load())
+            return;
+
+        m_switching = true;
+        ++m_jobs_in_flight;
+
+        const auto generation = m_generation.load();
+        const auto sample_rate = m_sample_rate;
+        const auto block_size = m_block_size;
+        const auto num_channels = getTotalNumInputChannels();
+
+        m_worker->pool.addJob([this, factor, generation, sample_rate, block_size, num_channels]
+        {
+            const auto start_ticks = juce::Time::getHighResolutionTicks();
+
+            auto slot = std::make_unique<OversamplingSlot>();
+            slot->factor = factor;
+            slot->generation = generation;
+            slot->block.prepare(sample_rate, block_size, num_channels, factor,
+                                static_cast<float>(viator::dsp::ClipperProcessBlock::getAlignedLatency()));
+            slot->block.updateParameters(*m_parameters);
+            slot->block.skipSmoothing();
+
+            DBG("[Clipper] " << viator::globals::Oversampling::items[factor] << " ready after "
+                << juce::String(juce::Time::highResolutionTicksToSeconds(
+                       juce::Time::getHighResolutionTicks() - start_ticks) * 1000.0, 2) << " ms");
+            juce::ignoreUnused(start_ticks);
+
+            m_pending.store(slot.release());
+            --m_jobs_in_flight;
+        });
+    }
+
+    void ClipperProcessor::adoptPendingSlot()
+    {
+        // Erst fertig überblenden, und der letzte alte Block muss abgeholt sein
+        if (m_fading_out != nullptr)
+            return;
+
+        if (m_retired.load() != nullptr)
+        {
+            triggerAsyncUpdate();
+            return;
+        }
+
+        std::unique_ptr<OversamplingSlot> slot(m_pending.exchange(nullptr));
+        if (slot == nullptr)
+            return;
+
+        // Gebaut vor einem erneuten prepareToPlay(): passt nicht mehr
+        if (slot->generation != m_generation.load() || m_active == nullptr)
+        {
+            retire(std::move(slot));
+            m_switching = false;
+            triggerAsyncUpdate();
+            return;
+        }
+
+        m_fading_out = std::move(m_active);
+        m_active = std::move(slot);
+        m_active_factor = m_active->factor;
+        m_fade_position = -m_warmup_samples;
+    }
+
+    void ClipperProcessor::retire(std::unique_ptr<OversamplingSlot> slot)
+    {
+        // Pro Umschaltung wird höchstens ein Block frei, der Message Thread
+        // hat den vorherigen schon abgeholt, bevor er die nächste gestartet hat
+        jassert(m_retired.load() == nullptr);
+        m_retired.store(slot.release());
     }
 
     //==============================================================================
@@ -122,13 +238,9 @@ namespace viator::dsp::processors
         juce::ignoreUnused(index, newName);
     }
 
-    void ClipperProcessor::updateParameters()
+    void ClipperProcessor::updateParameters(viator::dsp::ClipperProcessBlock &process_block)
     {
-        const auto oversampling_choice = m_parameters->oversamplingParam->getIndex();
-        if (oversampling_choice >= 0 && static_cast<size_t>(oversampling_choice) < m_process_blocks.size())
-        {
-            m_process_blocks[static_cast<size_t>(oversampling_choice)].updateParameters(*m_parameters);
-        }
+        process_block.updateParameters(*m_parameters);
 
         const auto should_mute = m_parameters->muteParam->get();
 
@@ -145,17 +257,56 @@ namespace viator::dsp::processors
         // initialisation that you need..
         juce::ignoreUnused(sampleRate, samplesPerBlock);
 
-        for (auto& mute : m_mutes)
+        m_sample_rate = sampleRate <= 0.0 ? 44100.0 : sampleRate;
+        m_block_size = samplesPerBlock;
+        m_fade_samples = juce::jmax(1, juce::roundToInt(m_sample_rate * kCrossfadeSeconds));
+        m_warmup_samples = juce::roundToInt(m_sample_rate * kWarmupSeconds);
+
+        const auto aligned_latency = viator::dsp::ClipperProcessBlock::getAlignedLatency();
+
+        // Nur der aktuelle Faktor, weitere baut der Worker bei Bedarf.
+        // Ein noch laufender Job gehört zur alten Generation und wird verworfen.
+        ++m_generation;
+        m_fading_out.reset();
+
+        const auto factor = getOversamplingChoice();
+        m_active = std::make_unique<OversamplingSlot>();
+        m_active->factor = factor;
+        m_active->generation = m_generation.load();
+        m_active->block.prepare(sampleRate, samplesPerBlock, getTotalNumInputChannels(), factor,
+                                static_cast<float>(aligned_latency));
+        m_active_factor = factor;
+
+        if (m_jobs_in_flight.load() == 0 && m_pending.load() == nullptr)
         {
-            mute.reset(sampleRate, 0.02);
+            m_switching = false;
         }
 
-        for (int i = 0; i < m_process_blocks.size(); ++i)
+        // Chain-Oversampling: ohne eigenen Oversampler und ohne Latenzausgleich,
+        // die Latenz der Reihe zählt der ChainExecutor einmal für alle
+        for (int i = 0; i < m_chain_blocks.size(); ++i)
         {
-            m_process_blocks[i].prepare(sampleRate, samplesPerBlock, getTotalNumInputChannels(), i);
+            m_chain_blocks[i].prepare(sampleRate * (1 << i), samplesPerBlock << i, getTotalNumInputChannels(), 0);
         }
 
-        m_dry_buffer.setSize(getTotalNumOutputChannels(), sampleRate);
+        const auto max_chain_samples = samplesPerBlock << (static_cast<int>(m_chain_blocks.size()) - 1);
+        m_dry_buffer.setSize(getTotalNumOutputChannels(), juce::jmax(static_cast<int>(sampleRate), max_chain_samples));
+
+        // Dry für Mute bekommt die gleiche Latenz wie der eigene Oversampler
+        m_dry_delay.setMaximumDelayInSamples(aligned_latency);
+        m_dry_delay.prepare({m_sample_rate, static_cast<juce::uint32>(juce::jmax(1, samplesPerBlock)),
+                             static_cast<juce::uint32>(juce::jmax(1, getTotalNumOutputChannels()))});
+        m_dry_delay.setDelay(static_cast<float>(aligned_latency));
+
+        // Die Mute-Rampen werden so lang wie der Dry-Puffer
+        for (auto& mute : m_mutes)
+        {
+            mute.prepare(sampleRate, 0.02, m_dry_buffer.getNumSamples());
+        }
+        m_fade_buffer.setSize(getTotalNumOutputChannels(), juce::jmax(static_cast<int>(sampleRate), samplesPerBlock));
+
+        // Parameter kann sich vor dem Prepare geändert haben
+        triggerAsyncUpdate();
     }
 
     void ClipperProcessor::releaseResources()
@@ -193,34 +344,117 @@ namespace viator::dsp::processors
     {
         juce::ignoreUnused(midiMessages);
 
-        updateParameters();
+        adoptPendingSlot();
 
-        m_dry_buffer.clear();
-        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        if (m_active == nullptr)
+            return;
+
+        const auto num_samples = buffer.getNumSamples();
+
+        // Wet kommt um getAlignedLatency() verzögert raus, Dry muss mit,
+        // sonst kammfiltert die Mute-Rampe und gemutet stimmt die Latenz nicht
+        const auto num_dry_channels = juce::jmin(buffer.getNumChannels(), m_dry_buffer.getNumChannels());
+        for (int channel = 0; channel < num_dry_channels; ++channel)
         {
-            m_dry_buffer.copyFrom(channel, 0, buffer, channel, 0, buffer.getNumSamples());
+            const auto *input = buffer.getReadPointer(channel);
+            auto *dry_data = m_dry_buffer.getWritePointer(channel);
+
+            for (int sample = 0; sample < num_samples; ++sample)
+            {
+                m_dry_delay.pushSample(channel, input[sample]);
+                dry_data[sample] = m_dry_delay.popSample(channel);
+            }
         }
 
-        const auto oversampling_choice = m_parameters->oversamplingParam->getIndex();
-        if (oversampling_choice >= 0 && static_cast<size_t>(oversampling_choice) < m_process_blocks.size())
+        if (m_fading_out != nullptr)
         {
-            m_process_blocks[static_cast<size_t>(oversampling_choice)].process(buffer, buffer.getNumSamples());
+            // Alter Faktor auf einer Kopie, beide haben die gleiche Latenz
+            juce::AudioBuffer<float> old_buffer(m_fade_buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                                num_samples);
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                old_buffer.copyFrom(channel, 0, buffer, channel, 0, num_samples);
+            }
+
+            updateParameters(m_fading_out->block);
+            m_fading_out->block.process(old_buffer, num_samples);
         }
 
+        updateParameters(m_active->block);
+        m_active->block.process(buffer, num_samples);
 
-        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        if (m_fading_out != nullptr)
         {
-            auto* data = buffer.getWritePointer(channel);
-            const auto* dry_data = m_dry_buffer.getWritePointer(channel);
+            // Erst kurz warmlaufen (Filter und Smoother vom neuen Block), dann linear überblenden
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                auto *data = buffer.getWritePointer(channel);
+                const auto *old_data = m_fade_buffer.getReadPointer(channel);
+
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    const auto position = static_cast<float>(m_fade_position + sample);
+                    const auto gain = juce::jlimit(0.0f, 1.0f, position / static_cast<float>(m_fade_samples));
+                    data[sample] = old_data[sample] + (data[sample] - old_data[sample]) * gain;
+                }
+            }
 
-            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            m_fade_position += num_samples;
+
+            if (m_fade_position >= m_fade_samples)
             {
-                const auto dry_sample = dry_data[sample];
-                const auto wet_sample = data[sample];
-                const auto mix = m_mutes[channel].getNextValue();
-                data[sample] = (1.0f - mix) * dry_sample + wet_sample * mix;
+                retire(std::move(m_fading_out));
+                m_switching = false;
+                triggerAsyncUpdate();
             }
         }
+
+        applyMutes(buffer, num_samples);
+    }
+
+    void ClipperProcessor::processOversampled(juce::AudioBuffer<float> &buffer, const int factor)
+    {
+        // Die Chain rechnet schon hoch, das eigene Oversampling bleibt aus
+        auto &process_block = m_chain_blocks[static_cast<size_t>(juce::jlimit(0, static_cast<int>(m_chain_blocks.size()) - 1,
+                                                                              factor))];
+        updateParameters(process_block);
+
+        // Ohne eigene Latenz, Dry passt direkt
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            m_dry_buffer.copyFrom(channel, 0, buffer, channel, 0, buffer.getNumSamples());
+        }
+
+        process_block.processDirect(juce::dsp::AudioBlock<float>(buffer));
+
+        // Mute-Rampe in Samples der Basisrate, sonst wäre sie 2^factor mal zu schnell
+        applyMutes(buffer, juce::jmax(1, buffer.getNumSamples() >> factor));
+    }
+
+    void ClipperProcessor::applyMutes(juce::AudioBuffer<float> &buffer, const int ramp_samples)
+    {
+        const auto num_channels = juce::jmin(buffer.getNumChannels(), static_cast<int>(m_mutes.size()));
+
+        for (int channel = 0; channel < num_channels; ++channel)
+        {
+            const auto num_samples = buffer.getNumSamples();
+            const auto mix = m_mutes[channel].getRamp(num_samples, ramp_samples);
+
+            // Nicht gemutet und eingeschwungen: nichts zu tun
+            if (mix.isConstant() && mix.value == 1.0f)
+                continue;
+
+            // dry + (wet - dry) * mix
+            auto* data = buffer.getWritePointer(channel);
+            const auto* dry_data = m_dry_buffer.getReadPointer(channel);
+
+            juce::FloatVectorOperations::subtract(data, dry_data, num_samples);
+            if (mix.isConstant())
+                juce::FloatVectorOperations::multiply(data, mix.value, num_samples);
+            else
+                juce::FloatVectorOperations::multiply(data, mix.values, num_samples);
+            juce::FloatVectorOperations::add(data, dry_data, num_samples);
+        }
     }
 
     //==============================================================================
@@ -5,13 +5,15 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <atomic>
 #include "../BaseProcessor.h"
 #include "ClipperProcessBlock.h"
 
 namespace viator::dsp::processors
 {
     class ClipperProcessor
-            : public viator::dsp::processors::BaseProcessor, public juce::AudioProcessorValueTreeState::Listener {
+            : public viator::dsp::processors::BaseProcessor, public juce::AudioProcessorValueTreeState::Listener,
+              private juce::AsyncUpdater {
     public:
         //==============================================================================
         explicit ClipperProcessor(int id);
@@ -27,6 +29,10 @@ namespace viator::dsp::processors
 
         void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override;
 
+        bool supportsChainOversampling() const override { return true; }
+
+        void processOversampled(juce::AudioBuffer<float> &buffer, int factor) override;
+
         //==============================================================================
         juce::AudioProcessorEditor *createEditor() override;
 
@@ -67,13 +73,73 @@ namespace viator::dsp::processors
 
         std::unique_ptr<ClipperParameters::parameters> m_parameters;
 
-        void updateParameters();
+        void updateParameters(viator::dsp::ClipperProcessBlock &process_block);
+
+        void applyMutes(juce::AudioBuffer<float> &buffer, int ramp_samples);
+
+        // Oversampling: nur der aktive Faktor ist angelegt. Ein neuer Faktor
+        // wird im Hintergrund gebaut und vorbereitet (Worker), der Audio Thread
+        // blendet auf ihn über und gibt den alten zum Löschen zurück.
+        //
+        //   Message Thread → handleAsyncUpdate()   Job starten, alte Blöcke löschen lassen
+        //   Worker         → Job                   Block bauen, nach m_pending
+        //   Audio Thread   → processBlock()        m_pending übernehmen, überblenden,
+        //                                          alten Block nach m_retired
+        //
+        // Es läuft immer höchstens eine Umschaltung (m_switching).
+        struct OversamplingSlot
+        {
+            viator::dsp::ClipperProcessBlock block;
+            int factor{0};
+            int generation{0};
+        };
+
+        // Ein Hintergrund-Thread für alle Clipper-Instanzen
+        struct Worker
+        {
+            juce::ThreadPool pool{1};
+        };
+
+        void handleAsyncUpdate() override;
+
+        void adoptPendingSlot();
+
+        void retire(std::unique_ptr<OversamplingSlot> slot);
 
-        std::array<viator::dsp::ClipperProcessBlock, 5> m_process_blocks;
+        int getOversamplingChoice() const;
 
-        std::array<juce::SmoothedValue<float>, 2> m_mutes;
+        juce::SharedResourcePointer<Worker> m_worker;
+
+        // Nur Audio Thread (und prepareToPlay)
+        std::unique_ptr<OversamplingSlot> m_active, m_fading_out;
+        int m_fade_position{0};
+        int m_fade_samples{1};
+        int m_warmup_samples{0};
+        juce::AudioBuffer<float> m_fade_buffer;
+
+        std::atomic<OversamplingSlot *> m_pending{nullptr};
+        std::atomic<OversamplingSlot *> m_retired{nullptr};
+        std::atomic<bool> m_switching{false};
+        std::atomic<int> m_active_factor{0};
+        std::atomic<int> m_generation{0};
+        std::atomic<int> m_jobs_in_flight{0};
+
+        // Spec für neue Blöcke, gesetzt in prepareToPlay()
+        double m_sample_rate{44100.0};
+        int m_block_size{512};
+
+        static constexpr double kCrossfadeSeconds = 0.02;
+        static constexpr double kWarmupSeconds = 0.005;
+
+        // Chain-Oversampling: ohne eigenen Oversampler, Index = Faktor (Rate * 2^Index)
+        std::array<viator::dsp::ClipperProcessBlock, 5> m_chain_blocks;
+
+        std::array<BlockSmoother<float>, 2> m_mutes;
         juce::AudioBuffer<float> m_dry_buffer;
 
+        // Dry in processBlock() um getAlignedLatency() verzögert
+        juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> m_dry_delay;
+
         //==============================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ClipperProcessor)
     };
@@ -0,0 +1,237 @@
+#include "ConsoleProcessor.h"
+#include "../../../GUI/Editors/ConsoleEditor.h"
+
+namespace viator::dsp::processors
+{
+    //==============================================================================
+    ConsoleProcessor::ConsoleProcessor(int id)
+        : BaseProcessor(BusesProperties()
+            .withInput("Input", juce::AudioChannelSet::stereo(), true)
+            .withOutput("Output", juce::AudioChannelSet::stereo(), true))
+    {
+        BaseProcessor::setProcessorID(id);
+        auto layout = createParameterLayout(id);
+        initTreeState(this, std::move(layout));
+        m_parameters = std::make_unique<ConsoleParameters::parameters>(getTreeState(), id);
+        getTreeState().addParameterListener(ConsoleParameters::muteID + juce::String(id), this);
+    }
+
+    ConsoleProcessor::~ConsoleProcessor()
+    {
+        getTreeState().removeParameterListener(ConsoleParameters::muteID + juce::String(getProcessorID()), this);
+    }
+
+    juce::AudioProcessorValueTreeState::ParameterLayout ConsoleProcessor::createParameterLayout(const int id)
+    {
+        std::vector<std::unique_ptr<juce::RangedAudioParameter> > params;
+
+        params.push_back(std::make_unique<juce::AudioParameterBool>(
+            juce::ParameterID{ConsoleParameters::muteID + juce::String(id), 1},
+            ConsoleParameters::muteName + juce::String(id),
+            false));
+
+        // Tube::setDrive(): 0.3 dB pro Schritt rein, Ausgleich bis -15 dB
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID{ConsoleParameters::tubeDriveID + juce::String(id), 1},
+            ConsoleParameters::tubeDriveName + juce::String(id),
+            0.0f,
+            100.0f,
+            0.0f));
+
+        // k der Sinus-Kennlinie xn + k / 2pi * sin(2pi xn), bis 1 monoton
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID{ConsoleParameters::consoleDriveID + juce::String(id), 1},
+            ConsoleParameters::consoleDriveName + juce::String(id),
+            0.0f,
+            1.0f,
+            0.0f));
+
+        // Drive in dB, bei 0 dB ist der Bus noch trocken, ganz nass ab ~10 dB (k = 3.1)
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID{ConsoleParameters::busDriveID + juce::String(id), 1},
+            ConsoleParameters::busDriveName + juce::String(id),
+            0.0f,
+            10.0f,
+            0.0f));
+
+        // ADAA für alle drei Stufen, wie beim Clipper
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID{ConsoleParameters::antiAliasingChoiceID + juce::String(id), 1},
+            ConsoleParameters::antiAliasingChoiceName + juce::String(id),
+            viator::dsp::adaa::items, 0));
+
+        return {params.begin(), params.end()};
+    }
+
+    void ConsoleProcessor::parameterChanged(const juce::String &parameterID, float newValue)
+    {
+        // Mute macht der ChainExecutor mit Rampe, das Flag ist atomic
+        if (parameterID.startsWith(ConsoleParameters::muteID))
+        {
+            setMuted(newValue > 0.5f);
+        }
+    }
+
+    //==============================================================================
+    const juce::String ConsoleProcessor::getName() const
+    {
+        return "Console";
+    }
+
+    bool ConsoleProcessor::acceptsMidi() const
+    {
+#if JucePlugin_WantsMidiInput
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool ConsoleProcessor::producesMidi() const
+    {
+#if JucePlugin_ProducesMidiOutput
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool ConsoleProcessor::isMidiEffect() const
+    {
+#if JucePlugin_IsMidiEffect
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    double ConsoleProcessor::getTailLengthSeconds() const
+    {
+        return 0.0;
+    }
+
+    int ConsoleProcessor::getNumPrograms()
+    {
+        return 1; // NB: some hosts don't cope very well if you tell them there are 0 programs,
+        // so this should be at least 1, even if you're not really implementing programs.
+    }
+
+    int ConsoleProcessor::getCurrentProgram()
+    {
+        return 0;
+    }
+
+    void ConsoleProcessor::setCurrentProgram(int index)
+    {
+        juce::ignoreUnused(index);
+    }
+
+    const juce::String ConsoleProcessor::getProgramName(int index)
+    {
+        juce::ignoreUnused(index);
+        return {};
+    }
+
+    void ConsoleProcessor::changeProgramName(int index, const juce::String &newName)
+    {
+        juce::ignoreUnused(index, newName);
+    }
+
+    void ConsoleProcessor::updateParameters(Stages &stages)
+    {
+        stages.tube.setDrive(m_parameters->tubeDriveParam->get());
+        stages.console.setDrive(m_parameters->consoleDriveParam->get());
+        stages.bus.setDrive(m_parameters->busDriveParam->get());
+
+        const auto order = static_cast<adaa::Order>(m_parameters->antiAliasingParam->getIndex());
+        stages.tube.setAntiAliasing(order);
+        stages.console.setAntiAliasing(order);
+        stages.bus.setAntiAliasing(order);
+    }
+
+    //==============================================================================
+    void ConsoleProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+    {
+        const auto sample_rate = sampleRate <= 0.0 ? 44100.0 : sampleRate;
+        const auto num_channels = static_cast<juce::uint32>(juce::jmax(1, getTotalNumOutputChannels()));
+
+        // Alle Faktoren vorbereiten, welcher läuft entscheidet die Chain
+        for (int i = 0; i < static_cast<int>(m_stages.size()); ++i)
+        {
+            juce::dsp::ProcessSpec spec{sample_rate * (1 << i),
+                                        static_cast<juce::uint32>(juce::jmax(1, samplesPerBlock << i)),
+                                        num_channels};
+
+            auto &stages = m_stages[static_cast<size_t>(i)];
+            stages.tube.prepare(spec);
+            stages.console.prepare(spec);
+            stages.bus.prepare(spec);
+        }
+
+        setMuted(m_parameters->muteParam->get());
+    }
+
+    void ConsoleProcessor::releaseResources()
+    {
+        // When playback stops, you can use this as an opportunity to free up any
+        // spare memory, etc.
+    }
+
+    bool ConsoleProcessor::isBusesLayoutSupported(const BusesLayout &layouts) const
+    {
+#if JucePlugin_IsMidiEffect
+        juce::ignoreUnused(layouts);
+        return true;
+#else
+        // This is the place where you check if the layout is supported.
+        // In this template code we only support mono or stereo.
+        // Some plugin hosts, such as certain GarageBand versions, will only
+        // load plugins that support stereo bus layouts.
+        if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+            && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+            return false;
+
+        // This checks if the input layout matches the output layout
+#if !JucePlugin_IsSynth
+        if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+            return false;
+#endif
+
+        return true;
+#endif
+    }
+
+    void ConsoleProcessor::processBlock(juce::AudioBuffer<float> &buffer,
+                                        juce::MidiBuffer &midiMessages)
+    {
+        juce::ignoreUnused(midiMessages);
+        process(buffer, 0);
+    }
+
+    void ConsoleProcessor::processOversampled(juce::AudioBuffer<float> &buffer, const int factor)
+    {
+        process(buffer, factor);
+    }
+
+    void ConsoleProcessor::process(juce::AudioBuffer<float> &buffer, const int factor)
+    {
+        auto &stages = m_stages[static_cast<size_t>(juce::jlimit(0, static_cast<int>(m_stages.size()) - 1, factor))];
+        updateParameters(stages);
+
+        juce::dsp::AudioBlock<float> block(buffer);
+        stages.tube.processBlock(block, buffer.getNumSamples());
+        stages.console.processBlock(block, buffer.getNumSamples());
+        stages.bus.processBlock(block, buffer.getNumSamples());
+    }
+
+    //==============================================================================
+    bool ConsoleProcessor::hasEditor() const
+    {
+        return true; // (change this to false if you choose to not supply an editor)
+    }
+
+    juce::AudioProcessorEditor *ConsoleProcessor::createEditor()
+    {
+        return new viator::gui::editors::ConsoleEditor(*this);
+    }
+}
@@ -0,0 +1,130 @@
+//
+// Created by Landon Viator on 11/24/25.
+//
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "../BaseProcessor.h"
+#include "../../Modules/Tube.h"
+#include "../../Units/ConsoleModule.h"
+#include "../../Units/MasterBus.h"
+
+namespace ConsoleParameters
+{
+    inline const juce::String muteID = "muteID";
+    inline const juce::String muteName = "Mute";
+
+    inline const juce::String tubeDriveID = "tubeDriveID";
+    inline const juce::String tubeDriveName = "Tube";
+
+    inline const juce::String consoleDriveID = "consoleDriveID";
+    inline const juce::String consoleDriveName = "Console";
+
+    inline const juce::String busDriveID = "busDriveID";
+    inline const juce::String busDriveName = "Bus";
+
+    inline const juce::String antiAliasingChoiceID = "antiAliasingChoiceID";
+    inline const juce::String antiAliasingChoiceName = "Anti-Aliasing";
+
+    struct parameters {
+        explicit parameters(const juce::AudioProcessorValueTreeState &state, int id)
+        {
+            muteParam = dynamic_cast<juce::AudioParameterBool *>(state.getParameter(
+                muteID + juce::String(id)));
+            tubeDriveParam = dynamic_cast<juce::AudioParameterFloat *>(state.getParameter(
+                tubeDriveID + juce::String(id)));
+            consoleDriveParam = dynamic_cast<juce::AudioParameterFloat *>(state.getParameter(
+                consoleDriveID + juce::String(id)));
+            busDriveParam = dynamic_cast<juce::AudioParameterFloat *>(state.getParameter(
+                busDriveID + juce::String(id)));
+            antiAliasingParam = dynamic_cast<juce::AudioParameterChoice *>(state.getParameter(
+                antiAliasingChoiceID + juce::String(id)));
+        }
+
+        juce::AudioParameterBool *muteParam{nullptr};
+        juce::AudioParameterFloat *tubeDriveParam{nullptr};
+        juce::AudioParameterFloat *consoleDriveParam{nullptr};
+        juce::AudioParameterFloat *busDriveParam{nullptr};
+        juce::AudioParameterChoice *antiAliasingParam{nullptr};
+    };
+}
+
+namespace viator::dsp::processors
+{
+    // Röhre -> Konsole -> Summe als eigener Processor im Rack. Kein eigenes Oversampling, dafür
+    // läuft er im Chain-Oversampling mit: pro Faktor ein eigener Satz Module,
+    // vorbereitet für die jeweilige Rate. Mute geht auf die Stage (ChainExecutor).
+    class ConsoleProcessor
+            : public viator::dsp::processors::BaseProcessor, public juce::AudioProcessorValueTreeState::Listener {
+    public:
+        //==============================================================================
+        explicit ConsoleProcessor(int id);
+
+        ~ConsoleProcessor() override;
+
+        //==============================================================================
+        void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+
+        void releaseResources() override;
+
+        bool isBusesLayoutSupported(const BusesLayout &layouts) const override;
+
+        void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override;
+
+        bool supportsChainOversampling() const override { return true; }
+
+        void processOversampled(juce::AudioBuffer<float> &buffer, int factor) override;
+
+        //==============================================================================
+        juce::AudioProcessorEditor *createEditor() override;
+
+        bool hasEditor() const override;
+
+        //==============================================================================
+        const juce::String getName() const override;
+
+        bool acceptsMidi() const override;
+
+        bool producesMidi() const override;
+
+        bool isMidiEffect() const override;
+
+        double getTailLengthSeconds() const override;
+
+        //==============================================================================
+        int getNumPrograms() override;
+
+        int getCurrentProgram() override;
+
+        void setCurrentProgram(int index) override;
+
+        const juce::String getProgramName(int index) override;
+
+        void changeProgramName(int index, const juce::String &newName) override;
+
+    private:
+        static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout(int id);
+
+        void parameterChanged(const juce::String &parameterID, float newValue) override;
+
+        std::unique_ptr<ConsoleParameters::parameters> m_parameters;
+
+        // Ein Satz Module pro Rate, Index = Faktor (Rate * 2^Index)
+        struct Stages
+        {
+            viator::dsp::Tube<float> tube;
+            viator::dsp::ConsoleModule<float> console;
+            viator::dsp::MasterBus<float> bus;
+        };
+
+        void updateParameters(Stages &stages);
+
+        void process(juce::AudioBuffer<float> &buffer, int factor);
+
+        std::array<Stages, 5> m_stages;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConsoleProcessor)
+    };
+}
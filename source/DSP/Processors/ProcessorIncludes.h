@@ -3,5 +3,6 @@
 //
 
 #include "Clipper/ClipperProcessor.h"
+#include "Console/ConsoleProcessor.h"
 #include "50AProcessor.h"
 #include "TestProcessor.h"
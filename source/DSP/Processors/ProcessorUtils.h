@@ -12,6 +12,7 @@ namespace viator::dsp::processors
     enum class ProcessorType
     {
         kClipper,
+        kConsole,
         k50A,
         kTest
     };
@@ -42,6 +43,20 @@ namespace viator::dsp::processors
                             return std::make_unique<viator::gui::editors::ClipperEditor>(type);
                         }
                 },
+                {
+                        ProcessorType::kConsole,
+                        "Console",
+                        "Test",
+                        [](int id)
+                        {
+                            return std::make_unique<viator::dsp::processors::ConsoleProcessor>(id);
+                        },
+                        [](juce::AudioProcessor& processor)
+                        {
+                            auto& typed = dynamic_cast<viator::dsp::processors::ConsoleProcessor&>(processor);
+                            return std::make_unique<viator::gui::editors::ConsoleEditor>(typed);
+                        }
+                },
                 {
                         ProcessorType::k50A,
                         "50A",
@@ -4,37 +4,83 @@
 
 #pragma once
 #include "juce_dsp/juce_dsp.h"
+#include "../Modules/ADAA.h"
+#include "../Modules/BaseDspModule.h"
+#include "../Math/FastMath.h"
 
 namespace viator::dsp
 {
     template <typename SampleType>
-    class ConsoleModule
+    class ConsoleModule : public BaseDspModule<ConsoleModule<SampleType>, SampleType>
     {
+        using Base = BaseDspModule<ConsoleModule<SampleType>, SampleType>;
+
     public:
         ConsoleModule() = default;
 
-        void prepare(juce::dsp::ProcessSpec& spec)
+        void prepareModule(const juce::dsp::ProcessSpec& spec)
         {
             for (auto& drive : m_drive_smoothers)
             {
-                drive.reset(spec.sampleRate, 0.02);
+                drive.prepare(spec.sampleRate, 0.02, static_cast<int>(spec.maximumBlockSize));
             }
         }
 
-        void processBlock(juce::dsp::AudioBlock<float>& block, const int num_samples)
+        // Kernel, Drive als Rampe für den ganzen Block
+        void processChannel(ChannelContext<SampleType>& context)
         {
-            for (size_t channel = 0; channel < block.getNumChannels(); ++channel) {
-                auto *data = block.getChannelPointer(channel);
-                for (size_t sample = 0; sample < num_samples; ++sample) {
-                    const float xn = data[sample];
-                    const float k = m_drive_smoothers[channel].getNextValue();
-                    const float yn = xn + k / two_pi * std::sin(xn * two_pi);
-                    data[sample] = yn;
+            auto* data = context.samples.data();
+            const auto num_samples = static_cast<int>(context.samples.size());
+            auto& anti_aliasing = m_anti_aliasing[context.channel];
+            const auto k = m_drive_smoothers[context.channel].getRamp(num_samples);
+
+            if (m_aa_order == adaa::Order::kOff)
+            {
+                anti_aliasing.bypass();
+
+                if constexpr (std::is_same_v<SampleType, float>)
+                {
+                    // xn + k / 2pi * sin(2pi xn), der Sinus als SIMD-Kernel
+                    // auf dem aligned Scratch, der Rest mit FloatVectorOperations
+                    auto* sine = this->getScratch(0);
+                    juce::FloatVectorOperations::copy(sine, data, num_samples);
+                    math::sinTwoPi(sine, num_samples);
+
+                    if (k.isConstant())
+                    {
+                        juce::FloatVectorOperations::addWithMultiply(data, sine, k.value / two_pi, num_samples);
+                    }
+                    else
+                    {
+                        juce::FloatVectorOperations::multiply(sine, k.values, num_samples);
+                        juce::FloatVectorOperations::addWithMultiply(data, sine, 1.0f / two_pi, num_samples);
+                    }
+                }
+                else
+                {
+                    k.visit([&](auto drive)
+                    {
+                        for (int sample = 0; sample < num_samples; ++sample)
+                        {
+                            const SampleType xn = data[sample];
+                            data[sample] = xn + drive(sample) / two_pi * std::sin(xn * two_pi);
+                        }
+                    });
                 }
+
+                return;
             }
+
+            k.visit([&](auto drive)
+            {
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    data[sample] = anti_aliasing.process(adaa::SineFold { drive(sample) }, data[sample], m_aa_order);
+                }
+            });
         }
 
-        void setDrive(const float value)
+        void setDrive(const SampleType value)
         {
             for (auto& drive : m_drive_smoothers)
             {
@@ -42,10 +88,18 @@ namespace viator::dsp
             }
         }
 
+        void setAntiAliasing(const adaa::Order order)
+        {
+            m_aa_order = order;
+        }
+
     private:
 
-        static constexpr float two_pi = juce::MathConstants<float>::pi * 2.0f;
+        adaa::Order m_aa_order = adaa::Order::kOff;
+        std::array<adaa::Processor, 2> m_anti_aliasing;
+
+        static constexpr SampleType two_pi = juce::MathConstants<SampleType>::pi * 2;
 
-        std::array<juce::SmoothedValue<float>, 2> m_drive_smoothers;
+        std::array<BlockSmoother<SampleType>, 2> m_drive_smoothers;
     };
 }
@@ -5,6 +5,11 @@
 #pragma once
 
 #include "juce_dsp/juce_dsp.h"
+#include "../Modules/ADAA.h"
+#include "../Modules/BlockSmoother.h"
+#include <array>
+#include <optional>
+#include <vector>
 
 namespace viator::dsp
 {
@@ -16,33 +21,52 @@ namespace viator::dsp
 
         void prepare(juce::dsp::ProcessSpec &spec)
         {
+            const auto max_samples = static_cast<size_t>(juce::jmax(1, static_cast<int>(spec.maximumBlockSize)));
+
             for (auto &drive: m_drive_smoothers)
             {
-                drive.reset(spec.sampleRate, 0.02);
+                drive.prepare(spec.sampleRate, 0.02, static_cast<int>(max_samples));
             }
 
-            for (int i = 0; i < m_negative_dc_filters.size(); ++i)
-            {
-                m_positive_dc_filters[i].prepare(spec);
-                m_positive_dc_filters[i].setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-                m_positive_dc_filters[i].setCutoffFrequency(5.0f);
-                m_negative_dc_filters[i].prepare(spec);
-                m_negative_dc_filters[i].setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-                m_negative_dc_filters[i].setCutoffFrequency(5.0f);
-            }
+            m_dc_filter.prepare(spec.sampleRate <= 0.0 ? 44100.0 : spec.sampleRate, 5.0);
+
+            m_positive.assign(max_samples, 0.0f);
+            m_negative.assign(max_samples, 0.0f);
         }
 
         void processBlock(juce::dsp::AudioBlock<float> &block, const int num_samples)
         {
-            for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            const auto num_channels = juce::jmin(block.getNumChannels(), size_t{2});
+            if (num_channels == 0)
+                return;
+
+            auto *left = block.getChannelPointer(0);
+            // Mono: rechts läuft links mit, das Ergebnis wird nicht geschrieben
+            auto *right = num_channels > 1 ? block.getChannelPointer(1) : nullptr;
+            const auto max_samples = static_cast<int>(m_positive.size());
+
+            for (int offset = 0; offset < num_samples; offset += max_samples)
             {
-                auto *data = block.getChannelPointer(channel);
-                for (size_t sample = 0; sample < num_samples; ++sample)
+                const auto length = juce::jmin(max_samples, num_samples - offset);
+
+                if (m_aa_order == adaa::Order::kOff)
+                {
+                    for (auto &aa: m_anti_aliasing)
+                    {
+                        for (auto &stage: aa)
+                        {
+                            stage.bypass();
+                        }
+                    }
+
+                    processFused(left + offset, right != nullptr ? right + offset : nullptr, length);
+                }
+                else
                 {
-                    const float xn = data[sample];
-                    const float k = m_drive_smoothers[channel].getNextValue();
-                    const float yn = processPoletti(xn, k, channel);
-                    data[sample] = yn;
+                    for (size_t channel = 0; channel < num_channels; ++channel)
+                    {
+                        processPoletti(block.getChannelPointer(channel) + offset, length, static_cast<int>(channel));
+                    }
                 }
             }
         }
@@ -55,37 +79,217 @@ namespace viator::dsp
             }
         }
 
-        inline float processWaveshaper(const float xn, const float k, const float lp, const float ln)
+        // u / (1 + u / lp) = u * lp / (lp + u), negativ entsprechend. Der
+        // Nenner wird vor der Division gewählt: vorher liefen beide Seiten
+        // durch und wurden per Maske gemischt, nahe am Pol der anderen Seite
+        // hat das Präzision gekostet (bei u == ln sogar NaN). Ohne Verzweigung
+        // (wird zu Selects), damit der Fused-Kernel vektorisiert.
+        static inline float processWaveshaper(const float xn, const float k, const float lp, const float ln)
         {
             const float numerator = k * xn;
+            const bool positive = xn >= 0.0f;
 
-            const float x_positive = numerator / (1.0f + numerator / lp);
-            const float x_negative = numerator / (1.0f - numerator / ln);
+            const float scale = positive ? lp : ln;
+            const float denominator = positive ? lp + numerator : ln - numerator;
 
-            const auto mask = static_cast<float>(xn >= 0.0f);
+            return numerator * scale / denominator;
+        }
 
-            return x_negative + (x_positive - x_negative) * mask;
+        void setAntiAliasing(const adaa::Order order)
+        {
+            m_aa_order = order;
         }
 
-        inline float processPoletti(const float xn, const float k, const int channel)
+    private:
+        // Vier Lanes pro Sample: [L+, L-, R+, R-]. Die Schleifen über die
+        // Lanes haben feste Länge 4 und keine Abhängigkeiten untereinander,
+        // der Compiler macht daraus ein SSE/NEON Register. SIMDRegister geht
+        // hier nicht, der Waveshaper braucht eine Division.
+        static constexpr int kLanes = 4;
+        using Lanes = std::array<float, kLanes>;
+
+        // Linkwitz-Riley Hochpass 4. Ordnung als zwei TPT-SVFs, die gleiche
+        // Rekursion wie juce::dsp::LinkwitzRileyFilter, aber inline und mit
+        // einem Zustand pro Lane
+        struct DcFilter
         {
-            const float mix = juce::jmap(k, 1.0f, 3.1f, 0.0f, 1.0f);
-            float xn_positive = processWaveshaper(xn, k, 6.6f, 0.6f);
-            float xn_negative = processWaveshaper(xn, k, 0.6f, 6.6f);
+            float g{0.0f};
+            float h{1.0f};
+            alignas(16) Lanes s1{}, s2{}, s3{}, s4{};
 
-            xn_positive = m_positive_dc_filters[channel].processSample(channel, xn_positive);
-            xn_negative = m_negative_dc_filters[channel].processSample(channel, xn_negative);
+            static constexpr float r2 = juce::MathConstants<float>::sqrt2;
 
-            xn_positive = processWaveshaper(xn_positive, k, 1.6f, 1.6f);
-            xn_negative = processWaveshaper(xn_negative, k, 1.6f, 1.6f);
+            void prepare(const double sample_rate, const double cutoff)
+            {
+                g = static_cast<float>(std::tan(juce::MathConstants<double>::pi * cutoff / sample_rate));
+                h = 1.0f / (1.0f + r2 * g + g * g);
+                s1.fill(0.0f);
+                s2.fill(0.0f);
+                s3.fill(0.0f);
+                s4.fill(0.0f);
+            }
+
+            inline float processSample(const int lane, const float xn)
+            {
+                const auto i = static_cast<size_t>(lane);
 
-            const float yn = xn_positive + xn_negative;
-            return (1.0f - mix) * xn + yn * mix;
+                const auto yh = (xn - (r2 + g) * s1[i] - s2[i]) * h;
+                const auto yb = g * yh + s1[i];
+                s1[i] = g * yh + yb;
+                s2[i] = g * yb + (g * yb + s2[i]);
+
+                const auto yh2 = (yh - (r2 + g) * s3[i] - s4[i]) * h;
+                const auto yb2 = g * yh2 + s3[i];
+                s3[i] = g * yh2 + yb2;
+                s4[i] = g * yb2 + (g * yb2 + s4[i]);
+
+                return yh2;
+            }
+        };
+
+        static inline float getMix(const float k) { return juce::jmap(k, 1.0f, 3.1f, 0.0f, 1.0f); }
+
+        // Beide Kanäle und beide Polaritäten auf einmal, ohne ADAA. right darf
+        // nullptr sein (mono).
+        void processFused(float *left, float *right, const int num_samples)
+        {
+            const auto k_left = m_drive_smoothers[0].getRamp(num_samples);
+            const auto k_right = m_drive_smoothers[1].getRamp(num_samples);
+
+            // Der Mix hängt nur am Drive: läuft kein Smoother, einmal pro Block
+            if (k_left.isConstant() && k_right.isConstant())
+            {
+                processFusedKernel(m_dc_filter, left, right, num_samples,
+                                   [=](int) { return std::array<float, 2> { k_left.value, k_right.value }; },
+                                   std::array<float, 2> { getMix(k_left.value), getMix(k_right.value) });
+                return;
+            }
+
+            processFusedKernel(m_dc_filter, left, right, num_samples,
+                               [=](const int sample) { return std::array<float, 2> { k_left[sample], k_right[sample] }; },
+                               std::nullopt);
         }
 
-    private:
-        std::array<juce::SmoothedValue<float>, 2> m_drive_smoothers;
+        // getDrive(sample) -> {k links, k rechts}. Ist mix gesetzt, gilt er
+        // für den ganzen Block, sonst pro Sample aus k.
+        template <typename DriveSource>
+        static void processFusedKernel(DcFilter &filter, float *left, float *right, const int num_samples,
+                                       DriveSource &&getDrive, const std::optional<std::array<float, 2>> mix)
+        {
+            static constexpr Lanes first_lp { 6.6f, 0.6f, 6.6f, 0.6f };
+            static constexpr Lanes first_ln { 0.6f, 6.6f, 0.6f, 6.6f };
+            constexpr float second = 1.6f;
+
+            const auto r2_g = DcFilter::r2 + filter.g;
+            const auto g = filter.g;
+            const auto h = filter.h;
+
+            // Zustand in lokalen Registern, erst am Ende zurück
+            alignas(16) Lanes s1 = filter.s1, s2 = filter.s2, s3 = filter.s3, s4 = filter.s4;
+
+            for (int sample = 0; sample < num_samples; ++sample)
+            {
+                const auto xl = left[sample];
+                const auto xr = right != nullptr ? right[sample] : xl;
+                const auto drive = getDrive(sample);
+
+                alignas(16) const Lanes x { xl, xl, xr, xr };
+                alignas(16) const Lanes k { drive[0], drive[0], drive[1], drive[1] };
+                alignas(16) Lanes y;
+
+                for (size_t i = 0; i < kLanes; ++i)
+                {
+                    y[i] = processWaveshaper(x[i], k[i], first_lp[i], first_ln[i]);
+                }
+
+                for (size_t i = 0; i < kLanes; ++i)
+                {
+                    const auto yh = (y[i] - r2_g * s1[i] - s2[i]) * h;
+                    const auto yb = g * yh + s1[i];
+                    s1[i] = g * yh + yb;
+                    s2[i] = g * yb + (g * yb + s2[i]);
+
+                    const auto yh2 = (yh - r2_g * s3[i] - s4[i]) * h;
+                    const auto yb2 = g * yh2 + s3[i];
+                    s3[i] = g * yh2 + yb2;
+                    s4[i] = g * yb2 + (g * yb2 + s4[i]);
+
+                    y[i] = processWaveshaper(yh2, k[i], second, second);
+                }
+
+                const auto mix_left = mix ? (*mix)[0] : getMix(drive[0]);
+                const auto mix_right = mix ? (*mix)[1] : getMix(drive[1]);
+
+                left[sample] = (1.0f - mix_left) * xl + (y[0] + y[1]) * mix_left;
+                if (right != nullptr)
+                    right[sample] = (1.0f - mix_right) * xr + (y[2] + y[3]) * mix_right;
+            }
+
+            filter.s1 = s1;
+            filter.s2 = s2;
+            filter.s3 = s3;
+            filter.s4 = s4;
+        }
+
+        // Mit ADAA, ein Kanal stufenweise über den Block: beide Zweige formen,
+        // DC-Filter, nochmal formen, dann nach Drive mischen. Der Filterzustand
+        // ist derselbe wie im Fused-Pfad, Umschalten knackt also nicht.
+        void processPoletti(float *data, const int num_samples, const int channel)
+        {
+            auto &aa = m_anti_aliasing[static_cast<size_t>(channel)];
+            const auto k = m_drive_smoothers[static_cast<size_t>(channel)].getRamp(num_samples);
+            auto *positive = m_positive.data();
+            auto *negative = m_negative.data();
+
+            std::copy(data, data + num_samples, positive);
+            std::copy(data, data + num_samples, negative);
+
+            shape(aa[0], positive, k, num_samples, 6.6f, 0.6f);
+            shape(aa[1], negative, k, num_samples, 0.6f, 6.6f);
+
+            const auto positive_lane = 2 * channel;
+            const auto negative_lane = 2 * channel + 1;
+
+            for (int sample = 0; sample < num_samples; ++sample)
+            {
+                positive[sample] = m_dc_filter.processSample(positive_lane, positive[sample]);
+                negative[sample] = m_dc_filter.processSample(negative_lane, negative[sample]);
+            }
+
+            shape(aa[2], positive, k, num_samples, 1.6f, 1.6f);
+            shape(aa[3], negative, k, num_samples, 1.6f, 1.6f);
+
+            k.visit([&](auto drive)
+            {
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    const float mix = getMix(drive(sample));
+                    const float yn = positive[sample] + negative[sample];
+                    data[sample] = (1.0f - mix) * data[sample] + yn * mix;
+                }
+            });
+        }
+
+        // Eine Waveshaper-Stufe über den Block, jede der vier Stufen hat ihre
+        // eigene ADAA-Historie
+        void shape(adaa::Processor &aa, float *data, const ParameterRamp<float> &k, const int num_samples,
+                   const float lp, const float ln)
+        {
+            k.visit([&](auto drive)
+            {
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    data[sample] = aa.process(adaa::Poletti { drive(sample), lp, ln }, data[sample], m_aa_order);
+                }
+            });
+        }
+
+        std::array<BlockSmoother<float>, 2> m_drive_smoothers;
+        std::vector<float> m_positive, m_negative;
+
+        adaa::Order m_aa_order = adaa::Order::kOff;
+        std::array<std::array<adaa::Processor, 4>, 2> m_anti_aliasing;
 
-        std::array<juce::dsp::LinkwitzRileyFilter<float>, 2> m_positive_dc_filters, m_negative_dc_filters;
+        DcFilter m_dc_filter;
     };
 }
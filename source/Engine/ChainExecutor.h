@@ -0,0 +1,578 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <vector>
+#include "../DSP/Modules/Oversampler.h"
+#include "../DSP/Processors/BaseProcessor.h"
+
+namespace viator::engine
+{
+    // Führt die Processor-Chain im Audio Thread aus.
+    //
+    // Alle Puffer werden in prepare() angelegt, process() alloziert nie:
+    //   - Bypass, Mute und Dry/Wet pro Stage werden hier zentral gerechnet
+    //     (mit Rampen), ein fertig gebypasster Processor kostet nichts.
+    //   - Jeder Processor bekommt so viele Kanäle wie er erwartet
+    //     (max(In, Out)). Passt das zum Main Bus, wird in place gerechnet,
+    //     sonst über einen Scratch-Puffer mit Up-/Downmix.
+    //   - Größere Host-Blöcke als angekündigt werden aufgeteilt.
+    //   - Chain-Oversampling: eine Reihe von Processors mit
+    //     supportsChainOversampling() teilt sich ein Hoch-/Runterrechnen,
+    //     statt dass jeder selbst oversampelt. Andere Processors dazwischen
+    //     laufen mit der Basisrate und trennen die Reihen.
+    //
+    // Dry wird um die Latenz vom Processor verzögert, auch fertig gebypasst
+    // und gemutet, die gemeldete Latenz stimmt also immer. Im Chain-Oversampling
+    // haben die Processors keine eigene Latenz, dort zählt pro Reihe einmal
+    // der Oversampler (getChainLatency()).
+    class ChainExecutor
+    {
+    public:
+        static constexpr int kMaxChannels = 8;
+        static constexpr double kRampSeconds = 0.02;
+        static constexpr int kMaxOversamplingFactor = 4;   // 16X, wie globals::Oversampling
+        static constexpr int kMaxOversampledSegments = 4;
+
+        // Message Thread (prepareToPlay). maxOversamplingFactor > 0 legt die
+        // Oversampler für alle Faktoren bis dahin an, ein Satz pro Reihe.
+        void prepare(const double sampleRate, const int maxBlockSize, const int numChannels,
+                     const int maxOversamplingFactor = 0)
+        {
+            m_sample_rate = sampleRate;
+            m_max_block_size = juce::jmax(1, maxBlockSize);
+            m_num_channels = juce::jlimit(1, kMaxChannels, numChannels);
+            m_max_oversampling_factor = juce::jlimit(0, kMaxOversamplingFactor, maxOversamplingFactor);
+            m_oversampling_factor = 0;
+            jassert(numChannels <= kMaxChannels);
+
+            const int max_samples = m_max_block_size << m_max_oversampling_factor;
+            m_scratch.setSize(kMaxChannels, max_samples, false, true, false);
+            m_dry.setSize(kMaxChannels, max_samples, false, true, false);
+
+            for (int factor = 1; factor <= kMaxOversamplingFactor; ++factor)
+            {
+                for (auto& oversampler : m_oversamplers[(size_t)factor - 1])
+                {
+                    oversampler.reset();
+
+                    if (factor > m_max_oversampling_factor)
+                        continue;
+
+                    // Gleicher Filter wie im ClipperProcessBlock, damit der Vergleich fair ist
+                    oversampler = std::make_unique<viator::dsp::Oversampler>(
+                        (size_t)m_num_channels, (size_t)factor, viator::dsp::Oversampler::Phase::kLinear,
+                        viator::dsp::Oversampler::Quality::kHigh);
+                    oversampler->initProcessing((size_t)m_max_block_size);
+                }
+            }
+        }
+
+        // Anzahl der Reihen, die mit Chain-Oversampling hoch- und runtergerechnet
+        // werden (jede kostet einmal die Filterlatenz)
+        template <typename Stages>
+        static int countOversampledSegments(const Stages& stages)
+        {
+            int segments = 0;
+            bool in_segment = false;
+
+            for (const auto& stage : stages)
+            {
+                const bool supported = stage != nullptr && stage->supportsChainOversampling();
+                segments += supported && !in_segment ? 1 : 0;
+                in_segment = supported;
+            }
+
+            return juce::jmin(segments, kMaxOversampledSegments);
+        }
+
+        // Message Thread, Latenz pro Reihe in Samples der Basisrate
+        int getOversamplingLatency(const int factor) const
+        {
+            if (factor <= 0 || factor > m_max_oversampling_factor)
+                return 0;
+
+            return juce::roundToInt(m_oversamplers[(size_t)factor - 1][0]->getLatencyInSamples());
+        }
+
+        // Message Thread, Latenz der ganzen seriellen Chain wie process() sie
+        // rechnet: jede oversampelte Reihe einmal den Oversampler (auch wenn
+        // sie gerade gebypasst ist), die Processors darin ohne eigene Latenz.
+        // Reihen ab kMaxOversampledSegments laufen mit der Basisrate.
+        template <typename Stages>
+        int getChainLatency(const Stages& stages, const int oversamplingFactor) const
+        {
+            const int factor = juce::jlimit(0, m_max_oversampling_factor, oversamplingFactor);
+            int latency = 0;
+            int segments = 0;
+            bool in_segment = false;
+
+            for (const auto& stage : stages)
+            {
+                const bool supported = factor > 0 && stage != nullptr && stage->supportsChainOversampling();
+
+                if (supported && !in_segment && ++segments <= kMaxOversampledSegments)
+                    latency += getOversamplingLatency(factor);
+
+                in_segment = supported;
+
+                if (stage != nullptr && (!supported || segments > kMaxOversampledSegments))
+                    latency += stage->getLatencySamples();
+            }
+
+            return latency;
+        }
+
+        // Für jeden Processor nach prepareToPlay(), bevor er in die Chain kommt.
+        // Darf auch im Loader Thread laufen. fadeIn: startet wie gebypasst und
+        // blendet in kRampSeconds ein (neu eingefügt während der Wiedergabe).
+        static void prepareStage(viator::dsp::processors::BaseProcessor& processor, double sampleRate,
+                                 const bool fadeIn = false)
+        {
+            if (sampleRate <= 0.0)
+                sampleRate = 44100.0;
+
+            auto& state = processor.getStageState();
+            state.wet_gain.reset(sampleRate, kRampSeconds);
+            state.dry_gain.reset(sampleRate, kRampSeconds);
+
+            state.dry_latency = juce::jmax(0, processor.getLatencySamples());
+            state.dry_delay.setSize(kMaxChannels, juce::jmax(1, state.dry_latency), false, true, false);
+            state.dry_delay.clear();
+            state.dry_delay_position = 0;
+
+            float wet, dry;
+            getTargets(state, wet, dry);
+            state.wet_gain.setCurrentAndTargetValue(fadeIn ? 0.0f : wet);
+            state.dry_gain.setCurrentAndTargetValue(fadeIn ? 1.0f : dry);
+        }
+
+        // Audio Thread. stages: Range aus BaseProcessor Pointern (roh oder unique_ptr),
+        // buffer: der Main Bus. oversamplingFactor: Index in globals::Oversampling,
+        // begrenzt auf das in prepare() angelegte Maximum.
+        template <typename Stages>
+        void process(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages, const Stages& stages,
+                     const int oversamplingFactor = 0)
+        {
+            const int numChannels = juce::jmin(buffer.getNumChannels(), kMaxChannels);
+            const int numSamples = buffer.getNumSamples();
+            jassert(buffer.getNumChannels() <= kMaxChannels);
+
+            if (numChannels == 0 || numSamples == 0)
+                return;
+
+            const int factor = juce::jlimit(0, m_max_oversampling_factor, oversamplingFactor);
+            if (factor != m_oversampling_factor)
+            {
+                // Filter vom neuen Faktor haben noch den Zustand vom letzten Mal
+                if (factor > 0)
+                    for (auto& oversampler : m_oversamplers[(size_t)factor - 1])
+                        oversampler->reset();
+
+                m_oversampling_factor = factor;
+            }
+
+           #if JUCE_DEBUG
+            const auto start_ticks = juce::Time::getHighResolutionTicks();
+            m_debug_block_stage_ticks = 0;
+            int num_stages = 0;
+            for (const auto& stage : stages)
+                num_stages += stage != nullptr ? 1 : 0;
+           #endif
+
+            for (int offset = 0; offset < numSamples; offset += m_max_block_size)
+            {
+                const int block_size = juce::jmin(m_max_block_size, numSamples - offset);
+
+                std::array<float*, kMaxChannels> host {};
+                for (int ch = 0; ch < numChannels; ++ch)
+                    host[(size_t)ch] = buffer.getWritePointer(ch, offset);
+
+                if (factor > 0)
+                {
+                    processOversampledChain(stages, host.data(), numChannels, block_size, midiMessages, factor);
+                    continue;
+                }
+
+                for (const auto& stage : stages)
+                {
+                    if (stage != nullptr)
+                        processStage(*stage, host.data(), numChannels, block_size, midiMessages);
+                }
+            }
+
+           #if JUCE_DEBUG
+            logTiming(juce::Time::getHighResolutionTicks() - start_ticks, num_stages, numSamples, factor,
+                      factor > 0 ? countOversampledSegments(stages) : 0);
+           #endif
+        }
+
+       #if JUCE_DEBUG
+        // Kosten der Chain selbst (Kopien, Rampen, Up-/Downmix) ohne die
+        // Processors, gemittelt über ~1000 Blöcke. Den Sweep über 1 .. 32
+        // Processors macht der ChainExecutor Benchmark in tests/, das hier ist
+        // für echte Racks.
+        struct Timing
+        {
+            double total_us = 0.0;      // pro Block
+            double overhead_us = 0.0;   // davon ohne die Processors
+            int num_stages = 0;
+            int num_samples = 0;
+            int factor = 0;             // Chain-Oversampling, 0 = aus
+            int num_segments = 0;
+        };
+
+        // Message Thread. true, wenn seit dem letzten Aufruf neue Werte da sind.
+        bool getTiming(Timing& timing)
+        {
+            const auto before = m_timing_sequence.load(std::memory_order_acquire);
+            if (before == m_timing_read_sequence || (before & 1u) != 0)
+                return false;
+
+            timing.total_us = m_timing_total_us.load(std::memory_order_relaxed);
+            timing.overhead_us = m_timing_overhead_us.load(std::memory_order_relaxed);
+            timing.num_stages = m_timing_num_stages.load(std::memory_order_relaxed);
+            timing.num_samples = m_timing_num_samples.load(std::memory_order_relaxed);
+            timing.factor = m_timing_factor.load(std::memory_order_relaxed);
+            timing.num_segments = m_timing_num_segments.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_timing_sequence.load(std::memory_order_relaxed) != before)
+                return false;
+
+            m_timing_read_sequence = before;
+            return true;
+        }
+       #endif
+
+    private:
+        // Wie processStage(), nur wer mag bekommt die hohe Rate: pro Reihe von
+        // Processors mit supportsChainOversampling() einmal hoch, alle Stages
+        // der Reihe, einmal runter. Ab kMaxOversampledSegments Reihen läuft der
+        // Rest mit der Basisrate. Eine ganz gebypasste Reihe geht trotzdem durch
+        // den Oversampler, sonst stimmt die Latenz nicht und der Bypass springt.
+        template <typename Stages>
+        void processOversampledChain(const Stages& stages, float* const* host, const int numChannels,
+                                     const int numSamples, juce::MidiBuffer& midiMessages, const int factor)
+        {
+            const auto stages_end = std::end(stages);
+            int segment = 0;
+
+            for (auto it = std::begin(stages); it != stages_end;)
+            {
+                auto end = it;
+
+                while (end != stages_end && *end != nullptr && (*end)->supportsChainOversampling())
+                    ++end;
+
+                if (end == it)
+                {
+                    if (*it != nullptr)
+                        processStage(**it, host, numChannels, numSamples, midiMessages);
+
+                    ++it;
+                    continue;
+                }
+
+                const int index = segment++;
+
+                if (index >= kMaxOversampledSegments)
+                {
+                    for (; it != end; ++it)
+                        processStage(**it, host, numChannels, numSamples, midiMessages);
+
+                    continue;
+                }
+
+                auto& oversampler = *m_oversamplers[(size_t)factor - 1][(size_t)index];
+                const int num_channels = juce::jmin(numChannels, m_num_channels);
+
+                juce::dsp::AudioBlock<float> block(host, (size_t)num_channels, (size_t)numSamples);
+                auto up = oversampler.processSamplesUp(block);
+
+                std::array<float*, kMaxChannels> channels {};
+                for (int ch = 0; ch < num_channels; ++ch)
+                    channels[(size_t)ch] = up.getChannelPointer((size_t)ch);
+
+                for (; it != end; ++it)
+                    processStage(**it, channels.data(), num_channels, (int)up.getNumSamples(), midiMessages, factor);
+
+                oversampler.processSamplesDown(block);
+            }
+        }
+
+        static void getTargets(const viator::dsp::processors::BaseProcessor::StageState& state, float& wet, float& dry)
+        {
+            if (state.muted)
+            {
+                wet = 0.0f;
+                dry = 0.0f;
+            }
+            else if (state.bypassed)
+            {
+                wet = 0.0f;
+                dry = 1.0f;
+            }
+            else
+            {
+                wet = state.mix;
+                dry = 1.0f - wet;
+            }
+        }
+
+        // factor > 0: host läuft mit der hohen Rate (Chain-Oversampling), die
+        // Rampen laufen trotzdem in Samples der Basisrate
+        void processStage(viator::dsp::processors::BaseProcessor& processor, float* const* host,
+                          const int numChannels, const int numSamples, juce::MidiBuffer& midiMessages,
+                          const int factor = 0)
+        {
+            auto& state = processor.getStageState();
+
+            float wet_target, dry_target;
+            getTargets(state, wet_target, dry_target);
+            state.wet_gain.setTargetValue(wet_target);
+            state.dry_gain.setTargetValue(dry_target);
+
+            const bool ramping = state.wet_gain.isSmoothing() || state.dry_gain.isSmoothing();
+
+            // Im Chain-Oversampling haben die Processors keine eigene Latenz
+            const bool delay_dry = factor == 0 && state.dry_latency > 0;
+
+            // Fertig gebypasst oder gemutet: Processor gar nicht aufrufen. Mit
+            // Latenz läuft Dry trotzdem durch die Verzögerung.
+            if (!ramping && wet_target == 0.0f)
+            {
+                if (delay_dry)
+                {
+                    delayDry(state, host, numChannels, numSamples);
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        juce::FloatVectorOperations::copyWithMultiply(host[ch], m_dry.getReadPointer(ch), dry_target,
+                                                                      numSamples);
+                }
+                else if (dry_target != 1.0f)
+                {
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        juce::FloatVectorOperations::multiply(host[ch], dry_target, numSamples);
+                }
+
+                return;
+            }
+
+            // Die Verzögerung läuft immer mit, damit sie beim nächsten Bypass stimmt
+            const bool needs_dry = ramping || wet_target != 1.0f || dry_target != 0.0f;
+            if (delay_dry)
+                delayDry(state, host, numChannels, numSamples);
+            else if (needs_dry)
+                for (int ch = 0; ch < numChannels; ++ch)
+                    juce::FloatVectorOperations::copy(m_dry.getWritePointer(ch), host[ch], numSamples);
+
+            const int num_in = processor.getTotalNumInputChannels();
+            const int num_out = processor.getTotalNumOutputChannels();
+            const int num_stage = juce::jlimit(1, kMaxChannels, juce::jmax(num_in, num_out));
+            const bool in_place = num_in == numChannels && num_out == numChannels;
+
+            std::array<float*, kMaxChannels> channels {};
+            if (in_place)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                    channels[(size_t)ch] = host[ch];
+            }
+            else
+            {
+                for (int ch = 0; ch < num_stage; ++ch)
+                    channels[(size_t)ch] = m_scratch.getWritePointer(ch);
+
+                mixIn(host, numChannels, channels.data(), num_in, num_stage, numSamples);
+            }
+
+            // Referenziert nur, die Kanal-Pointer liegen im AudioBuffer selbst
+            juce::AudioBuffer<float> view(channels.data(), in_place ? numChannels : num_stage, numSamples);
+
+           #if JUCE_DEBUG
+            const auto start_ticks = juce::Time::getHighResolutionTicks();
+           #endif
+
+            if (factor > 0)
+                processor.processOversampled(view, factor);
+            else
+                processor.processBlock(view, midiMessages);
+
+           #if JUCE_DEBUG
+            m_debug_block_stage_ticks += juce::Time::getHighResolutionTicks() - start_ticks;
+           #endif
+
+            if (!in_place)
+                mixOut(channels.data(), num_out, host, numChannels, numSamples);
+
+            if (needs_dry)
+            {
+                const int ramp_samples = juce::jmax(1, numSamples >> factor);
+                const float wet_start = state.wet_gain.getCurrentValue();
+                const float wet_end = state.wet_gain.skip(ramp_samples);
+                const float dry_start = state.dry_gain.getCurrentValue();
+                const float dry_end = state.dry_gain.skip(ramp_samples);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    applyRamp(host[ch], nullptr, wet_start, wet_end, numSamples);
+                    applyRamp(host[ch], m_dry.getReadPointer(ch), dry_start, dry_end, numSamples);
+                }
+            }
+        }
+
+        // m_dry = host, um state.dry_latency Samples verzögert
+        void delayDry(viator::dsp::processors::BaseProcessor::StageState& state, const float* const* host,
+                      const int numChannels, const int numSamples)
+        {
+            const int latency = state.dry_latency;
+            int position = state.dry_delay_position;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float* ring = state.dry_delay.getWritePointer(ch);
+                float* dry = m_dry.getWritePointer(ch);
+                position = state.dry_delay_position;
+
+                for (int s = 0; s < numSamples; ++s)
+                {
+                    dry[s] = ring[position];
+                    ring[position] = host[ch][s];
+
+                    if (++position == latency)
+                        position = 0;
+                }
+            }
+
+            state.dry_delay_position = position;
+        }
+
+        // Main Bus → Processor-Eingänge: mono Processor bekommt die Summe,
+        // mono Host wird auf alle Eingänge verteilt. Reine Ausgänge werden gelöscht.
+        static void mixIn(float* const* host, const int numHost, float* const* stage,
+                          const int numIn, const int numStage, const int numSamples)
+        {
+            if (numIn == 1 && numHost > 1)
+            {
+                juce::FloatVectorOperations::copy(stage[0], host[0], numSamples);
+                for (int ch = 1; ch < numHost; ++ch)
+                    juce::FloatVectorOperations::add(stage[0], host[ch], numSamples);
+                juce::FloatVectorOperations::multiply(stage[0], 1.0f / (float)numHost, numSamples);
+            }
+            else
+            {
+                for (int ch = 0; ch < numIn; ++ch)
+                    juce::FloatVectorOperations::copy(stage[ch], host[juce::jmin(ch, numHost - 1)], numSamples);
+            }
+
+            for (int ch = numIn; ch < numStage; ++ch)
+                juce::FloatVectorOperations::clear(stage[ch], numSamples);
+        }
+
+        // Processor-Ausgänge → Main Bus, spiegelbildlich zu mixIn()
+        static void mixOut(float* const* stage, const int numOut, float* const* host,
+                           const int numHost, const int numSamples)
+        {
+            if (numOut > 1 && numHost == 1)
+            {
+                juce::FloatVectorOperations::copy(host[0], stage[0], numSamples);
+                for (int ch = 1; ch < numOut; ++ch)
+                    juce::FloatVectorOperations::add(host[0], stage[ch], numSamples);
+                juce::FloatVectorOperations::multiply(host[0], 1.0f / (float)numOut, numSamples);
+                return;
+            }
+
+            for (int ch = 0; ch < numHost; ++ch)
+                juce::FloatVectorOperations::copy(host[ch], stage[juce::jmin(ch, juce::jmax(1, numOut) - 1)], numSamples);
+        }
+
+        // source == nullptr: dest *= Rampe, sonst dest += source * Rampe (linear über den Block)
+        static void applyRamp(float* dest, const float* source, const float start, const float end,
+                              const int numSamples)
+        {
+            if (start == end)
+            {
+                if (source == nullptr)
+                    juce::FloatVectorOperations::multiply(dest, start, numSamples);
+                else if (start != 0.0f)
+                    juce::FloatVectorOperations::addWithMultiply(dest, source, start, numSamples);
+                return;
+            }
+
+            const float step = (end - start) / (float)numSamples;
+            float value = start;
+
+            if (source == nullptr)
+            {
+                for (int i = 0; i < numSamples; ++i, value += step)
+                    dest[i] *= value;
+            }
+            else
+            {
+                for (int i = 0; i < numSamples; ++i, value += step)
+                    dest[i] += source[i] * value;
+            }
+        }
+
+       #if JUCE_DEBUG
+        // Mittelwerte alle ~1000 Blöcke. Nur Zahlen in Atomics, der String
+        // und DBG kommen im Message Thread (getTiming()).
+        void logTiming(const juce::int64 totalTicks, const int numStages, const int numSamples,
+                       const int factor, const int numSegments)
+        {
+            m_debug_total_ticks += totalTicks;
+            m_debug_stage_ticks += m_debug_block_stage_ticks;
+
+            if (++m_debug_blocks < 1000)
+                return;
+
+            const double us_per_tick = 1.0e6 / (double)juce::Time::getHighResolutionTicksPerSecond();
+            const double total = (double)m_debug_total_ticks * us_per_tick / m_debug_blocks;
+            const double overhead = (double)(m_debug_total_ticks - m_debug_stage_ticks) * us_per_tick / m_debug_blocks;
+
+            // Ungerade Sequenz = wird gerade geschrieben, der Leser versucht es dann nochmal
+            m_timing_sequence.fetch_add(1, std::memory_order_acq_rel);
+            m_timing_total_us.store(total, std::memory_order_relaxed);
+            m_timing_overhead_us.store(overhead, std::memory_order_relaxed);
+            m_timing_num_stages.store(numStages, std::memory_order_relaxed);
+            m_timing_num_samples.store(numSamples, std::memory_order_relaxed);
+            m_timing_factor.store(factor, std::memory_order_relaxed);
+            m_timing_num_segments.store(numSegments, std::memory_order_relaxed);
+            m_timing_sequence.fetch_add(1, std::memory_order_release);
+
+            m_debug_total_ticks = 0;
+            m_debug_stage_ticks = 0;
+            m_debug_blocks = 0;
+        }
+
+        juce::int64 m_debug_block_stage_ticks = 0;
+        juce::int64 m_debug_total_ticks = 0;
+        juce::int64 m_debug_stage_ticks = 0;
+        int m_debug_blocks = 0;
+
+        std::atomic<juce::uint32> m_timing_sequence { 0 };
+        juce::uint32 m_timing_read_sequence = 0;   // nur Message Thread
+        std::atomic<double> m_timing_total_us { 0.0 }, m_timing_overhead_us { 0.0 };
+        std::atomic<int> m_timing_num_stages { 0 }, m_timing_num_samples { 0 };
+        std::atomic<int> m_timing_factor { 0 }, m_timing_num_segments { 0 };
+       #endif
+
+        double m_sample_rate = 0.0;
+        int m_max_block_size = 512;
+        int m_num_channels = 2;
+
+        juce::AudioBuffer<float> m_scratch;
+        juce::AudioBuffer<float> m_dry;
+
+        // [Faktor - 1][Reihe], nur bis m_max_oversampling_factor angelegt
+        std::array<std::array<std::unique_ptr<viator::dsp::Oversampler>, kMaxOversampledSegments>,
+                   kMaxOversamplingFactor> m_oversamplers;
+        int m_max_oversampling_factor = 0;
+        int m_oversampling_factor = 0;   // Audio Thread
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChainExecutor)
+    };
+}
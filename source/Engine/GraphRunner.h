@@ -0,0 +1,210 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include "ChainExecutor.h"
+#include "RenderGraph.h"
+#include "WakeEvent.h"
+
+namespace viator::engine
+{
+    // Rechnet einen RenderGraph verteilt auf den Audio Thread und ein paar
+    // eigene Realtime Worker. Jeder Thread hat eine WorkStealingQueue: fertige
+    // Nodes legen ihre bereit gewordenen Nachfolger in die eigene Queue, wer
+    // nichts mehr hat, klaut bei den anderen. Der Audio Thread rechnet selbst
+    // mit und wartet am Ende, bis alle Nodes durch sind.
+    //
+    // Die Worker laufen nur, solange die Chain parallele Zweige hat (start()
+    // und stop() aus publishChain()). Zwischen den Blöcken schlafen sie auf
+    // einem WakeEvent, drehen also keine Runden. Der Audio Thread weckt ohne
+    // Lock (fetch_add, Syscall nur wenn ein Worker schläft), und auch nur bei
+    // parallelen Graphen. Kommt ein Worker zu spät, rechnet der Audio Thread
+    // den Block eben alleine.
+    //
+    // Am Blockende wartet der Audio Thread nur auf Nodes, die ein Worker
+    // schon genommen hat, also höchstens so lange wie der längste Processor
+    // braucht (die Worker laufen realtime). Wer keinen Node hat, fasst den
+    // Graph nicht an, auf den wird nicht gewartet. Gewartet wird mit
+    // pause(), ohne yield() oder sonst einen Syscall.
+    //
+    // Pro Thread gibt es einen eigenen ChainExecutor (Bypass, Mute, Mix,
+    // Kanäle), die Scratch-Puffer werden so nie geteilt.
+    class GraphRunner
+    {
+    public:
+        static constexpr int kMaxWorkers = 3;
+
+        GraphRunner()
+        {
+            m_num_workers = juce::jlimit(0, kMaxWorkers, juce::SystemStats::getNumCpus() - 1);
+
+            for (int i = 0; i < m_num_workers; ++i)
+                m_workers[(size_t)i] = std::make_unique<Worker>(*this, i + 1);
+        }
+
+        ~GraphRunner()
+        {
+            stop();
+        }
+
+        // Message Thread (prepareToPlay). Worker starten erst mit einem
+        // parallelen Graph, siehe start().
+        void prepare(const double sampleRate, const int maxBlockSize, const int numChannels)
+        {
+            for (auto& executor : m_executors)
+                executor.prepare(sampleRate, maxBlockSize, numChannels);
+        }
+
+        // Message Thread, wenn der neue Graph parallel ist
+        void start()
+        {
+            if (isRunning())
+                return;
+
+            for (int i = 0; i < m_num_workers; ++i)
+                m_workers[(size_t)i]->startRealtimeThread(juce::Thread::RealtimeOptions {});
+        }
+
+        // Message Thread, wenn die Chain wieder seriell ist. Läuft im Audio
+        // Thread noch ein Block mit Workern, rechnet er den alleine fertig.
+        void stop()
+        {
+            for (int i = 0; i < m_num_workers; ++i)
+                m_workers[(size_t)i]->signalThreadShouldExit();
+
+            m_wake.signal();
+
+            for (int i = 0; i < m_num_workers; ++i)
+                m_workers[(size_t)i]->waitForThreadToExit(-1);
+        }
+
+        bool isRunning() const { return m_num_workers > 0 && m_workers[0]->isThreadRunning(); }
+
+        // Audio Thread. buffer: der Main Bus.
+        void process(RenderGraph& graph, juce::AudioBuffer<float>& buffer)
+        {
+            const int num_channels = juce::jmin(buffer.getNumChannels(), RenderGraph::kMaxChannels);
+            const int num_samples = buffer.getNumSamples();
+
+            if (num_channels == 0 || num_samples == 0)
+                return;
+
+            const bool use_workers = graph.isParallel() && isRunning();
+
+            for (int offset = 0; offset < num_samples; offset += graph.getMaxBlockSize())
+            {
+                const int block_size = juce::jmin(graph.getMaxBlockSize(), num_samples - offset);
+
+                std::array<float*, RenderGraph::kMaxChannels> host {};
+                for (int ch = 0; ch < num_channels; ++ch)
+                    host[(size_t)ch] = buffer.getWritePointer(ch, offset);
+
+                graph.beginBlock(host.data(), num_channels, block_size);
+
+                // Erst Graph und Zähler, dann die Roots: wer einen Node
+                // bekommt, sieht auch den passenden Graph
+                m_graph.store(&graph, std::memory_order_release);
+                m_remaining.store(graph.getNumNodes(), std::memory_order_release);
+
+                for (const int root : graph.getRoots())
+                    m_queues[0].push(root);
+
+                if (use_workers)
+                    m_wake.signal();
+
+                // Kommt erst zurück, wenn alle Nodes fertig sind. Danach hat
+                // kein Worker mehr einen Node, der Graph gehört wieder uns.
+                runNodes(0);
+
+                graph.endBlock(host.data(), num_channels);
+            }
+        }
+
+    private:
+        class Worker : public juce::Thread
+        {
+        public:
+            Worker(GraphRunner& owner, const int index)
+                : juce::Thread("Mix2Go Render Worker " + juce::String(index)), m_owner(owner), m_index(index)
+            {
+            }
+
+            void run() override
+            {
+                while (!threadShouldExit())
+                {
+                    // Sequenz vor dem Rechnen merken, ein Block der währenddessen
+                    // startet weckt sofort wieder
+                    const auto seen = m_owner.m_wake.getSequence();
+                    m_owner.runNodes(m_index);
+
+                    if (!threadShouldExit())
+                        m_owner.m_wake.wait(seen);
+                }
+            }
+
+        private:
+            GraphRunner& m_owner;
+            const int m_index;
+        };
+
+        // Nodes rechnen bis der Block fertig ist: eigene Queue, dann klauen.
+        // Den Graph holt sich der Thread erst mit einem Node, ohne Node hält
+        // also niemand eine Referenz auf ihn.
+        void runNodes(const int worker)
+        {
+            auto& queue = m_queues[(size_t)worker];
+            const int num_threads = m_num_workers + 1;
+
+            while (m_remaining.load(std::memory_order_acquire) > 0)
+            {
+                int node = -1;
+                bool found = queue.pop(node);
+
+                for (int i = 1; !found && i < num_threads; ++i)
+                    found = m_queues[(size_t)((worker + i) % num_threads)].steal(node);
+
+                if (!found)
+                {
+                    // Alles Übrige läuft gerade in anderen Threads
+                    WakeEvent::pause();
+                    continue;
+                }
+
+                runNode(*m_graph.load(std::memory_order_acquire), node, worker);
+            }
+        }
+
+        void runNode(RenderGraph& graph, const int node, const int worker)
+        {
+            juce::AudioBuffer<float> view;
+            auto* processor = graph.gather(node, view);
+
+            if (processor != nullptr)
+            {
+                const std::array<viator::dsp::processors::BaseProcessor*, 1> stage { processor };
+                m_midi[(size_t)worker].clear();
+                m_executors[(size_t)worker].process(view, m_midi[(size_t)worker], stage);
+            }
+
+            graph.complete(node, [this, worker](const int ready) { m_queues[(size_t)worker].push(ready); });
+            m_remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        int m_num_workers = 0;
+        std::array<std::unique_ptr<Worker>, kMaxWorkers> m_workers;
+
+        // Index 0 = Audio Thread, 1.. = Worker
+        std::array<WorkStealingQueue, kMaxWorkers + 1> m_queues;
+        std::array<ChainExecutor, kMaxWorkers + 1> m_executors;
+        std::array<juce::MidiBuffer, kMaxWorkers + 1> m_midi;
+
+        std::atomic<RenderGraph*> m_graph { nullptr };
+        std::atomic<int> m_remaining { 0 };
+        WakeEvent m_wake;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GraphRunner)
+    };
+}
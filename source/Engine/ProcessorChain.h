@@ -0,0 +1,145 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "../DSP/Processors/BaseProcessor.h"
+#include "RenderGraph.h"
+
+namespace viator::engine
+{
+    // Die Processor-Chain für den Audio Thread als unveränderlicher Snapshot
+    // hinter einem atomaren Pointer (RCU):
+    //
+    //   Message Thread  → publish()    neuen Snapshot bauen und austauschen,
+    //                                  der alte kommt in die Retired-Liste
+    //   Audio Thread    → ScopedRead   Snapshot für den ganzen Block festhalten
+    //   Timer           → reclaim()    alte Snapshots löschen, sobald der Audio
+    //                                  Thread sie nicht mehr hält
+    //
+    // Der Audio Thread wartet nie, lässt keinen Block aus und fasst keine
+    // Refcounts an, gelöscht wird also nie im Audio Thread. Welchen Snapshot
+    // er gerade liest, steht in m_reader (Hazard Pointer, ein Leser).
+    //
+    // Aufgeräumt wird auf dem Message Thread statt in einem eigenen Thread:
+    // die Processors haben ein APVTS (mit Timer) und Editoren, die dürfen nur
+    // dort zerstört werden.
+    class ProcessorChain : private juce::Timer
+    {
+        struct Snapshot;
+
+    public:
+        using ProcessorPtr = std::shared_ptr<viator::dsp::processors::BaseProcessor>;
+        using Processors = std::vector<ProcessorPtr>;
+
+        static constexpr int kReclaimIntervalMs = 100;
+
+        ProcessorChain()
+        {
+            m_current.store(new Snapshot());
+            startTimer(kReclaimIntervalMs);
+        }
+
+        ~ProcessorChain() override
+        {
+            stopTimer();
+            jassert(m_reader.load() == nullptr);
+
+            for (auto* snapshot : m_retired)
+                delete snapshot;
+
+            delete m_current.load();
+        }
+
+        // Message Thread. Ab dem nächsten Block rechnet der Audio Thread mit
+        // processors. graph: nur bei paralleler Verschaltung, er zeigt auf
+        // die processors und lebt mit ihnen im gleichen Snapshot.
+        void publish(Processors processors, std::unique_ptr<RenderGraph> graph = nullptr)
+        {
+            auto* next = new Snapshot { std::move(processors), std::move(graph) };
+            m_retired.push_back(m_current.exchange(next));
+            reclaim();
+        }
+
+        // Audio Thread, hält den aktuellen Snapshot bis zum Ende vom Scope
+        class ScopedRead
+        {
+        public:
+            explicit ScopedRead(ProcessorChain& chain) : m_chain(chain), m_snapshot(chain.acquire()) {}
+            ~ScopedRead() { m_chain.release(); }
+
+            const Processors& get() const { return m_snapshot->processors; }
+            RenderGraph* getGraph() const { return m_snapshot->graph.get(); }
+
+        private:
+            ProcessorChain& m_chain;
+            const Snapshot* m_snapshot;
+
+            JUCE_DECLARE_NON_COPYABLE(ScopedRead)
+        };
+
+    private:
+        struct Snapshot
+        {
+            Processors processors;
+            std::unique_ptr<RenderGraph> graph;
+        };
+
+        // Erst den Hazard setzen, dann prüfen ob der Snapshot noch aktuell
+        // ist. Sonst könnte reclaim() ihn genau dazwischen löschen.
+        const Snapshot* acquire()
+        {
+            jassert(m_reader.load() == nullptr);   // nur ein Leser
+
+            auto* snapshot = m_current.load();
+            for (;;)
+            {
+                m_reader.store(snapshot);
+                auto* latest = m_current.load();
+                if (latest == snapshot)
+                    return snapshot;
+
+                snapshot = latest;
+            }
+        }
+
+        void release()
+        {
+            m_reader.store(nullptr, std::memory_order_release);
+        }
+
+        // Message Thread
+        void reclaim()
+        {
+            const auto* reader = m_reader.load();
+
+            for (size_t i = 0; i < m_retired.size();)
+            {
+                if (m_retired[i] == reader)
+                {
+                    ++i;
+                    continue;
+                }
+
+                delete m_retired[i];
+                m_retired[i] = m_retired.back();
+                m_retired.pop_back();
+            }
+        }
+
+        void timerCallback() override
+        {
+            if (!m_retired.empty())
+                reclaim();
+        }
+
+        std::atomic<Snapshot*> m_current { nullptr };
+        std::atomic<const Snapshot*> m_reader { nullptr };
+
+        // Nur Message Thread
+        std::vector<Snapshot*> m_retired;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessorChain)
+    };
+}
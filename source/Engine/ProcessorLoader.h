@@ -0,0 +1,129 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include "../DSP/Processors/BaseProcessor.h"
+
+namespace viator::engine
+{
+    // Baut neue Processors im Hintergrund: Konstruktor (APVTS, Oversampler)
+    // und prepareToPlay() laufen in einem eigenen Thread, fertige Processors
+    // kommen per onLoaded auf dem Message Thread an. Dort werden sie in die
+    // Chain eingefügt (der Audio Thread sieht sie erst ab dem nächsten Block)
+    // oder in den ProcessorPool gelegt.
+    //
+    //   Message Thread  → load()           Job einreihen
+    //   Loader Thread   → job()            Processor bauen und vorbereiten
+    //   Message Thread  → onLoaded(...)    in der Reihenfolge der load() Aufrufe,
+    //                                      auch mit nullptr wenn der Job scheitert
+    class ProcessorLoader : private juce::Thread, private juce::AsyncUpdater
+    {
+    public:
+        using ProcessorPtr = std::unique_ptr<viator::dsp::processors::BaseProcessor>;
+        using Job = std::function<ProcessorPtr()>;
+        using Callback = std::function<void(ProcessorPtr)>;
+
+        ProcessorLoader() : juce::Thread("Mix2Go Processor Loader") {}
+
+        ~ProcessorLoader() override
+        {
+            stopThread(5000);
+            cancelPendingUpdate();
+
+            // Nicht abgeholte Processors hier zerstören (Message Thread)
+            const juce::ScopedLock lock(m_lock);
+            m_jobs.clear();
+            m_loaded.clear();
+        }
+
+        // Message Thread
+        void load(Job job, Callback onLoaded)
+        {
+            {
+                const juce::ScopedLock lock(m_lock);
+                m_jobs.push_back({ std::move(job), std::move(onLoaded) });
+            }
+
+            if (!isThreadRunning())
+                startThread(juce::Thread::Priority::normal);
+
+            notify();
+        }
+
+    private:
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                Entry entry;
+                {
+                    const juce::ScopedLock lock(m_lock);
+                    if (!m_jobs.empty())
+                    {
+                        entry = std::move(m_jobs.front());
+                        m_jobs.pop_front();
+                    }
+                }
+
+                if (!entry.job)
+                {
+                    wait(-1);
+                    continue;
+                }
+
+                const auto start_ticks = juce::Time::getHighResolutionTicks();
+                auto processor = entry.job();
+
+                DBG("[Loader] " << (processor != nullptr ? processor->getName() : juce::String("nullptr"))
+                    << " ready after " << juce::String(juce::Time::highResolutionTicksToSeconds(
+                           juce::Time::getHighResolutionTicks() - start_ticks) * 1000.0, 1) << " ms");
+
+                {
+                    const juce::ScopedLock lock(m_lock);
+                    m_loaded.push_back({ std::move(processor), std::move(entry.on_loaded) });
+                }
+
+                triggerAsyncUpdate();
+            }
+        }
+
+        void handleAsyncUpdate() override
+        {
+            for (;;)
+            {
+                Loaded loaded;
+                {
+                    const juce::ScopedLock lock(m_lock);
+                    if (m_loaded.empty())
+                        break;
+
+                    loaded = std::move(m_loaded.front());
+                    m_loaded.pop_front();
+                }
+
+                if (loaded.on_loaded)
+                    loaded.on_loaded(std::move(loaded.processor));
+            }
+        }
+
+        struct Entry
+        {
+            Job job;
+            Callback on_loaded;
+        };
+
+        struct Loaded
+        {
+            ProcessorPtr processor;
+            Callback on_loaded;
+        };
+
+        juce::CriticalSection m_lock;
+        std::deque<Entry> m_jobs;
+        std::deque<Loaded> m_loaded;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessorLoader)
+    };
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include "../DSP/Processors/ProcessorUtils.h"
+#include "ProcessorLoader.h"
+
+namespace viator::engine
+{
+    // Vergibt Processor IDs. Die ID steckt in jeder Parameter ID vom Processor
+    // ("driveID7") und damit auch in den Macro-Zuweisungen, deshalb wird sie
+    // beim Bauen einmal vergeben und nie wiederverwendet. So kann ein Processor
+    // an jede Position in der Chain, ohne dass etwas umbenannt werden muss.
+    class ProcessorIdAllocator
+    {
+    public:
+        // Jeder Thread
+        int allocate() { return m_next_id++; }
+
+        // Geladene IDs (setStateInformation) nicht nochmal vergeben
+        void reserve(const int id)
+        {
+            int next = m_next_id.load();
+            while (next <= id && !m_next_id.compare_exchange_weak(next, id + 1)) {}
+        }
+
+    private:
+        std::atomic<int> m_next_id { 0 };
+    };
+
+    // Pro Processor-Typ ein paar fertig gebaute und vorbereitete Instanzen,
+    // damit Drag & Drop in den Rack sofort einfügen kann statt erst APVTS und
+    // Oversampler zu bauen. Nachgefüllt wird im ProcessorLoader Thread.
+    //
+    // Alles auf dem Message Thread, außer setSpec() (aus prepareToPlay).
+    // Ändert der Host Sample Rate oder Block Size, werden die Instanzen
+    // verworfen und neu gebaut.
+    class ProcessorPool : private juce::Timer
+    {
+    public:
+        using ProcessorPtr = std::unique_ptr<viator::dsp::processors::BaseProcessor>;
+        using PrepareFunction = std::function<void(viator::dsp::processors::BaseProcessor&, double, int)>;
+
+        static constexpr int kInstancesPerType = 1;
+        static constexpr int kCheckIntervalMs = 250;
+
+        ProcessorPool(ProcessorLoader& loader, ProcessorIdAllocator& ids, PrepareFunction prepare)
+            : m_loader(loader), m_ids(ids), m_prepare(std::move(prepare))
+        {
+            startTimer(kCheckIntervalMs);
+        }
+
+        ~ProcessorPool() override
+        {
+            stopTimer();
+        }
+
+        // Jeder Thread. Gefüllt wird erst, wenn der Host vorbereitet hat.
+        void setSpec(const double sampleRate, const int blockSize)
+        {
+            m_sample_rate = sampleRate;
+            m_block_size = blockSize;
+        }
+
+        // Fertige Instanz oder nullptr, wenn gerade keine passende da ist
+        ProcessorPtr take(const viator::dsp::processors::ProcessorType type)
+        {
+            auto& pool = m_pools[type];
+            ProcessorPtr processor;
+
+            while (!pool.ready.empty() && processor == nullptr)
+            {
+                processor = std::move(pool.ready.front());
+                pool.ready.pop_front();
+
+                if (!matchesSpec(*processor))
+                    processor.reset();
+            }
+
+            refill();
+            return processor;
+        }
+
+        // Alle Instanzen verwerfen, z.B. nach dem Laden eines States
+        // (die IDs könnten mit geladenen Processors kollidieren)
+        void clear()
+        {
+            for (auto& [type, pool] : m_pools)
+                pool.ready.clear();
+
+            refill();
+        }
+
+    private:
+        struct Pool
+        {
+            std::deque<ProcessorPtr> ready;
+            int pending = 0;
+        };
+
+        bool matchesSpec(const viator::dsp::processors::BaseProcessor& processor) const
+        {
+            return processor.getSampleRate() == m_sample_rate.load()
+                && processor.getBlockSize() == m_block_size.load();
+        }
+
+        void timerCallback() override
+        {
+            refill();
+        }
+
+        void refill()
+        {
+            const double sample_rate = m_sample_rate;
+            const int block_size = m_block_size;
+
+            if (sample_rate <= 0.0 || block_size <= 0)
+                return;
+
+            for (const auto& def : viator::dsp::processors::getProcessorRegistry())
+            {
+                auto& pool = m_pools[def.type];
+
+                // Veraltete Instanzen (Host hat neu vorbereitet) raus
+                for (auto it = pool.ready.begin(); it != pool.ready.end();)
+                    it = matchesSpec(**it) ? it + 1 : pool.ready.erase(it);
+
+                while (static_cast<int>(pool.ready.size()) + pool.pending < kInstancesPerType)
+                {
+                    ++pool.pending;
+
+                    const auto type = def.type;
+                    const int id = m_ids.allocate();
+
+                    m_loader.load([type, id, sample_rate, block_size, prepare = m_prepare]()
+                                  {
+                                      auto processor = viator::dsp::processors::createProcessorByType(type, id);
+
+                                      if (processor)
+                                          prepare(*processor, sample_rate, block_size);
+
+                                      return processor;
+                                  },
+                                  [this, type](ProcessorPtr processor)
+                                  {
+                                      auto& target = m_pools[type];
+                                      --target.pending;
+
+                                      if (processor != nullptr && matchesSpec(*processor))
+                                          target.ready.push_back(std::move(processor));
+                                  });
+                }
+            }
+        }
+
+        ProcessorLoader& m_loader;
+        ProcessorIdAllocator& m_ids;
+        PrepareFunction m_prepare;
+
+        std::atomic<double> m_sample_rate { 0.0 };
+        std::atomic<int> m_block_size { 0 };
+
+        // Nur Message Thread
+        std::map<viator::dsp::processors::ProcessorType, Pool> m_pools;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessorPool)
+    };
+}
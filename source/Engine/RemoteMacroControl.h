@@ -0,0 +1,73 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "../Globals/Parameters.h"
+#include "../Streaming/RemoteControl.h"
+
+namespace viator::engine
+{
+    // Verbindet die Macro-Fernsteuerung vom Handy mit dem APVTS.
+    // Läuft komplett auf dem Message Thread: 30 mal pro Sekunde werden die
+    // gesammelten Remote-Updates angewendet und der aktuelle Stand (auch
+    // Automation und GUI) zurück ins Postfach gelegt.
+    class RemoteMacroControl : private juce::Timer
+    {
+    public:
+        static constexpr int kUpdateRateHz = 30;
+
+        RemoteMacroControl(juce::AudioProcessorValueTreeState& treeState,
+                           mix2go::streaming::RemoteControl& remoteControl)
+            : m_remote_control(remoteControl)
+        {
+            const juce::String ids[] = { parameters::macro1ID, parameters::macro2ID, parameters::macro3ID,
+                                         parameters::macro4ID, parameters::macro5ID, parameters::macro6ID,
+                                         parameters::macro7ID, parameters::macro8ID, parameters::macro9ID,
+                                         parameters::macro10ID };
+
+            static_assert(sizeof(ids) / sizeof(ids[0]) == mix2go::streaming::RemoteControl::NUM_MACROS,
+                          "Macro list and RemoteControl::NUM_MACROS differ");
+
+            for (size_t i = 0; i < m_params.size(); ++i)
+                m_params[i] = treeState.getParameter(ids[i]);
+
+            startTimerHz(kUpdateRateHz);
+        }
+
+        ~RemoteMacroControl() override
+        {
+            stopTimer();
+        }
+
+    private:
+        void timerCallback() override
+        {
+            std::array<float, mix2go::streaming::RemoteControl::NUM_MACROS> values {};
+            const auto mask = m_remote_control.takeRemote(values);
+
+            for (size_t i = 0; i < m_params.size(); ++i)
+            {
+                auto* param = m_params[i];
+                if (param == nullptr || (mask & (1u << i)) == 0)
+                    continue;
+
+                // Ein Gesture pro Update, damit der Host die Automation sauber schreibt
+                param->beginChangeGesture();
+                param->setValueNotifyingHost(values[i]);
+                param->endChangeGesture();
+            }
+
+            const bool fullState = m_remote_control.takeFullStateRequest();
+
+            for (size_t i = 0; i < m_params.size(); ++i)
+            {
+                if (auto* param = m_params[i])
+                    m_remote_control.postState(static_cast<int>(i), param->getValue(), fullState);
+            }
+        }
+
+        mix2go::streaming::RemoteControl& m_remote_control;
+        std::array<juce::RangedAudioParameter*, mix2go::streaming::RemoteControl::NUM_MACROS> m_params {};
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RemoteMacroControl)
+    };
+}
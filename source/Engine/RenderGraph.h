@@ -0,0 +1,294 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "../DSP/Processors/BaseProcessor.h"
+
+namespace viator::engine
+{
+    // Chase-Lev Deque mit fester Größe für Node-Indizes.
+    // push()/pop() nur vom Besitzer, steal() von allen anderen Threads.
+    // top/bottom laufen nur hoch (int64), deshalb nie ein Reset nötig.
+    class WorkStealingQueue
+    {
+    public:
+        static constexpr int kCapacity = 256;   // Zweierpotenz
+
+        void push(const int item)
+        {
+            const auto bottom = m_bottom.load(std::memory_order_relaxed);
+            jassert(bottom - m_top.load(std::memory_order_acquire) < kCapacity);
+
+            m_items[(size_t)(bottom & (kCapacity - 1))].store(item, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        bool pop(int& item)
+        {
+            const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            item = m_items[(size_t)(bottom & (kCapacity - 1))].load(std::memory_order_relaxed);
+            if (top < bottom)
+                return true;
+
+            // Letztes Element, mit den Dieben um die Wette
+            const bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                           std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        bool steal(int& item)
+        {
+            auto top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+                return false;
+
+            item = m_items[(size_t)(top & (kCapacity - 1))].load(std::memory_order_relaxed);
+            return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                 std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<int64_t> m_top { 0 };
+        std::atomic<int64_t> m_bottom { 0 };
+        std::array<std::atomic<int>, kCapacity> m_items {};
+    };
+
+    // Die Chain als DAG: jeder Node summiert seine Eingänge (latenzkompensiert)
+    // und schickt das Ergebnis optional durch einen Processor. Ein Node ohne
+    // Processor ist ein reiner Merge. Splits brauchen keinen eigenen Node,
+    // mehrere Nodes lesen einfach den gleichen Eingang.
+    //
+    // Ein Merge mittelt seine N Eingänge (1 / N): Split und Merge über
+    // Zweige, die nichts tun, ergeben wieder den Eingang statt +6 dB (bzw.
+    // 20 log N). Für parallele Kompression o.ä. das Verhältnis der Zweige
+    // über deren Mix bzw. Output einstellen, ein trockener Zweig ist ein
+    // Processor mit Mix 0.
+    //
+    // Wird auf dem Message Thread gebaut (alle Puffer, Delays und die
+    // Topologie) und danach nicht mehr verändert, außer den Laufzeit-Zählern
+    // und Delay-Inhalten im Audio Thread bzw. den Render Workern.
+    class RenderGraph
+    {
+    public:
+        static constexpr int kHostInput = -1;
+        static constexpr int kMaxChannels = 2;
+        static constexpr int kMaxNodes = WorkStealingQueue::kCapacity;
+
+        struct NodeDescription
+        {
+            viator::dsp::processors::BaseProcessor* processor = nullptr;
+            std::vector<int> inputs;   // frühere Nodes oder kHostInput
+        };
+
+        // nodes in topologischer Reihenfolge, der letzte Node ist der Ausgang
+        RenderGraph(const std::vector<NodeDescription>& nodes, const int numChannels, const int maxBlockSize)
+            : m_num_channels(juce::jlimit(1, kMaxChannels, numChannels)),
+              m_max_block_size(juce::jmax(1, maxBlockSize)),
+              m_nodes((size_t)juce::jlimit(1, kMaxNodes, (int)nodes.size()))
+        {
+            jassert(!nodes.empty() && (int)nodes.size() <= kMaxNodes);
+
+            m_input.setSize(m_num_channels, m_max_block_size);
+
+            for (size_t i = 0; i < m_nodes.size(); ++i)
+            {
+                const auto& description = i < nodes.size() ? nodes[i] : NodeDescription {};
+                auto& node = m_nodes[i];
+                node.processor = description.processor;
+                node.buffer.setSize(m_num_channels, m_max_block_size);
+
+                // Latenz am Eingang = langsamster Pfad, die anderen werden verzögert
+                int input_latency = 0;
+                for (const int source : description.inputs)
+                {
+                    jassert(source < (int)i);
+                    input_latency = juce::jmax(input_latency, getOutputLatency(source));
+                }
+
+                for (const int source : description.inputs)
+                {
+                    Input input;
+                    input.source = source;
+                    input.delay = input_latency - getOutputLatency(source);
+
+                    if (input.delay > 0)
+                        input.delay_buffer.setSize(m_num_channels, input.delay, false, true);
+
+                    node.inputs.push_back(std::move(input));
+
+                    if (source != kHostInput)
+                    {
+                        m_nodes[(size_t)source].dependents.push_back((int)i);
+                        ++node.num_node_inputs;
+                    }
+                }
+
+                // Hängt nur am Host-Eingang (oder an nichts): sofort startbereit
+                if (node.num_node_inputs == 0)
+                    m_roots.push_back((int)i);
+
+                node.output_latency = input_latency
+                                    + (node.processor != nullptr ? node.processor->getLatencySamples() : 0);
+
+                if (node.processor == nullptr && node.inputs.size() > 1)
+                    node.gain = 1.0f / (float)node.inputs.size();
+            }
+
+            for (const auto& node : m_nodes)
+                m_is_parallel = m_is_parallel || node.inputs.size() > 1 || node.dependents.size() > 1;
+        }
+
+        int getNumNodes() const { return (int)m_nodes.size(); }
+        int getNumChannels() const { return m_num_channels; }
+        int getMaxBlockSize() const { return m_max_block_size; }
+        int getLatencySamples() const { return m_nodes.back().output_latency; }
+
+        // Lohnt sich der Worker Pool? (Sonst ist es eine einfache Chain)
+        bool isParallel() const { return m_is_parallel; }
+
+        const std::vector<int>& getRoots() const { return m_roots; }
+
+        // Audio Thread, vor dem Verteilen der Nodes
+        void beginBlock(const float* const* host, const int numChannels, const int numSamples)
+        {
+            m_num_samples = numSamples;
+
+            for (int ch = 0; ch < m_num_channels; ++ch)
+                m_input.copyFrom(ch, 0, host[juce::jmin(ch, numChannels - 1)], numSamples);
+
+            for (auto& node : m_nodes)
+                node.pending.store(node.num_node_inputs, std::memory_order_relaxed);
+        }
+
+        // Audio Thread, wenn alle Nodes fertig sind
+        void endBlock(float* const* host, const int numChannels) const
+        {
+            const auto& output = m_nodes.back().buffer;
+            for (int ch = 0; ch < numChannels; ++ch)
+                juce::FloatVectorOperations::copy(host[ch], output.getReadPointer(juce::jmin(ch, m_num_channels - 1)),
+                                                  m_num_samples);
+        }
+
+        // Eingänge summieren (Merge: mitteln), ein Thread pro Node. Gibt den
+        // Processor zurück (oder nullptr).
+        viator::dsp::processors::BaseProcessor* gather(const int index, juce::AudioBuffer<float>& view)
+        {
+            auto& node = m_nodes[(size_t)index];
+            const int num_samples = m_num_samples;
+
+            for (size_t i = 0; i < node.inputs.size(); ++i)
+            {
+                auto& input = node.inputs[i];
+                const auto& source = input.source == kHostInput ? m_input : m_nodes[(size_t)input.source].buffer;
+
+                for (int ch = 0; ch < m_num_channels; ++ch)
+                {
+                    float* dest = node.buffer.getWritePointer(ch);
+                    const float* data = source.getReadPointer(ch);
+
+                    if (input.delay > 0)
+                        delayInto(input, ch, data, dest, num_samples, i == 0);
+                    else if (i == 0)
+                        juce::FloatVectorOperations::copy(dest, data, num_samples);
+                    else
+                        juce::FloatVectorOperations::add(dest, data, num_samples);
+                }
+            }
+
+            if (node.inputs.empty())
+                node.buffer.clear(0, num_samples);
+            else if (node.gain != 1.0f)
+                for (int ch = 0; ch < m_num_channels; ++ch)
+                    juce::FloatVectorOperations::multiply(node.buffer.getWritePointer(ch), node.gain, num_samples);
+
+            view.setDataToReferTo(node.buffer.getArrayOfWritePointers(), m_num_channels, num_samples);
+            return node.processor;
+        }
+
+        // Nach dem Node: Zähler der Nachfolger runter, bereit gewordene an ready()
+        template <typename ReadyFunction>
+        void complete(const int index, ReadyFunction&& ready)
+        {
+            for (const int dependent : m_nodes[(size_t)index].dependents)
+                if (m_nodes[(size_t)dependent].pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    ready(dependent);
+        }
+
+    private:
+        struct Input
+        {
+            int source = kHostInput;
+            int delay = 0;
+            juce::AudioBuffer<float> delay_buffer;   // Ring mit genau delay Samples
+            int delay_position = 0;
+        };
+
+        struct Node
+        {
+            viator::dsp::processors::BaseProcessor* processor = nullptr;
+            std::vector<Input> inputs;
+            std::vector<int> dependents;
+            juce::AudioBuffer<float> buffer;
+            int num_node_inputs = 0;   // ohne den Host-Eingang
+            int output_latency = 0;
+            float gain = 1.0f;         // Merge: 1 / Anzahl Eingänge
+            std::atomic<int> pending { 0 };
+        };
+
+        int getOutputLatency(const int source) const
+        {
+            return source == kHostInput ? 0 : m_nodes[(size_t)source].output_latency;
+        }
+
+        // Ring mit delay Samples: raus kommt was vor delay Samples rein ging
+        static void delayInto(Input& input, const int channel, const float* data, float* dest,
+                              const int numSamples, const bool overwrite)
+        {
+            float* ring = input.delay_buffer.getWritePointer(channel);
+            int position = input.delay_position;
+
+            for (int s = 0; s < numSamples; ++s)
+            {
+                const float delayed = ring[position];
+                ring[position] = data[s];
+                dest[s] = overwrite ? delayed : dest[s] + delayed;
+
+                if (++position == input.delay)
+                    position = 0;
+            }
+
+            // Alle Kanäle laufen gleich weit, der letzte merkt sich die Position
+            if (channel == input.delay_buffer.getNumChannels() - 1)
+                input.delay_position = position;
+        }
+
+        const int m_num_channels;
+        const int m_max_block_size;
+
+        juce::AudioBuffer<float> m_input;
+        std::vector<Node> m_nodes;
+        std::vector<int> m_roots;
+        bool m_is_parallel = false;
+
+        int m_num_samples = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderGraph)
+    };
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cstdint>
+
+#if JUCE_LINUX
+ #include <climits>
+ #include <linux/futex.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#elif JUCE_WINDOWS
+ // Forward-declare, damit windows.h nicht in den Header kommt (wie in NetworkSender.h)
+ extern "C" {
+     __declspec(dllimport) int __stdcall WaitOnAddress(volatile void* address, void* compareAddress,
+                                                       size_t addressSize, unsigned long milliseconds);
+     __declspec(dllimport) void __stdcall WakeByAddressAll(void* address);
+ }
+ #pragma comment(lib, "synchronization.lib")
+#endif
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+namespace viator::engine
+{
+    // Wecken ohne Mutex: eine Sequenz, die signal() hochzählt, und die Zahl
+    // der Schläfer. signal() ist ein fetch_add und macht nur dann einen
+    // Syscall (futex wake, WakeByAddressAll, dispatch_semaphore_signal), wenn
+    // wirklich jemand schläft. juce::WaitableEvent nimmt dafür jedes Mal
+    // einen Mutex (pthread_mutex + condvar), das hat im Audio Thread nichts
+    // verloren.
+    //
+    // Der Schläfer merkt sich die Sequenz vor dem Prüfen seiner Bedingung
+    // und schläft nur, solange sie sich nicht geändert hat. Ein signal()
+    // dazwischen geht so nicht verloren.
+    class WakeEvent
+    {
+    public:
+        WakeEvent()
+        {
+           #if JUCE_MAC || JUCE_IOS
+            m_semaphore = dispatch_semaphore_create(0);
+           #endif
+        }
+
+        ~WakeEvent()
+        {
+           #if JUCE_MAC || JUCE_IOS
+            dispatch_release(m_semaphore);
+           #endif
+        }
+
+        uint32_t getSequence() const { return m_sequence.load(std::memory_order_acquire); }
+
+        // Beliebiger Thread, wait-free
+        void signal()
+        {
+            m_sequence.fetch_add(1, std::memory_order_release);
+
+            // Gegenstück zum fetch_add in wait(): entweder sieht der Schläfer
+            // die neue Sequenz, oder wir sehen ihn
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto sleepers = m_sleepers.load(std::memory_order_relaxed);
+            if (sleepers == 0)
+                return;
+
+           #if JUCE_LINUX
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_sequence), FUTEX_WAKE_PRIVATE, INT_MAX,
+                    nullptr, nullptr, 0);
+           #elif JUCE_MAC || JUCE_IOS
+            for (int i = 0; i < sleepers; ++i)
+                dispatch_semaphore_signal(m_semaphore);
+           #elif JUCE_WINDOWS
+            WakeByAddressAll(&m_sequence);
+           #endif
+        }
+
+        // Nicht im Audio Thread. Schläft, bis die Sequenz nicht mehr seen ist
+        // (oder spurious, der Aufrufer prüft ohnehin nochmal).
+        void wait(const uint32_t seen)
+        {
+            m_sleepers.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (m_sequence.load(std::memory_order_relaxed) == seen)
+            {
+               #if JUCE_LINUX
+                syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_sequence), FUTEX_WAIT_PRIVATE, seen,
+                        nullptr, nullptr, 0);
+               #elif JUCE_MAC || JUCE_IOS
+                // Ein Token von einem signal(), das uns noch mitgezählt hat,
+                // bleibt liegen und weckt später einmal umsonst, harmlos
+                dispatch_semaphore_wait(m_semaphore, DISPATCH_TIME_FOREVER);
+               #elif JUCE_WINDOWS
+                auto compare = seen;
+                WaitOnAddress(&m_sequence, &compare, sizeof(compare), 0xFFFFFFFF);
+               #else
+                juce::Thread::sleep(1);
+               #endif
+            }
+
+            m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        // Für Warteschleifen im Audio Thread: sagt der CPU, dass wir drehen
+        // (spart Strom, gibt dem Hyperthread Luft), ohne Syscall
+        static void pause()
+        {
+           #if JUCE_INTEL
+            _mm_pause();
+           #elif JUCE_ARM && (JUCE_GCC || JUCE_CLANG)
+            __asm__ __volatile__ ("yield");
+           #endif
+        }
+
+    private:
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex needs a plain 32-bit word");
+
+        std::atomic<uint32_t> m_sequence { 0 };
+        std::atomic<int> m_sleepers { 0 };
+
+       #if JUCE_MAC || JUCE_IOS
+        dispatch_semaphore_t m_semaphore {};
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE(WakeEvent)
+    };
+}
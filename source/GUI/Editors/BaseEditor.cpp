@@ -33,13 +33,22 @@ namespace viator::gui::editors
         items.clear();
         items = {"Off", "X2", "X4", "X8", "X16"};
         setComboBoxProps(m_oversampling_menu, items);
-        m_oversampling_menu_attach = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
-            processorRef
-            .getTreeState(),
-            "oversamplingChoiceID" +
-            juce::String(
-                processorRef.getProcessorID()),
-            m_oversampling_menu);
+
+        // Nicht jeder Processor oversampelt selbst (Console läuft nur im
+        // Chain-Oversampling), dann bleibt das Menü aus
+        const auto oversampling_id = "oversamplingChoiceID" + juce::String(processorRef.getProcessorID());
+        if (processorRef.getTreeState().getParameter(oversampling_id) != nullptr)
+        {
+            m_oversampling_menu_attach = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+                processorRef
+                .getTreeState(),
+                oversampling_id,
+                m_oversampling_menu);
+        }
+        else
+        {
+            m_oversampling_menu.setEnabled(false);
+        }
 
         // BUTTONS
         setButtonProps(m_buttons[kMute], "M");
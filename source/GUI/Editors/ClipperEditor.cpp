@@ -44,6 +44,16 @@ namespace viator::gui::editors
                         processorRef.getProcessorID()),
                 m_clipper_type_menu);
 
+        // anti aliasing menu (ADAA, spart Oversampling)
+        setComboBoxProps(m_anti_aliasing_menu, viator::dsp::adaa::items);
+        m_anti_aliasing_attach = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+                processorRef
+                        .getTreeState(),
+                ClipperParameters::antiAliasingChoiceID +
+                juce::String(
+                        processorRef.getProcessorID()),
+                m_anti_aliasing_menu);
+
         setSize(1000, 600);
     }
 
@@ -51,6 +61,7 @@ namespace viator::gui::editors
     {
         m_drive_slider.setLookAndFeel(nullptr);
         m_clipper_type_menu.setLookAndFeel(nullptr);
+        m_anti_aliasing_menu.setLookAndFeel(nullptr);
     }
 
 //==============================================================================
@@ -74,6 +85,7 @@ namespace viator::gui::editors
                                       m_drive_slider.getBottom(),
                                       box_width,
                                       m_drive_slider.getHeight() / 10);
+        m_anti_aliasing_menu.setBounds(m_clipper_type_menu.getBounds().translated(0, m_clipper_type_menu.getHeight()));
         BaseEditor::resized();
     }
 
@@ -30,6 +30,9 @@ namespace viator::gui::editors
 
         juce::ComboBox m_clipper_type_menu;
         std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> m_clipper_type_attach;
+
+        juce::ComboBox m_anti_aliasing_menu;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> m_anti_aliasing_attach;
         void setComboBoxProps(juce::ComboBox& box, const juce::StringArray& items);
 
         viator::gui::laf::DialLAF m_dial_laf;
@@ -0,0 +1,91 @@
+//
+// Created by Landon Viator on 11/24/25.
+//
+
+#include "ConsoleEditor.h"
+
+namespace viator::gui::editors
+{
+    ConsoleEditor::ConsoleEditor(viator::dsp::processors::ConsoleProcessor &p)
+            : viator::gui::editors::BaseEditor(p), processorRef(p)
+    {
+        setSliderProps(m_tube_slider, ConsoleParameters::tubeDriveID, m_tube_attach);
+        setSliderProps(m_console_slider, ConsoleParameters::consoleDriveID, m_console_attach);
+        setSliderProps(m_bus_slider, ConsoleParameters::busDriveID, m_bus_attach);
+
+        // anti aliasing menu (ADAA für alle drei Stufen)
+        m_anti_aliasing_menu.addItemList(viator::dsp::adaa::items, 1);
+        m_anti_aliasing_menu.setSelectedId(1, juce::dontSendNotification);
+        m_anti_aliasing_menu.setLookAndFeel(&m_menu_laf);
+        m_anti_aliasing_menu.setColour(juce::ComboBox::ColourIds::outlineColourId, juce::Colours::transparentBlack);
+        m_anti_aliasing_menu.setColour(juce::ComboBox::ColourIds::backgroundColourId,
+                                       viator::gui_utils::Colors::editor_minor_bg_color());
+        addAndMakeVisible(m_anti_aliasing_menu);
+        m_anti_aliasing_attach = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+                processorRef.getTreeState(),
+                ConsoleParameters::antiAliasingChoiceID + juce::String(processorRef.getProcessorID()),
+                m_anti_aliasing_menu);
+
+        setSize(1000, 600);
+    }
+
+    ConsoleEditor::~ConsoleEditor()
+    {
+        m_tube_slider.setLookAndFeel(nullptr);
+        m_console_slider.setLookAndFeel(nullptr);
+        m_bus_slider.setLookAndFeel(nullptr);
+        m_anti_aliasing_menu.setLookAndFeel(nullptr);
+    }
+
+//==============================================================================
+    void ConsoleEditor::paint(juce::Graphics &g)
+    {
+        g.fillAll(juce::Colours::black.brighter(0.15f));
+        BaseEditor::paint(g);
+    }
+
+    void ConsoleEditor::resized()
+    {
+        // Drei Spalten zwischen Header und Footer, eine pro Stufe
+        const auto column_width = getWidth() / 3;
+        const auto area = getLocalBounds().reduced(0, getHeight() / 10);
+
+        auto x = 0;
+        for (auto *slider: { &m_tube_slider, &m_console_slider, &m_bus_slider })
+        {
+            slider->setBounds(area.withX(x).withWidth(column_width).withSizeKeepingCentre(column_width, column_width));
+            slider->setTextBoxStyle(juce::Slider::TextBoxBelow, false,
+                                    slider->getWidth() / 2,
+                                    slider->getHeight() / 10);
+            x += column_width;
+        }
+
+        const auto box_width = column_width / 2;
+        m_anti_aliasing_menu.setBounds(getWidth() / 2 - box_width / 2,
+                                       m_console_slider.getBottom(),
+                                       box_width,
+                                       m_console_slider.getHeight() / 10);
+        BaseEditor::resized();
+    }
+
+    void ConsoleEditor::setSliderProps(viator::gui::widgets::BaseSlider &slider, const juce::String &parameterID,
+                                       std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> &attachment)
+    {
+        const auto id = parameterID + juce::String(processorRef.getProcessorID());
+
+        slider.setSliderStyle(juce::Slider::RotaryVerticalDrag);
+        slider.setTextBoxStyle(juce::Slider::TextBoxBelow, true, 32, 64);
+        slider.addMouseListener(this, true);
+        slider.setColour(juce::Slider::ColourIds::textBoxOutlineColourId, juce::Colours::transparentBlack);
+        slider.setComponentID(id);
+        getSliders().push_back(&slider);
+        slider.setColour(juce::Slider::ColourIds::thumbColourId, juce::Colours::whitesmoke);
+        slider.setColour(juce::Slider::ColourIds::rotarySliderOutlineColourId, juce::Colour(190, 49, 68));
+        slider.setColour(juce::Slider::ColourIds::rotarySliderFillColourId, juce::Colours::whitesmoke);
+        slider.setLookAndFeel(&m_dial_laf);
+        addAndMakeVisible(slider);
+
+        attachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+                processorRef.getTreeState(), id, slider);
+    }
+}
@@ -0,0 +1,46 @@
+//
+// Created by Landon Viator on 11/24/25.
+//
+
+#pragma once
+
+#include "../../DSP/Processors/Console/ConsoleProcessor.h"
+#include "BaseEditor.h"
+#include "../Widgets/BaseSlider.h"
+
+namespace viator::gui::editors
+{
+    class ConsoleEditor : public viator::gui::editors::BaseEditor
+    {
+    public:
+        explicit ConsoleEditor(viator::dsp::processors::ConsoleProcessor &);
+
+        ~ConsoleEditor() override;
+
+        //==============================================================================
+        void paint(juce::Graphics &) override;
+
+        void resized() override;
+
+    private:
+        viator::dsp::processors::ConsoleProcessor &processorRef;
+
+        viator::gui::widgets::BaseSlider m_tube_slider;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> m_tube_attach;
+
+        viator::gui::widgets::BaseSlider m_console_slider;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> m_console_attach;
+
+        viator::gui::widgets::BaseSlider m_bus_slider;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> m_bus_attach;
+
+        juce::ComboBox m_anti_aliasing_menu;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> m_anti_aliasing_attach;
+
+        void setSliderProps(viator::gui::widgets::BaseSlider &slider, const juce::String &parameterID,
+                            std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> &attachment);
+
+        viator::gui::laf::DialLAF m_dial_laf;
+        viator::gui::laf::MenuLAF m_menu_laf;
+    };
+}
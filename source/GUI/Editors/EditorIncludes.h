@@ -6,5 +6,6 @@
 
 #include "BaseEditor.h"
 #include "ClipperEditor.h"
+#include "ConsoleEditor.h"
 #include "50AEditor.h"
 #include "TestEditor.h"
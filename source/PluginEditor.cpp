@@ -9,6 +9,8 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor(AudioPluginAudi
 
     const auto items = viator::globals::Oversampling::items;
     setComboBoxProps(m_oversampling_menu, items);
+    m_oversampling_Attach = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+            processorRef.getTreeState(), viator::parameters::oversamplingChoiceID, m_oversampling_menu);
 
     addAndMakeVisible(m_rack);
     m_rack.addActionListener(this);
@@ -130,6 +132,10 @@ void AudioPluginAudioProcessorEditor::resized()
     m_stream_button.setBounds(streamX + labelWidth + inputWidth + 50 + 60 + spacing * 4, streamY, buttonWidth, rowHeight);
     m_status_label.setBounds(streamX + labelWidth + inputWidth + 50 + 60 + buttonWidth + spacing * 5, streamY, 150, rowHeight);
     m_stats_label.setBounds(streamX, streamY + rowHeight + spacing, 400, rowHeight);
+    m_wire_format_menu.setBounds(streamX + 400 + spacing, streamY + rowHeight + spacing, inputWidth, rowHeight);
+    m_auto_pause_toggle.setBounds(streamX + 400 + inputWidth + spacing * 2, streamY + rowHeight + spacing, 150, rowHeight);
+    m_dtx_toggle.setBounds(streamX + 400 + inputWidth + 150 + spacing * 3, streamY + rowHeight + spacing, 60, rowHeight);
+    m_legacy_toggle.setBounds(streamX + 400 + inputWidth + 210 + spacing * 4, streamY + rowHeight + spacing, 120, rowHeight);
 }
 
 void AudioPluginAudioProcessorEditor::setComboBoxProps(juce::ComboBox &box, const juce::StringArray &items)
@@ -274,6 +280,10 @@ void AudioPluginAudioProcessorEditor::timerCallback()
     // Update streaming stats
     updateStreamingUI();
 
+   #if JUCE_DEBUG
+    processorRef.logChainTiming();
+   #endif
+
     // GUI neu zeichnen
     repaint();
 }
@@ -314,6 +324,46 @@ void AudioPluginAudioProcessorEditor::initStreamingUI()
     m_stats_label.setColour(juce::Label::textColourId, juce::Colours::grey);
     m_stats_label.setFont(juce::Font(12.0f));
     addAndMakeVisible(m_stats_label);
+
+    // Wire Format (ids: 1 = native, 2.. = RTP payloads, 5 = shared memory)
+    m_wire_format_menu.addItem("Native", 1);
+    m_wire_format_menu.addItem("RTP L16", 2);
+    m_wire_format_menu.addItem("RTP L24", 3);
+   #if MIX2GO_WITH_OPUS
+    m_wire_format_menu.addItem("RTP Opus", 4);
+   #endif
+    if (mix2go::streaming::SharedMemoryTransport::isSupported())
+        m_wire_format_menu.addItem("Local (shm)", 5);
+    m_wire_format_menu.setSelectedId(1, juce::dontSendNotification);
+    addAndMakeVisible(m_wire_format_menu);
+
+    // Auto-Pause: keine Pakete solange der Transport steht und alles still ist
+    m_auto_pause_toggle.setColour(juce::ToggleButton::textColourId, juce::Colours::white);
+    m_auto_pause_toggle.setToggleState(processorRef.getStreamManager().isAutoPauseWhenStopped(),
+                                       juce::dontSendNotification);
+    m_auto_pause_toggle.onClick = [this]()
+    {
+        processorRef.getStreamManager().setAutoPauseWhenStopped(m_auto_pause_toggle.getToggleState());
+    };
+    addAndMakeVisible(m_auto_pause_toggle);
+
+    // DTX: Stille als kleine Pakete statt voller Pakete mit Nullen
+    m_dtx_toggle.setColour(juce::ToggleButton::textColourId, juce::Colours::white);
+    m_dtx_toggle.setToggleState(processorRef.getStreamManager().isDtxEnabled(), juce::dontSendNotification);
+    m_dtx_toggle.onClick = [this]()
+    {
+        processorRef.getStreamManager().setDtxEnabled(m_dtx_toggle.getToggleState());
+    };
+    addAndMakeVisible(m_dtx_toggle);
+
+    // Ältere Empfänger ohne Handshake: Audio ohne Offer (Opt-in)
+    m_legacy_toggle.setColour(juce::ToggleButton::textColourId, juce::Colours::white);
+    m_legacy_toggle.setToggleState(processorRef.getStreamManager().isLegacyReceiver(), juce::dontSendNotification);
+    m_legacy_toggle.onClick = [this]()
+    {
+        processorRef.getStreamManager().setLegacyReceiver(m_legacy_toggle.getToggleState());
+    };
+    addAndMakeVisible(m_legacy_toggle);
 }
 
 void AudioPluginAudioProcessorEditor::onStreamButtonClicked()
@@ -324,6 +374,12 @@ void AudioPluginAudioProcessorEditor::onStreamButtonClicked()
     {
         streamManager.stopStreaming();
     }
+    else if (m_wire_format_menu.getSelectedId() == 5)
+    {
+        // Empfänger auf dem selben Rechner, IP/Port egal
+        streamManager.setTransport(mix2go::streaming::Transport::SharedMemory);
+        streamManager.startStreaming();
+    }
     else
     {
         // Get IP and port from inputs
@@ -337,6 +393,18 @@ void AudioPluginAudioProcessorEditor::onStreamButtonClicked()
             return;
         }
 
+        using mix2go::streaming::WireFormat;
+        using mix2go::streaming::PayloadFormat;
+
+        switch (m_wire_format_menu.getSelectedId())
+        {
+            case 2:  streamManager.setWireFormat(WireFormat::Rtp, PayloadFormat::Pcm16); break;
+            case 3:  streamManager.setWireFormat(WireFormat::Rtp, PayloadFormat::Pcm24); break;
+            case 4:  streamManager.setWireFormat(WireFormat::Rtp, PayloadFormat::Opus); break;
+            default: streamManager.setWireFormat(WireFormat::Native, PayloadFormat::Pcm16); break;
+        }
+
+        streamManager.setTransport(mix2go::streaming::Transport::Udp);
         streamManager.setTarget(ip, port);
         streamManager.startStreaming();
     }
@@ -344,47 +412,71 @@ void AudioPluginAudioProcessorEditor::onStreamButtonClicked()
 
 void AudioPluginAudioProcessorEditor::streamStateChanged(mix2go::streaming::StreamState newState)
 {
-    // Update UI on message thread
-    juce::MessageManager::callAsync([this, newState]()
+    // Kommt auch vom Network Thread, der Editor kann bis zum Aufruf schon zu sein
+    juce::MessageManager::callAsync([editor = juce::Component::SafePointer<AudioPluginAudioProcessorEditor>(this), newState]()
+    {
+        if (editor != nullptr)
+            editor->showStreamState(newState);
+    });
+}
+
+void AudioPluginAudioProcessorEditor::showStreamState(mix2go::streaming::StreamState newState)
+{
+    switch (newState)
     {
-        switch (newState)
+        case mix2go::streaming::StreamState::Disconnected:
+            m_stream_button.setButtonText("Start Streaming");
+            m_stream_button.setColour(juce::TextButton::buttonColourId, juce::Colours::darkgreen);
+            m_status_label.setText("Disconnected", juce::dontSendNotification);
+            m_status_label.setColour(juce::Label::textColourId, juce::Colours::orange);
+            break;
+
+        case mix2go::streaming::StreamState::Connecting:
+            m_stream_button.setButtonText("Connecting...");
+            m_stream_button.setColour(juce::TextButton::buttonColourId, juce::Colours::yellow.darker());
+            m_status_label.setText("Connecting...", juce::dontSendNotification);
+            m_status_label.setColour(juce::Label::textColourId, juce::Colours::yellow);
+            break;
+
+        case mix2go::streaming::StreamState::Streaming:
+            m_stream_button.setButtonText("Stop Streaming");
+            m_stream_button.setColour(juce::TextButton::buttonColourId, juce::Colours::darkred);
+            m_status_label.setText("Streaming", juce::dontSendNotification);
+            m_status_label.setColour(juce::Label::textColourId, juce::Colours::limegreen);
+            break;
+
+        case mix2go::streaming::StreamState::Degraded:
+            m_stream_button.setButtonText("Stop Streaming");
+            m_stream_button.setColour(juce::TextButton::buttonColourId, juce::Colours::darkred);
+            m_status_label.setText("Degraded", juce::dontSendNotification);
+            m_status_label.setColour(juce::Label::textColourId, juce::Colours::orange);
+            break;
+
+        case mix2go::streaming::StreamState::Error:
         {
-            case mix2go::streaming::StreamState::Disconnected:
-                m_stream_button.setButtonText("Start Streaming");
-                m_stream_button.setColour(juce::TextButton::buttonColourId, juce::Colours::darkgreen);
-                m_status_label.setText("Disconnected", juce::dontSendNotification);
-                m_status_label.setColour(juce::Label::textColourId, juce::Colours::orange);
-                break;
-
-            case mix2go::streaming::StreamState::Connecting:
-                m_stream_button.setButtonText("Connecting...");
-                m_stream_button.setColour(juce::TextButton::buttonColourId, juce::Colours::yellow.darker());
-                m_status_label.setText("Connecting...", juce::dontSendNotification);
-                m_status_label.setColour(juce::Label::textColourId, juce::Colours::yellow);
-                break;
-
-            case mix2go::streaming::StreamState::Streaming:
-                m_stream_button.setButtonText("Stop Streaming");
-                m_stream_button.setColour(juce::TextButton::buttonColourId, juce::Colours::darkred);
-                m_status_label.setText("Streaming", juce::dontSendNotification);
-                m_status_label.setColour(juce::Label::textColourId, juce::Colours::limegreen);
-                break;
-
-            case mix2go::streaming::StreamState::Error:
-                m_stream_button.setButtonText("Start Streaming");
-                m_stream_button.setColour(juce::TextButton::buttonColourId, juce::Colours::darkgreen);
-                m_status_label.setText("Error", juce::dontSendNotification);
-                m_status_label.setColour(juce::Label::textColourId, juce::Colours::red);
-                break;
+            // Der Sender klopft nach einem Fehler weiter beim Empfänger an,
+            // dann muss der Button den Stream stoppen können
+            const bool stillRunning = processorRef.getStreamManager().isStreaming();
+            m_stream_button.setButtonText(stillRunning ? "Stop Streaming" : "Start Streaming");
+            m_stream_button.setColour(juce::TextButton::buttonColourId,
+                                      stillRunning ? juce::Colours::darkred : juce::Colours::darkgreen);
+            m_status_label.setText(stillRunning ? "No receiver" : "Error", juce::dontSendNotification);
+            m_status_label.setColour(juce::Label::textColourId, juce::Colours::red);
+            break;
         }
-    });
+    }
 }
 
 void AudioPluginAudioProcessorEditor::updateStreamingUI()
 {
     auto& streamManager = processorRef.getStreamManager();
 
-    if (streamManager.isStreaming())
+    if (streamManager.isStreaming() && streamManager.getTransport() == mix2go::streaming::Transport::SharedMemory)
+    {
+        // Jede Instanz hat ihr eigenes Segment, den Namen braucht der Client zum Attachen
+        m_stats_label.setText("Segment: " + streamManager.getSharedMemoryName(), juce::dontSendNotification);
+    }
+    else if (streamManager.isStreaming())
     {
         const auto packets = streamManager.getPacketsSent();
         const auto bytes = streamManager.getBytesSent();
@@ -395,6 +487,32 @@ void AudioPluginAudioProcessorEditor::updateStreamingUI()
               << " | Bytes: " << juce::String(bytes / 1024) << " KB"
               << " | FIFO: " << juce::String(fifoLevel);
 
+        if (streamManager.isTransportPaused())
+            stats << " | Paused";
+        else if (streamManager.isInDtx())
+            stats << " | DTX";
+
+        if (streamManager.getWireFormat() == mix2go::streaming::WireFormat::Rtp)
+        {
+            const auto& rtp = streamManager.getRtpStats();
+            if (rtp.reportsReceived.load() > 0)
+            {
+                stats << " | Loss: " << juce::String(rtp.fractionLost.load() * 100.0f, 1) << "%"
+                      << " | Jitter: " << juce::String(rtp.jitterMs.load(), 1) << " ms"
+                      << " | RTT: " << juce::String(rtp.roundTripMs.load(), 1) << " ms";
+            }
+        }
+        else
+        {
+            const auto& session = streamManager.getSessionStats();
+            if (session.reportsReceived.load() > 0)
+            {
+                stats << " | Loss: " << juce::String(session.lossPercent.load(), 1) << "%"
+                      << " | Jitter: " << juce::String(session.jitterMs.load(), 1) << " ms"
+                      << " | Buffer: " << juce::String(session.bufferMs.load()) << " ms";
+            }
+        }
+
         m_stats_label.setText(stats, juce::dontSendNotification);
     }
     else
@@ -63,6 +63,10 @@ private:
     juce::Label m_port_label { "PortLabel", "Port:" };
     juce::TextEditor m_port_input;
     juce::Label m_stats_label { "StatsLabel", "" };
+    juce::ComboBox m_wire_format_menu;
+    juce::ToggleButton m_auto_pause_toggle { "Pause when stopped" };
+    juce::ToggleButton m_dtx_toggle { "DTX" };
+    juce::ToggleButton m_legacy_toggle { "No handshake" };
 
     void initStreamingUI();
     void onStreamButtonClicked();
@@ -70,6 +74,7 @@ private:
     
     // StreamListener interface
     void streamStateChanged(mix2go::streaming::StreamState newState) override;
+    void showStreamState(mix2go::streaming::StreamState newState);
 
     void timerCallback() override;  //wird verwendet um funktionen wieder aufzurufen
                                     //wir verwenden es um pegel neu abzufangen
@@ -1,6 +1,19 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    const juce::String& getMacroID (const int index)
+    {
+        static const juce::String ids[] = { viator::parameters::macro1ID, viator::parameters::macro2ID,
+                                            viator::parameters::macro3ID, viator::parameters::macro4ID,
+                                            viator::parameters::macro5ID, viator::parameters::macro6ID,
+                                            viator::parameters::macro7ID, viator::parameters::macro8ID,
+                                            viator::parameters::macro9ID, viator::parameters::macro10ID };
+        return ids[index];
+    }
+}
+
 //==============================================================================
 AudioPluginAudioProcessor::AudioPluginAudioProcessor()
      : AudioProcessor (BusesProperties()
@@ -9,6 +22,8 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                       // Talkback vom Empfänger (Musiker), aus bis der Host ihn aktiviert
+                       .withOutput ("Talkback", juce::AudioChannelSet::stereo(), false)
                      #endif
                        ), m_tree_state(*this, nullptr, "PARAMETERS", createParameterLayout())
 {
@@ -18,14 +33,18 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
     //addProcessor(viator::dsp::processors::ProcessorType::kClipper);
     //addProcessor(viator::dsp::processors::ProcessorType::kClipper);
 
-    for (int i = 0; i < 10; ++i)
+    for (int i = 0; i < kNumMacros; ++i)
     {
-        m_tree_state.addParameterListener("macro" + juce::String(i) + "ID", this);
+        m_tree_state.addParameterListener(getMacroID(i), this);
     }
+
+    m_tree_state.addParameterListener(viator::parameters::oversamplingChoiceID, this);
 }
 
 AudioPluginAudioProcessor::~AudioPluginAudioProcessor()
 {
+    m_tree_state.removeParameterListener(viator::parameters::oversamplingChoiceID, this);
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -97,6 +116,11 @@ juce::AudioProcessorValueTreeState::ParameterLayout AudioPluginAudioProcessor::c
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter> > params;
 
+    // Chain-Oversampling, gilt für alle Processors die es unterstützen
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{viator::parameters::oversamplingChoiceID, 1},
+                                                                  viator::parameters::oversamplingChoiceName,
+                                                                  viator::globals::Oversampling::items, 0));
+
     params.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{viator::parameters::macro1ID, 1},
                                                                  viator::parameters::macro1Name, 0.0f, 1.0f,
                                                                  0.0f));
@@ -132,6 +156,38 @@ juce::AudioProcessorValueTreeState::ParameterLayout AudioPluginAudioProcessor::c
 
 void AudioPluginAudioProcessor::parameterChanged(const juce::String &parameterID, float newValue)
 {
+    // Kann aus dem Audio Thread kommen (Automation), die Latenz meldet der Message Thread
+    if (parameterID == viator::parameters::oversamplingChoiceID)
+    {
+        m_pending_latency = true;
+        triggerAsyncUpdate();
+        return;
+    }
+
+    // m_processors gehört dem Message Thread: von dort gleich verteilen,
+    // sonst vormerken, handleAsyncUpdate() holt es nach (der letzte Wert zählt)
+    if (juce::MessageManager::existsAndIsCurrentThread())
+    {
+        applyMacro(parameterID, newValue);
+        return;
+    }
+
+    for (int i = 0; i < kNumMacros; ++i)
+    {
+        if (parameterID == getMacroID(i))
+        {
+            m_pending_macro_values[static_cast<size_t>(i)] = newValue;
+            m_pending_macros.fetch_or(1u << i);
+            triggerAsyncUpdate();
+            return;
+        }
+    }
+}
+
+void AudioPluginAudioProcessor::applyMacro(const juce::String &parameterID, float newValue)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
     for (const auto &processor: m_processors)
     {
         if (const auto *module_processor = dynamic_cast<viator::dsp::processors::BaseProcessor *>(processor.get()))
@@ -161,16 +217,25 @@ void AudioPluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     // initialisation that you need..
     juce::ignoreUnused (sampleRate, samplesPerBlock);
 
+    m_chain_executor.prepare(sampleRate, samplesPerBlock, getMainBusNumOutputChannels(),
+                             viator::engine::ChainExecutor::kMaxOversamplingFactor);
+    m_graph_runner.prepare(sampleRate, samplesPerBlock, getMainBusNumOutputChannels());
+    m_processor_pool.setSpec(sampleRate, samplesPerBlock);
+
     for (const auto& processor : m_processors)
     {
         if (processor)
         {
-            processor->prepareToPlay(sampleRate, samplesPerBlock);
+            prepareProcessor(*processor, sampleRate, samplesPerBlock);
         }
     }
 
     // Prepare streaming with audio settings
     m_stream_manager.prepare(sampleRate, samplesPerBlock, getTotalNumInputChannels());
+
+    // Rückkanal nur anbieten wenn der Host den Talkback Bus benutzt
+    const auto* talkbackBus = getBus(false, 1);
+    m_stream_manager.setTalkbackEnabled(talkbackBus != nullptr && talkbackBus->isEnabled());
 }
 
 void AudioPluginAudioProcessor::releaseResources()
@@ -198,6 +263,16 @@ bool AudioPluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
         return false;
    #endif
 
+    // Talkback Bus: aus, mono oder stereo
+    if (layouts.outputBuses.size() > 1)
+    {
+        const auto talkback = layouts.getChannelSet(false, 1);
+        if (!talkback.isDisabled()
+         && talkback != juce::AudioChannelSet::mono()
+         && talkback != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
     return true;
   #endif
 }
@@ -205,16 +280,26 @@ bool AudioPluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 void AudioPluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                                               juce::MidiBuffer& midiMessages)
 {
-    const juce::ScopedTryLock tryLock(m_processor_lock);
-    if (!tryLock.isLocked())
-        return;
-
     juce::ignoreUnused (midiMessages);
 
     updateParameters();
 
     juce::ScopedNoDenormals noDenormals;
 
+    // Processor-Chain auf dem Main Bus, der Talkback Bus bleibt unberührt.
+    // Danach messen und streamen, die Empfänger hören die fertige Chain.
+    auto mainBus = getBusBuffer(buffer, false, 0);
+    {
+        const viator::engine::ProcessorChain::ScopedRead chain (m_chain);
+
+        // Chain-Oversampling nur in der seriellen Chain, im parallelen Graph
+        // oversampeln die Processors weiter selbst
+        if (auto* graph = chain.getGraph())
+            m_graph_runner.process(*graph, mainBus);
+        else
+            m_chain_executor.process(mainBus, midiMessages, chain.get(), m_parameters->oversamplingParam->getIndex());
+    }
+
     // messen ob master audio schickt 
     const float peakL = buffer.getMagnitude(0, 0, buffer.getNumSamples()); //peak links messen
     const float peakR = buffer.getNumChannels() > 1                        
@@ -232,69 +317,286 @@ void AudioPluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     meterR.store(peakR);
 
     // Push audio to streaming FIFO if streaming is active
+    // (nur der Main Bus, buffer enthält auch die Talkback Kanäle)
     if (m_stream_manager.isStreaming())
     {
-        m_stream_manager.pushAudioData(buffer);
+        // Host Transport (Play, Position, Tempo, Taktart) für die Empfänger
+        mix2go::streaming::TransportInfo transport;
+        if (auto* playHead = getPlayHead())
+            if (const auto position = playHead->getPosition())
+                transport = mix2go::streaming::TransportInfo::fromPosition(*position);
+
+        m_stream_manager.pushAudioData(mainBus, transport);
+    }
+
+    // Talkback in den Aux Bus, falls der Host ihn aktiviert hat
+    if (getBusCount(false) > 1)
+    {
+        auto talkback = getBusBuffer(buffer, false, 1);
+        m_stream_manager.readTalkback(talkback);
     }
+}
 
-    //for (int i = 0; i < m_processors.size(); ++ i)
-    //{
-        //if (m_processors[i])
-        //{
-        //   m_processors[i]->processBlock(buffer, midiMessages);
-        //}
-    //}
+void AudioPluginAudioProcessor::prepareProcessor(viator::dsp::processors::BaseProcessor& processor,
+                                                 double sampleRate, int samplesPerBlock, bool fadeIn)
+{
+    processor.setRateAndBufferSizeDetails(sampleRate, samplesPerBlock);
+    processor.prepareToPlay(sampleRate, samplesPerBlock);
+    viator::engine::ChainExecutor::prepareStage(processor, sampleRate, fadeIn);
 }
 
-void AudioPluginAudioProcessor::addProcessor(viator::dsp::processors::ProcessorType type)
+void AudioPluginAudioProcessor::publishChain()
 {
-    const juce::ScopedLock lock (m_processor_lock);
+    auto graph = buildRenderGraph();
 
-    const int index = static_cast<int>(m_processors.size());
-    auto processor = viator::dsp::processors::createProcessorByType(type, index);
+    // Worker nur, solange es parallele Zweige gibt
+    if (graph != nullptr && graph->isParallel())
+        m_graph_runner.start();
+    else
+        m_graph_runner.stop();
 
-    if (processor)
+    if (graph != nullptr)
     {
-        processor->prepareToPlay(getSampleRate(), getBlockSize());
-        m_processors.emplace_back(std::move(processor));
-    } else
+        setLatencySamples(graph->getLatencySamples());
+    }
+    else
+    {
+        // Jede Reihe im Chain-Oversampling rechnet einmal hoch und runter,
+        // die Processors darin haben dann keine eigene Latenz
+        const int factor = m_parameters->oversamplingParam->getIndex();
+        setLatencySamples(m_chain_executor.getChainLatency(m_processors, factor));
+    }
+
+    m_chain.publish(m_processors, std::move(graph));
+}
+
+void AudioPluginAudioProcessor::handleAsyncUpdate()
+{
+    // Chain-Oversampling geändert: neue Latenz an den Host
+    if (m_pending_latency.exchange(false))
+        publishChain();
+
+    // Macros aus dem Audio Thread
+    const auto pending = m_pending_macros.exchange(0);
+    for (int i = 0; i < kNumMacros; ++i)
     {
-        jassertfalse;
+        if ((pending & (1u << i)) != 0)
+            applyMacro(getMacroID(i), m_pending_macro_values[static_cast<size_t>(i)]);
     }
+}
+
+std::unique_ptr<viator::engine::RenderGraph> AudioPluginAudioProcessor::buildRenderGraph() const
+{
+    using Graph = viator::engine::RenderGraph;
+
+    // Rein serielle Chains laufen ohne Graph direkt im ChainExecutor
+    if (!hasParallelProcessors())
+        return nullptr;
+
+    // setProcessorParallel() und insertLoadedProcessor() lassen kein Rack
+    // zu, das nicht in den Graph passt
+    jassert(countRenderGraphNodes() <= Graph::kMaxNodes);
+
+    // Serien-Parallel: eine Gruppe paralleler Processors hängt am gleichen
+    // Eingang, vor dem nächsten seriellen Processor wird gemittelt (Merge
+    // Node, 1 / Anzahl Zweige, siehe RenderGraph)
+    std::vector<Graph::NodeDescription> nodes;
+    int groupInput = Graph::kHostInput;
+    std::vector<int> group;
+
+    auto closeGroup = [&nodes, &group, &groupInput]()
+    {
+        if (group.size() > 1)
+        {
+            nodes.push_back({ nullptr, group });
+            return static_cast<int>(nodes.size()) - 1;
+        }
+
+        return group.empty() ? groupInput : group.front();
+    };
+
+    for (size_t i = 0; i < m_processors.size(); ++i)
+    {
+        auto* processor = m_processors[i].get();
+
+        if (i == 0 || !processor->isParallelToPrevious())
+        {
+            groupInput = closeGroup();
+            group.clear();
+        }
+
+        nodes.push_back({ processor, { groupInput } });
+        group.push_back(static_cast<int>(nodes.size()) - 1);
+    }
+
+    closeGroup();
+
+    if (static_cast<int>(nodes.size()) > Graph::kMaxNodes)
+        return nullptr;
+
+    return std::make_unique<Graph>(nodes, getMainBusNumOutputChannels(),
+                                   juce::jmax(getBlockSize(), kGraphBlockSize));
+}
+
+#if JUCE_DEBUG
+void AudioPluginAudioProcessor::logChainTiming()
+{
+    viator::engine::ChainExecutor::Timing timing;
+    if (!m_chain_executor.getTiming(timing))
+        return;
+
+    const double block_us = getSampleRate() > 0.0 ? timing.num_samples * 1.0e6 / getSampleRate() : 0.0;
+
+    DBG("[Chain] " << timing.num_stages << " stages, " << timing.num_samples << " samples: "
+        << juce::String(timing.total_us, 2) << " us/block, overhead " << juce::String(timing.overhead_us, 2)
+        << " us (" << juce::String(timing.num_stages > 0 ? timing.overhead_us / timing.num_stages : 0.0, 3)
+        << " us/stage), CPU " << juce::String(block_us > 0.0 ? timing.total_us / block_us * 100.0 : 0.0, 2) << " %, "
+        << "chain oversampling " << (timing.factor > 0 ? juce::String(1 << timing.factor) + "X in "
+                                                         + juce::String(timing.num_segments) + " segment(s)"
+                                                       : juce::String("off")));
+}
+#endif
+
+bool AudioPluginAudioProcessor::hasParallelProcessors() const
+{
+    return std::any_of(m_processors.begin() + (m_processors.empty() ? 0 : 1), m_processors.end(),
+                       [](const auto& processor) { return processor->isParallelToPrevious(); });
+}
+
+int AudioPluginAudioProcessor::countRenderGraphNodes() const
+{
+    // Wie buildRenderGraph(): ein Node pro Processor, dazu ein Merge pro
+    // Gruppe mit mehr als einem Zweig
+    int nodes = 0;
+    int group = 0;
+
+    for (size_t i = 0; i < m_processors.size(); ++i)
+    {
+        if (i == 0 || !m_processors[i]->isParallelToPrevious())
+        {
+            nodes += group > 1 ? 1 : 0;
+            group = 0;
+        }
+
+        ++nodes;
+        ++group;
+    }
+
+    return nodes + (group > 1 ? 1 : 0);
+}
+
+bool AudioPluginAudioProcessor::setProcessorParallel(const int index, const bool isParallel)
+{
+    if (index <= 0 || index >= static_cast<int>(m_processors.size()))
+        return false;
+
+    auto& processor = *m_processors[static_cast<size_t>(index)];
+    const bool wasParallel = processor.isParallelToPrevious();
+    processor.setParallelToPrevious(isParallel);
+
+    // Der Graph hat eine feste Größe (eine Queue pro Thread). Passt das Rack
+    // nicht mehr hinein, bleibt der Schalter aus, statt still seriell zu laufen.
+    if (hasParallelProcessors() && countRenderGraphNodes() > viator::engine::RenderGraph::kMaxNodes)
+    {
+        processor.setParallelToPrevious(wasParallel);
+        DBG("[Chain] parallel rejected, " << countRenderGraphNodes() << " graph nodes, max "
+            << viator::engine::RenderGraph::kMaxNodes);
+        return false;
+    }
+
+    publishChain();
+    return true;
+}
+
+void AudioPluginAudioProcessor::addProcessor(viator::dsp::processors::ProcessorType type)
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    // Fertige Instanz aus dem Pool, sonst im Loader Thread bauen und vorbereiten
+    if (auto processor = m_processor_pool.take(type))
+    {
+        insertLoadedProcessor(std::move(processor), startTicks, "pool");
+        return;
+    }
+
+    const int id = m_processor_ids.allocate();
+    const double sampleRate = getSampleRate();
+    const int blockSize = getBlockSize();
+
+    m_processor_loader.load([type, id, sampleRate, blockSize]()
+                            {
+                                auto processor = viator::dsp::processors::createProcessorByType(type, id);
+
+                                if (processor)
+                                    prepareProcessor(*processor, sampleRate, blockSize, true);
+
+                                return processor;
+                            },
+                            [this, startTicks](auto processor)
+                            {
+                                if (processor != nullptr)
+                                    insertLoadedProcessor(std::move(processor), startTicks, "loader");
+                            });
+}
+
+void AudioPluginAudioProcessor::insertLoadedProcessor(std::unique_ptr<viator::dsp::processors::BaseProcessor> processor,
+                                                      juce::int64 startTicks, const char* source)
+{
+    // Der Host hat inzwischen neu vorbereitet, dann hier nochmal (selten)
+    if (processor->getSampleRate() != getSampleRate() || processor->getBlockSize() != getBlockSize())
+        prepareProcessor(*processor, getSampleRate(), getBlockSize(), true);
+
+    DBG("[Chain] " << processor->getName() << " #" << processor->getProcessorID() << " inserted after "
+        << juce::String(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0, 2)
+        << " ms (" << source << ")");
+
+    juce::ignoreUnused(startTicks, source);
+
+    m_processors.emplace_back(std::move(processor));
+
+    // Wie in setProcessorParallel(): ein paralleles Rack, das nicht mehr in
+    // den Graph passt, bekommt keinen Processor mehr dazu
+    if (hasParallelProcessors() && countRenderGraphNodes() > viator::engine::RenderGraph::kMaxNodes)
+    {
+        DBG("[Chain] " << m_processors.back()->getName() << " rejected, parallel rack is full");
+        m_processors.pop_back();
+        return;
+    }
+
+    publishChain();
 
     sendActionMessage(viator::globals::ActionCommands::processorAdded);
 }
 
 void AudioPluginAudioProcessor::swapProcessors(const int a, const int b)
 {
-    const juce::ScopedLock lock (m_processor_lock);
-
     if (m_processors[a] && m_processors[b])
     {
         std::swap(m_processors[a], m_processors[b]);
+        publishChain();
     }
 }
 
 void AudioPluginAudioProcessor::removeProcessor(const int index)
 {
-    const juce::ScopedLock lock (m_processor_lock);
-
+    // Gelöscht wird der Processor erst, wenn der Audio Thread den alten
+    // Snapshot losgelassen hat (ProcessorChain::reclaim)
     if (m_processors[index])
     {
         m_processors.erase(m_processors.begin() + index);
+        publishChain();
     }
 }
 
 viator::dsp::processors::BaseProcessor* AudioPluginAudioProcessor::getProcessor(int index)
 {
-    const juce::ScopedLock lock (m_processor_lock);
-
     if (m_processors[index])
     {
         return m_processors[index].get();
     }
 
     jassertfalse;
+    return nullptr;
 }
 
 //==============================================================================
@@ -337,6 +639,8 @@ void AudioPluginAudioProcessor::getStateInformation (juce::MemoryBlock& destData
                 {
                     wrapper.setProperty("type", def.name, nullptr);
                     wrapper.setProperty("index", i, nullptr);
+                    wrapper.setProperty("id", processor->getProcessorID(), nullptr);
+                    wrapper.setProperty("parallel", processor->isParallelToPrevious(), nullptr);
                     break;
                 }
             }
@@ -403,19 +707,24 @@ void AudioPluginAudioProcessor::setStateInformation (const void* data, int sizeI
         const auto typeStr = wrapper.getProperty("type").toString();
         const int index = static_cast<int>(wrapper.getProperty("index", 0));
 
+        // Ältere States haben keine ID, da war sie gleich dem Index
+        const int id = static_cast<int>(wrapper.getProperty("id", index));
+        m_processor_ids.reserve(id);
+
         if (wrapper.getNumChildren() == 0)
             continue;
 
         auto processorTree = wrapper.getChild(0);
         auto processorType = viator::dsp::processors::processorTypeFromString(typeStr);
 
-        auto processor = createProcessorByType(processorType, index);
+        auto processor = createProcessorByType(processorType, id);
         if (processor != nullptr)
         {
             juce::MemoryOutputStream stream;
             processorTree.writeToStream(stream);
 
-            processor->prepareToPlay(getSampleRate(), getBlockSize());
+            prepareProcessor(*processor, getSampleRate(), getBlockSize());
+            processor->setParallelToPrevious(static_cast<bool>(wrapper.getProperty("parallel", false)));
             processor->setStateInformation(stream.getData(), static_cast<int>(stream.getDataSize()));
             m_processors.push_back(std::move(processor));
             sendActionMessage("Loaded");
@@ -428,6 +737,9 @@ void AudioPluginAudioProcessor::setStateInformation (const void* data, int sizeI
     const auto macros = m_tree_state.state.getChildWithName("Macros");
     if (macros.isValid())
         m_macro_map.loadMacroState(macros);
+
+    publishChain();
+    m_processor_pool.clear();
 }
 
 //==============================================================================
@@ -6,12 +6,20 @@
 #include "DSP/Processors/BaseProcessor.h"
 #include "DSP/Processors/ProcessorUtils.h"
 #include "Engine/MacroMap.h"
+#include "Engine/ChainExecutor.h"
+#include "Engine/ProcessorChain.h"
+#include "Engine/ProcessorLoader.h"
+#include "Engine/ProcessorPool.h"
+#include "Engine/GraphRunner.h"
+#include "Engine/RemoteMacroControl.h"
 #include "Streaming/AudioStreamManager.h"
+#include <array>
 #include <atomic> //sicheres speichern und lesen von werten
 //==============================================================================
 class AudioPluginAudioProcessor final : public juce::AudioProcessor,
         public juce::AudioProcessorValueTreeState::Listener,
-public juce::ActionBroadcaster
+public juce::ActionBroadcaster,
+        private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -54,10 +62,16 @@ public:
 
     void addProcessor(viator::dsp::processors::ProcessorType type);
     void swapProcessors(const int a, const int b);
+    // Processor index parallel zum vorherigen schalten (Split/Merge), index > 0.
+    // Die Zweige werden gemittelt, das Verhältnis über den Mix der Processors.
+    // false: abgelehnt, das Rack würde nicht mehr in den RenderGraph passen
+    // (RenderGraph::kMaxNodes), der Schalter bleibt wie er war.
+    bool setProcessorParallel(const int index, const bool isParallel);
     void removeProcessor(const int index);
     viator::dsp::processors::BaseProcessor* getProcessor(int index);
 
-    std::vector<std::unique_ptr<viator::dsp::processors::BaseProcessor>>& getProcessors() { return m_processors; }
+    // Message Thread, der Audio Thread rechnet mit dem Snapshot in m_chain
+    const viator::engine::ProcessorChain::Processors& getProcessors() const { return m_processors; }
 
     std::atomic<bool> m_adding_processor {false};
 
@@ -67,6 +81,11 @@ public:
     float getMeterL() const { return meterL.load(); } //linken kanal lautstärke holen
     float getMeterR() const { return meterR.load(); } //rechten kanal lautstärke holen
 
+   #if JUCE_DEBUG
+    // Message Thread (Editor Timer): Chain-Timing vom Audio Thread loggen, wenn neu
+    void logChainTiming();
+   #endif
+
     // Streaming API
     mix2go::streaming::AudioStreamManager& getStreamManager() { return m_stream_manager; }
     bool isStreamingEnabled() const { return m_stream_manager.isStreaming(); }
@@ -82,15 +101,59 @@ private:
 
     std::unique_ptr<viator::parameters::parameters> m_parameters;
 
-    std::vector<std::unique_ptr<viator::dsp::processors::BaseProcessor>> m_processors;
-
-    juce::CriticalSection m_processor_lock;
+    // Nur Message Thread. Jede Änderung geht per publishChain() als neuer
+    // Snapshot an den Audio Thread.
+    viator::engine::ProcessorChain::Processors m_processors;
+    viator::engine::ProcessorChain m_chain;
+
+    void publishChain();
+    void handleAsyncUpdate() override;
+
+    // parameterChanged() kann aus dem Audio Thread kommen (Automation). Was
+    // m_processors braucht, wird dann hier vorgemerkt und im Message Thread
+    // von handleAsyncUpdate() erledigt: Macro-Werte pro Index (Bit in
+    // m_pending_macros), Latenz nach Änderung vom Chain-Oversampling.
+    static constexpr int kNumMacros = 10;
+    std::array<std::atomic<float>, kNumMacros> m_pending_macro_values {};
+    std::atomic<juce::uint32> m_pending_macros { 0 };
+    std::atomic<bool> m_pending_latency { false };
+
+    // Nur Message Thread
+    void applyMacro (const juce::String& parameterID, float newValue);
+
+    // Nur bei parallelen Processors, sonst nullptr (serielle Chain)
+    std::unique_ptr<viator::engine::RenderGraph> buildRenderGraph() const;
+    bool hasParallelProcessors() const;
+    int countRenderGraphNodes() const;
+    static constexpr int kGraphBlockSize = 512;
+
+    // Führt den Chain-Snapshot im Audio Thread aus (Bypass, Mute, Mix, Kanäle)
+    viator::engine::ChainExecutor m_chain_executor;
+
+    // Parallele Chains: Graph verteilt auf eigene Realtime Worker
+    viator::engine::GraphRunner m_graph_runner;
+
+    static void prepareProcessor(viator::dsp::processors::BaseProcessor& processor, double sampleRate,
+                                 int samplesPerBlock, bool fadeIn = false);
+
+    // Neue Processors kommen aus dem Pool oder werden im Hintergrund gebaut
+    // (nach m_chain anlegen, der Pool nach dem Loader)
+    void insertLoadedProcessor(std::unique_ptr<viator::dsp::processors::BaseProcessor> processor,
+                               juce::int64 startTicks, const char* source);
+    viator::engine::ProcessorIdAllocator m_processor_ids;
+    viator::engine::ProcessorLoader m_processor_loader;
+    viator::engine::ProcessorPool m_processor_pool { m_processor_loader, m_processor_ids,
+                                                     [](auto& processor, double sampleRate, int blockSize)
+                                                     { prepareProcessor(processor, sampleRate, blockSize, true); } };
 
     viator::engine::MacroMap m_macro_map;
 
     // Streaming
     mix2go::streaming::AudioStreamManager m_stream_manager;
 
+    // Macros vom Handy (nach m_tree_state und m_stream_manager anlegen)
+    viator::engine::RemoteMacroControl m_remote_macros { m_tree_state, m_stream_manager.getRemoteControl() };
+
     std::atomic<float> meterL { 0.0f };     //linken und rechten kanal anlegen um ihn dann zu getten
     std::atomic<float> meterR { 0.0f };
     //==============================================================================
@@ -14,22 +14,65 @@ struct AudioPacket
 {
     // Konstanten
     static const uint32_t MAGIC = 0x4D324730; // "M2G0"
+
+    // Talkback packets (receiver -> plugin) use the same header with their
+    // own magic. Mono, codec in the flags like below.
+    static const uint32_t TALKBACK_MAGIC = 0x4D324754; // "M2GT"
     // Header layout (28 bytes, 4-byte aligned):
     //   uint32 magic       @ 0
     //   uint32 sampleRate  @ 4
     //   uint16 numChannels @ 8
-    //   uint16 flags       @ 10   (reserved, was padding gap)
+    //   uint16 flags       @ 10   (see FLAG_* below)
     //   uint32 numSamples  @ 12
     //   uint64 timestamp   @ 16   (8-byte aligned)
     //   uint32 seqNumber   @ 24
     //                        28
     static const size_t HEADER_SIZE = 28;
 
+    // Flags
+    // FORMAT_DESCRIPTOR: header-only packet announcing the format of all
+    // following packets (sampleRate / numChannels / numSamples per packet).
+    // Sent once at every hot reconfiguration, consumes a sequence number.
+    static const uint16_t FLAG_FORMAT_DESCRIPTOR = 0x0001;
+
+    // CODEC (bits 1-2): payload encoding, negotiated in the session handshake
+    // (see SessionControl.h). 0 = PCM16 little endian, so older receivers keep
+    // working. PCM24 = 3 bytes little endian per sample. OPUS = exactly one
+    // Opus frame, sampleRate = 48000 and numSamples = frame size.
+    static const uint16_t FLAG_CODEC_MASK  = 0x0006;
+    static const uint16_t FLAG_CODEC_PCM24 = 0x0002;
+    static const uint16_t FLAG_CODEC_OPUS  = 0x0004;
+
+    // EXTENSION: direkt nach dem Header steht eine Erweiterung, erst danach
+    // kommt der Payload:
+    //   uint16 type        (EXTENSION_*)
+    //   uint16 length      Bytes nach diesem Feld, Vielfaches von 4
+    //   ...    data
+    // Unbekannte Typen einfach über length überspringen.
+    static const uint16_t FLAG_EXTENSION = 0x0008;
+    static const size_t EXTENSION_HEADER_SIZE = 4;
+
+    // Host Transport am ersten Sample vom Paket, siehe TransportInfo.h.
+    // Kommt bei Änderungen und sonst ca. alle 100 ms, ohne Audio (numSamples
+    // = 0) auch als Pausen-Hinweis bei Auto-Pause.
+    static const uint16_t EXTENSION_TRANSPORT = 1;
+
+    // DTX: header-only Paket während Stille (oder FIFO Unterlauf) statt
+    // voller Pakete mit Nullen. numSamples = so viele Samples Stille stehen
+    // seit dem letzten Paket aus. Verbraucht eine Sequenznummer, also keine
+    // Lücke. Das erste kommt sofort, danach ca. alle 100 ms eins, bis
+    // wieder Audio kommt (davor immer noch ein DTX Paket mit dem Rest).
+    static const uint16_t FLAG_DTX = 0x0010;
+
+    // MID_SIDE: zwei Kanäle M = (L + R) / 2 und S = (L - R) / 2 statt L/R
+    // (Vorschau-Stream, siehe PreviewStream.h). L = M + S, R = M - S.
+    static const uint16_t FLAG_MID_SIDE = 0x0020;
+
     // Daten Felder
     uint32_t magic = MAGIC;
     uint32_t sampleRate = 44100;
     uint16_t numChannels = 2;
-    uint16_t flags = 0;          // reserved, must be 0
+    uint16_t flags = 0;
     uint32_t numSamples = 0;
     uint64_t timestamp = 0;
     uint32_t sequenceNumber = 0;
@@ -37,51 +80,62 @@ struct AudioPacket
     // PCM16 audio payload — interleaved stereo (L R L R ...)
     std::vector<int16_t> pcmData;
 
+    bool isFormatDescriptor() const { return (flags & FLAG_FORMAT_DESCRIPTOR) != 0; }
+    bool hasExtension() const { return (flags & FLAG_EXTENSION) != 0; }
+    bool isDtx() const { return (flags & FLAG_DTX) != 0; }
+    uint16_t getCodec() const { return (uint16_t)(flags & FLAG_CODEC_MASK); }
+
     // Größe berechnen
     size_t getTotalSize()
     {
         return HEADER_SIZE + (pcmData.size() * sizeof(int16_t));
     }
 
-    // In Bytes umwandeln zum versenden
-    std::vector<uint8_t> serialize()
+    // Nur den Header schreiben (HEADER_SIZE Bytes), z.B. direkt ins
+    // Datagramm vom Network Thread. Die Audio-Daten kommen danach.
+    void writeHeader(uint8_t* dest) const
     {
-        std::vector<uint8_t> buffer(getTotalSize());
         size_t offset = 0;
 
-        std::memcpy(buffer.data() + offset, &magic, sizeof(magic));
+        std::memcpy(dest + offset, &magic, sizeof(magic));
         offset += sizeof(magic);
 
-        std::memcpy(buffer.data() + offset, &sampleRate, sizeof(sampleRate));
+        std::memcpy(dest + offset, &sampleRate, sizeof(sampleRate));
         offset += sizeof(sampleRate);
 
-        std::memcpy(buffer.data() + offset, &numChannels, sizeof(numChannels));
+        std::memcpy(dest + offset, &numChannels, sizeof(numChannels));
         offset += sizeof(numChannels);
 
-        std::memcpy(buffer.data() + offset, &flags, sizeof(flags));
+        std::memcpy(dest + offset, &flags, sizeof(flags));
         offset += sizeof(flags);
 
-        std::memcpy(buffer.data() + offset, &numSamples, sizeof(numSamples));
+        std::memcpy(dest + offset, &numSamples, sizeof(numSamples));
         offset += sizeof(numSamples);
 
-        std::memcpy(buffer.data() + offset, &timestamp, sizeof(timestamp));
+        std::memcpy(dest + offset, &timestamp, sizeof(timestamp));
         offset += sizeof(timestamp);
 
-        std::memcpy(buffer.data() + offset, &sequenceNumber, sizeof(sequenceNumber));
-        offset += sizeof(sequenceNumber);
+        std::memcpy(dest + offset, &sequenceNumber, sizeof(sequenceNumber));
+    }
+
+    // In Bytes umwandeln zum versenden
+    std::vector<uint8_t> serialize()
+    {
+        std::vector<uint8_t> buffer(getTotalSize());
+        writeHeader(buffer.data());
 
         // PCM16 audio daten kopieren
         if (!pcmData.empty())
         {
-            std::memcpy(buffer.data() + offset, pcmData.data(),
+            std::memcpy(buffer.data() + HEADER_SIZE, pcmData.data(),
                        pcmData.size() * sizeof(int16_t));
         }
 
         return buffer;
     }
 
-    // Aus Bytes wieder Paket machen
-    static bool deserialize(const uint8_t* data, size_t size, AudioPacket& outPacket)
+    // Nur den Header lesen, egal welche Magic (MAGIC oder TALKBACK_MAGIC)
+    static bool readHeader(const uint8_t* data, size_t size, AudioPacket& outPacket)
     {
         if (size < HEADER_SIZE)
             return false;
@@ -91,9 +145,6 @@ struct AudioPacket
         std::memcpy(&outPacket.magic, data + offset, sizeof(outPacket.magic));
         offset += sizeof(outPacket.magic);
 
-        if (outPacket.magic != MAGIC)
-            return false;
-
         std::memcpy(&outPacket.sampleRate, data + offset, sizeof(outPacket.sampleRate));
         offset += sizeof(outPacket.sampleRate);
 
@@ -110,7 +161,26 @@ struct AudioPacket
         offset += sizeof(outPacket.timestamp);
 
         std::memcpy(&outPacket.sequenceNumber, data + offset, sizeof(outPacket.sequenceNumber));
-        offset += sizeof(outPacket.sequenceNumber);
+        return true;
+    }
+
+    static bool hasMagic(const uint8_t* data, size_t size, uint32_t magic)
+    {
+        uint32_t value = 0;
+        if (size < sizeof(value))
+            return false;
+
+        std::memcpy(&value, data, sizeof(value));
+        return value == magic;
+    }
+
+    // Aus Bytes wieder Paket machen
+    static bool deserialize(const uint8_t* data, size_t size, AudioPacket& outPacket)
+    {
+        if (!readHeader(data, size, outPacket) || outPacket.magic != MAGIC)
+            return false;
+
+        const size_t offset = HEADER_SIZE;
 
         // PCM16 samples holen
         size_t audioBytes = size - HEADER_SIZE;
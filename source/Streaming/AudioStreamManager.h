@@ -5,6 +5,19 @@
 #include "AudioPacket.h"
 #include "ThreadSafeFIFO.h"
 #include "NetworkSender.h"
+#include "Packetizer.h"
+#include "RtpSession.h"
+#include "SessionControl.h"
+#include "SharedMemoryTransport.h"
+#include "TalkbackReceiver.h"
+#include "RemoteControl.h"
+#include "TransportInfo.h"
+#include "PreviewStream.h"
+
+#if MIX2GO_WITH_OPUS
+ #include "OpusEncoder.h"
+ #include <deque>
+#endif
 
 namespace mix2go {
 namespace streaming {
@@ -13,9 +26,112 @@ namespace streaming {
 enum class StreamState
 {
     Disconnected,
-    Connecting,
+    Connecting,  // wartet auf den Empfänger (Handshake)
     Streaming,
-    Error
+    Degraded,    // läuft, aber Reports zeigen Verlust / Unterläufe oder bleiben aus
+    Error        // kein Empfänger oder kein gemeinsames Format, kein Audio
+};
+
+// Wie die Pakete auf dem Netzwerk aussehen
+enum class WireFormat
+{
+    Native, // eigener "M2G0" Header + PCM16, für unsere Empfänger
+    Rtp     // RFC 3550 RTP + RTCP, für Standard-Player
+};
+
+// Wohin der Stream geht
+enum class Transport
+{
+    Udp,          // Netzwerk (native oder RTP)
+    SharedMemory  // Empfänger auf dem selben Rechner, siehe SharedMemoryClient.h
+};
+
+// Meter-Daten an die Empfänger (siehe MeterAnalyzer)
+enum class MeteringMode
+{
+    Off,
+    Levels,             // Peak/RMS pro Kanal
+    LevelsAndSpectrum   // + 32-Band Spektrum
+};
+
+// Ein komplettes Stream-Format. Wird doppelt gepuffert: der Message Thread
+// bereitet den freien Slot vor, der Network Thread übernimmt ihn an einer
+// Paketgrenze. Dadurch wird nie ein Format gelesen das gerade geändert wird.
+struct StreamConfig
+{
+    double sampleRate = 44100.0;
+    int numChannels = 2;
+    int samplesPerBlock = 512;
+    int packetSamples = 220;
+    double sendIntervalMs = 5.0;
+    WireFormat wire = WireFormat::Native;
+    PayloadFormat payload = PayloadFormat::Pcm16;
+    uint32_t generation = 0;
+
+    static StreamConfig create(double sampleRate, int samplesPerBlock, int numChannels,
+                               WireFormat wire = WireFormat::Native,
+                               PayloadFormat payload = PayloadFormat::Pcm16)
+    {
+        StreamConfig config;
+        config.sampleRate = sampleRate;
+        config.samplesPerBlock = samplesPerBlock;
+        config.numChannels = numChannels;
+        config.wire = wire;
+        config.payload = payload;
+
+        if (payload == PayloadFormat::Opus)
+        {
+            // Ein 20 ms Opus Frame (960 samples @ 48 kHz) pro Paket
+            config.packetSamples = (int)std::ceil(960.0 * sampleRate / 48000.0);
+        }
+        else
+        {
+            // Packet Größe: ca 5ms Audio pro Paket senden, aber nie über
+            // packetizer::MAX_DATAGRAM_BYTES (L24 Stereo @ 48 kHz wären 1440
+            // Bytes Payload). Gekürzt wird auf ganze ms, damit ptime im SDP
+            // stimmt: L24 Stereo @ 48 kHz → 3 ms, @ 96 kHz → 1 ms.
+            config.packetSamples = (int)(sampleRate * 0.005);
+
+            const int maxSamples = packetizer::getMaxPacketSamples(payload, numChannels);
+            if (config.packetSamples > maxSamples)
+            {
+                const int samplesPerMs = (int)(sampleRate / 1000.0);
+                config.packetSamples = (samplesPerMs > 0 && maxSamples >= samplesPerMs)
+                                           ? maxSamples / samplesPerMs * samplesPerMs
+                                           : maxSamples;
+            }
+        }
+
+        config.setPacketSamples(config.packetSamples);
+        return config;
+    }
+
+    void setPacketSamples(int newPacketSamples)
+    {
+        packetSamples = newPacketSamples;
+
+        // Exaktes Interval berechnen: packetSamples / sampleRate * 1000ms
+        // z.B. 220 / 44100 * 1000 = 4.9887ms (NICHT 5ms!)
+        // Mit 5ms würden wir nur 44000 samples/s statt 44100 senden → Buffer läuft leer
+        sendIntervalMs = (packetSamples > 0)
+                             ? (double)packetSamples / sampleRate * 1000.0
+                             : 5.0;
+    }
+
+    // FIFO Größe für ca 2 Sekunden Puffer
+    int getFifoSize() const { return (int)sampleRate * 2; }
+
+    int getPacketBytes() const
+    {
+        const auto headerSize = (int)(wire == WireFormat::Rtp ? RtpSession::HEADER_SIZE
+                                                              : AudioPacket::HEADER_SIZE);
+
+        // Opus @ 128 kbps: ca 320 Bytes pro 20 ms Frame
+        if (payload == PayloadFormat::Opus)
+            return headerSize + 320;
+
+        return headerSize + packetizer::getPayloadSize(payload, numChannels, packetSamples);
+    }
 };
 
 // Interface für Listener (GUI updates usw)
@@ -34,9 +150,17 @@ class AudioStreamManager
 public:
     AudioStreamManager()
     {
-        // Callback setzen
-        m_sender.setAudioCallback([this](AudioPacket& packet) {
-            return fillPacketFromFIFO(packet);
+        // Callbacks setzen
+        m_sender.setAudioCallback([this](uint8_t* dest, int capacity) {
+            return fillDatagram(dest, capacity);
+        });
+
+        m_sender.setReceiveCallback([this](const uint8_t* data, int size, bool controlSocket) {
+            handleIncoming(data, size, controlSocket);
+        });
+
+        m_sender.setTickCallback([this]() {
+            onNetworkTick();
         });
     }
     
@@ -50,31 +174,71 @@ public:
     //==========================================================================
     
     // Setup machen
+    // Kann jederzeit kommen, auch während gestreamt wird (Host ändert
+    // Sample Rate oder Block Size). Dann wird der freie Slot vorbereitet und
+    // veröffentlicht, der Network Thread wechselt an der nächsten Paketgrenze
+    // und kündigt das neue Format mit einem Descriptor-Paket an.
+    // Ist noch ein Wechsel offen, wartet prepare() erst bis der Network
+    // Thread ihn übernommen hat. Ein Slot der gerade gelesen wird oder noch
+    // auf die Übernahme wartet wird nie überschrieben.
     void prepare(double sampleRate, int samplesPerBlock, int numChannels)
     {
-        m_sampleRate = sampleRate;
-        m_samplesPerBlock = samplesPerBlock;
-        m_numChannels = numChannels;
-        
-        // FIFO Größe für ca 1 Sekunde Puffer
-        int fifoSize = (int)sampleRate * 2;
-        m_fifo.prepare(numChannels, fifoSize);
-        
-        // Packet Größe: ca 5ms Audio pro Paket senden
-        // Kleinere Pakete bleiben unter 1200 Bytes und werden nicht fragmentiert
-        m_packetSamples = (int)(sampleRate * 0.005);
+        auto config = StreamConfig::create(sampleRate, samplesPerBlock, numChannels,
+                                           m_wireFormat, m_payloadFormat);
 
-        // Exaktes Interval berechnen: packetSamples / sampleRate * 1000ms
-        // z.B. 220 / 44100 * 1000 = 4.9887ms (NICHT 5ms!)
-        // Mit 5ms würden wir nur 44000 samples/s statt 44100 senden → Buffer läuft leer
-        double exactIntervalMs = (m_packetSamples > 0)
-                                     ? (double)m_packetSamples / sampleRate * 1000.0
-                                     : 5.0;
-        m_sender.setSendInterval(exactIntervalMs);
+        // Bei Shared Memory liest kein Network Thread aus den Slots
+        const bool networkReading = m_isStreaming && m_transport == Transport::Udp;
+
+        if (networkReading && !waitForPendingSwitch())
+        {
+            // Network Thread hängt, lieber beim alten Format bleiben als
+            // ihm den Slot unter den Füßen wegzuziehen
+            DBG("[Mix2Go] Format switch still pending, prepare skipped");
+            jassertfalse;
+            return;
+        }
+
+        const juce::SpinLock::ScopedLockType lock(m_configLock);
+
+        if (!networkReading)
+        {
+            // Network Thread läuft nicht, aktiven Slot direkt umbauen
+            const int slot = m_writeSlot.load(std::memory_order_relaxed);
+            config.generation = m_configs[(size_t)slot].generation + 1;
+            m_configs[(size_t)slot] = config;
+            m_fifos[(size_t)slot].prepare(numChannels, config.getFifoSize());
+            m_transportTracker.resetSlot(slot);
+            m_loudEnd[(size_t)slot] = 0;
+            m_readSlot.store(slot, std::memory_order_release);
+            m_sender.setSendInterval(config.sendIntervalMs);
+        }
+        else
+        {
+            // Nach waitForPendingSwitch() gilt writeSlot == readSlot, der
+            // andere Slot ist frei. Solange wir den Lock halten kann der
+            // Network Thread nicht wechseln.
+            const int current = m_readSlot.load(std::memory_order_acquire);
+            jassert(m_writeSlot.load(std::memory_order_relaxed) == current);
+            const int slot = 1 - current;
+            config.generation = m_configs[(size_t)current].generation + 1;
+            m_configs[(size_t)slot] = config;
+            m_fifos[(size_t)slot].prepare(numChannels, config.getFifoSize());
+            m_fifos[(size_t)slot].reset();
+            m_transportTracker.resetSlot(slot);
+            m_loudEnd[(size_t)slot] = 0;
+            m_writeSlot.store(slot, std::memory_order_release);
+        }
+
+        // Format-Wechsel bei Shared Memory: prepareToPlay() läuft nie
+        // parallel zu processBlock(), also direkt umstellen
+        m_sharedMemory.setFormat(sampleRate, numChannels);
+        m_talkback.prepare(sampleRate, samplesPerBlock);
+        m_meters.prepare(sampleRate, numChannels);
 
         DBG("Manager Prepared: SR=" << sampleRate
-            << " PacketSamples=" << m_packetSamples
-            << " (~" << (int)(m_packetSamples * 2 * 2 + (int)AudioPacket::HEADER_SIZE) << " bytes/pkt)");
+            << " PacketSamples=" << config.packetSamples
+            << " (~" << config.getPacketBytes() << " bytes/pkt)"
+            << (m_isStreaming ? " [hot swap pending]" : ""));
     }
     
     // IP setzen
@@ -87,6 +251,148 @@ public:
     
     juce::String getTargetIP() { return m_targetIP; }
     int getTargetPort() { return m_targetPort; }
+
+    // Wire Format + Codec wählen, nur wenn gerade nicht gestreamt wird.
+    // Native startet mit PCM16, den Codec handelt danach der Handshake aus.
+    // Opus gibt es nur mit MIX2GO_WITH_OPUS.
+    void setWireFormat(WireFormat wire, PayloadFormat payload)
+    {
+        if (m_isStreaming)
+        {
+            jassertfalse;
+            return;
+        }
+
+        if (wire == WireFormat::Native)
+            payload = PayloadFormat::Pcm16;
+
+       #if ! MIX2GO_WITH_OPUS
+        if (payload == PayloadFormat::Opus)
+        {
+            DBG("[Mix2Go] Opus not available in this build, using L16");
+            payload = PayloadFormat::Pcm16;
+        }
+       #endif
+
+        m_wireFormat = wire;
+        m_payloadFormat = payload;
+
+        const auto& current = m_configs[(size_t)getReadSlot()];
+        prepare(current.sampleRate, current.samplesPerBlock, current.numChannels);
+    }
+
+    // UDP oder Shared Memory, nur wenn gerade nicht gestreamt wird
+    void setTransport(Transport transport, const juce::String& sharedMemoryName = shm::DEFAULT_NAME)
+    {
+        if (m_isStreaming)
+        {
+            jassertfalse;
+            return;
+        }
+
+        if (transport == Transport::SharedMemory && !SharedMemoryTransport::isSupported())
+        {
+            DBG("[Mix2Go] Shared memory transport not supported on this platform, using UDP");
+            transport = Transport::Udp;
+        }
+
+        m_transport = transport;
+        m_sharedMemoryName = sharedMemoryName;
+    }
+
+    Transport getTransport() const { return m_transport; }
+
+    // Segment dieser Instanz (für SharedMemoryClient::attach), leer solange
+    // noch keins angelegt ist. Message Thread.
+    juce::String getSharedMemoryName() const { return m_sharedMemory.getName(); }
+
+    // Meter Side-Stream, ca. 30 Hz, nur native Sessions. Jederzeit änderbar,
+    // ein neuer Thread startet aber erst mit dem nächsten startStreaming().
+    void setMeteringMode(MeteringMode mode)
+    {
+        m_meteringMode = mode;
+        m_meters.setSpectrumEnabled(mode == MeteringMode::LevelsAndSpectrum);
+    }
+
+    MeteringMode getMeteringMode() const { return m_meteringMode; }
+
+    // Auto-Pause: steht der Host-Transport und ist der Eingang still, gehen
+    // keine Pakete raus (native: nur ca. jede Sekunde ein Pausen-Hinweis).
+    // Auf Play geht es mit dem nächsten Block weiter. Hosts ohne Playhead
+    // pausieren nie. Jederzeit änderbar.
+    void setAutoPauseWhenStopped(bool shouldPause) { m_autoPause = shouldPause; }
+    bool isAutoPauseWhenStopped() const { return m_autoPause; }
+
+    // true solange der Audio Thread wegen Auto-Pause nichts schickt
+    bool isTransportPaused() const { return m_isStreaming && m_transportPaused; }
+
+    // DTX (Discontinuous Transmission): Stille und FIFO Unterläufe gehen
+    // nicht als volle Pakete mit Nullen raus, sondern native als kleine
+    // DTX Pakete (siehe AudioPacket::FLAG_DTX), bei RTP gar nicht (Silence
+    // Suppression nach RFC 3551, Marker Bit beim Wiedereinstieg). Nur PCM,
+    // Opus macht Stille selbst klein. Jederzeit änderbar.
+    void setDtxEnabled(bool shouldBeEnabled) { m_dtxEnabled = shouldBeEnabled; }
+    bool isDtxEnabled() const { return m_dtxEnabled; }
+
+    // Empfänger ohne Handshake (ältere Apps, tools/test_receiver.py): Audio
+    // geht ohne Offer sofort im Host-Format mit PCM16 raus, Status Streaming.
+    // Ein Offer schaltet trotzdem aufs ausgehandelte Format. Aus (Standard):
+    // Audio erst nach dem Offer, ohne Offer nach CONNECT_TIMEOUT_MS Error.
+    // Nur native, jederzeit änderbar.
+    void setLegacyReceiver(bool shouldSendWithoutHandshake) { m_legacyReceiver = shouldSendWithoutHandshake; }
+    bool isLegacyReceiver() const { return m_legacyReceiver; }
+
+    // true solange gerade Stille per DTX läuft
+    bool isInDtx() const { return m_isStreaming && m_dtxActive; }
+
+    // So lange nach dem letzten hörbaren Sample noch volle Pakete, damit
+    // leise Ausklänge nicht zerhackt werden
+    static constexpr int DTX_HANGOVER_MS = 100;
+
+    // Während DTX: so oft ein Keep-Alive mit den Stille-Samples bis dahin
+    static constexpr uint32_t DTX_KEEPALIVE_MS = 100;
+
+    // Vorschau-Stream an ein zweites Ziel, z.B. für Remote-Producer im
+    // Mobilnetz: mono oder M/S, ~24 oder ~12 kHz, PCM16 (siehe PreviewStream).
+    // Läuft parallel zum Haupt-Stream aus dem selben FIFO, ohne Handshake.
+    // Nur UDP, nur wenn gerade nicht gestreamt wird. PreviewMode::Off = aus.
+    void setPreview(PreviewMode mode, PreviewRate rate = PreviewRate::Wide,
+                    const juce::String& ipAddress = {}, int port = 0)
+    {
+        if (m_isStreaming)
+        {
+            jassertfalse;
+            return;
+        }
+
+        if (mode != PreviewMode::Off && (ipAddress.isEmpty() || port <= 0 || port > 65535))
+        {
+            DBG("[Mix2Go] Preview needs a target, disabled");
+            mode = PreviewMode::Off;
+        }
+
+        m_preview.setMode(mode, rate);
+        m_previewIP = ipAddress;
+        m_previewPort = port;
+    }
+
+    PreviewMode getPreviewMode() const { return m_preview.getMode(); }
+
+    // Talkback Rückkanal anbieten (Aux Output Bus aktiv). Wirkt ab dem
+    // nächsten Handshake.
+    void setTalkbackEnabled(bool shouldBeEnabled) { m_talkbackEnabled = shouldBeEnabled; }
+    bool isTalkbackEnabled() const { return m_talkbackEnabled; }
+
+    WireFormat getWireFormat() const { return m_wireFormat; }
+    PayloadFormat getPayloadFormat() const { return m_payloadFormat; }
+
+    // SDP Beschreibung für RTP Empfänger (ffplay, VLC ...)
+    juce::String getSdp()
+    {
+        const auto& config = m_configs[(size_t)getReadSlot()];
+        return RtpSession::createSdp(config.payload, config.sampleRate, config.numChannels,
+                                     config.packetSamples, m_targetIP, m_targetPort);
+    }
     
     //==========================================================================
     // Streaming Start/Stop
@@ -94,9 +400,12 @@ public:
     
     bool startStreaming()
     {
-        if (m_state == StreamState::Streaming)
+        if (m_isStreaming)
             return true;
 
+        if (m_transport == Transport::SharedMemory)
+            return startSharedMemory();
+
         if (m_targetIP.isEmpty() || m_targetIP == "0.0.0.0")
         {
             DBG("[Mix2Go] startStreaming() aborted: no target IP set");
@@ -106,9 +415,35 @@ public:
 
         setState(StreamState::Connecting);
 
-        m_fifo.reset();
+        {
+            const juce::SpinLock::ScopedLockType lock(m_configLock);
+            m_readSlot.store(m_writeSlot.load(std::memory_order_relaxed), std::memory_order_release);
+        }
+
+        for (auto& fifo : m_fifos)
+            fifo.reset();
+
+        m_transportTracker.reset(getReadSlot());
+        m_transportPaused = false;
+        m_transportPausedOnWire = false;
+        m_transportSent = false;
+        m_samplesSinceTransport = 0;
+        m_loudEnd[0] = 0;
+        m_loudEnd[1] = 0;
+        m_dtxActive = false;
+        m_dtxPendingSamples = 0;
+        m_silentBlocks = 0;
+
+        // Network Thread läuft noch nicht, Session-Zustand hier vorbereiten
+        const auto& host = m_configs[(size_t)getReadSlot()];
+        m_rtp.reset();
+        resetSession();
+        activateConfig(host);
+        m_preview.prepare(host.sampleRate, host.numChannels);
+
         m_sequenceNumber = 0;
         m_networkUnderruns = 0;
+        m_packetsBuilt = 0;
         m_streamStartTime = juce::Time::getHighResolutionTicks();
 
         if (!m_sender.start())
@@ -117,24 +452,44 @@ public:
             return false;
         }
 
+        // Rückkanal gibt es nur mit Handshake (native)
+        if (host.wire == WireFormat::Native && m_talkbackEnabled)
+            m_talkback.start();
+
+        if (host.wire == WireFormat::Native && m_meteringMode != MeteringMode::Off)
+            m_meters.start();
+
         m_isStreaming = true;
-        setState(StreamState::Streaming);
 
-        const int packetBytes = (int)(AudioPacket::HEADER_SIZE
-                                      + m_packetSamples * m_numChannels * (int)sizeof(int16_t));
-        const int pps         = (m_packetSamples > 0)
-                                  ? (int)juce::roundToInt(m_sampleRate / m_packetSamples)
+        // RTP Player machen keinen Handshake, da geht es sofort los
+        if (host.wire == WireFormat::Rtp)
+            setState(StreamState::Streaming);
+
+        const auto& config    = host;
+        const int packetBytes = config.getPacketBytes();
+        const int pps         = (config.packetSamples > 0)
+                                  ? (int)juce::roundToInt(config.sampleRate / config.packetSamples)
                                   : 0;
         const int kbps        = packetBytes * pps * 8 / 1000;
 
         DBG("[Mix2Go] === Streaming Started =========================");
-        DBG("[Mix2Go]   Format:           28-byte header + PCM16 payload");
+        if (config.wire == WireFormat::Rtp)
+        {
+            DBG("[Mix2Go]   Format:           RTP (RFC 3550), PT " << (int)RtpSession::getPayloadType(config.payload)
+                << ", RTCP -> port " << (m_targetPort + 1));
+            DBG("[Mix2Go]   SDP:\n" << getSdp());
+        }
+        else
+        {
+            DBG("[Mix2Go]   Format:           28-byte header, codec negotiated by handshake"
+                << " (session " << juce::String::toHexString((int)m_sessionId) << ")");
+        }
         DBG("[Mix2Go]   Target:           " << m_targetIP << ":" << m_targetPort);
-        DBG("[Mix2Go]   SampleRate:       " << (int)m_sampleRate << " Hz");
-        DBG("[Mix2Go]   Channels:         " << m_numChannels);
-        DBG("[Mix2Go]   SamplesPerPacket: " << m_packetSamples);
-        DBG("[Mix2Go]   PacketSize:       " << packetBytes << " bytes  (MTU safe: " << (packetBytes < 1200 ? "YES" : "NO") << ")");
-        DBG("[Mix2Go]   PacketInterval:   5 ms");
+        DBG("[Mix2Go]   SampleRate:       " << (int)config.sampleRate << " Hz");
+        DBG("[Mix2Go]   Channels:         " << config.numChannels);
+        DBG("[Mix2Go]   SamplesPerPacket: " << config.packetSamples);
+        DBG("[Mix2Go]   PacketSize:       " << packetBytes << " bytes  (MTU safe: " << (packetBytes <= packetizer::MAX_DATAGRAM_BYTES ? "YES" : "NO") << ")");
+        DBG("[Mix2Go]   PacketInterval:   " << config.sendIntervalMs << " ms");
         DBG("[Mix2Go]   PacketsPerSec:    ~" << pps);
         DBG("[Mix2Go]   Bitrate:          ~" << kbps << " kbps");
         DBG("[Mix2Go] =====================================================");
@@ -144,9 +499,25 @@ public:
     
     void stopStreaming()
     {
+        // Empfänger sofort Bescheid geben statt ihn in den Timeout laufen
+        // zu lassen. m_sessionId ändert sich nur in startStreaming().
+        if (m_isStreaming && m_transport == Transport::Udp
+            && m_configs[(size_t)getReadSlot()].wire == WireFormat::Native)
+        {
+            session::Bye bye;
+            bye.sessionId = m_sessionId;
+            std::array<uint8_t, session::MAX_MESSAGE_SIZE> buffer {};
+            m_sender.sendToTarget(buffer.data(), session::write(bye, buffer.data()));
+        }
+
         m_isStreaming = false;
         m_sender.stop();
-        m_fifo.reset();
+        m_talkback.stop();
+        m_meters.stop();
+        m_sharedMemory.setWriterActive(false);
+
+        for (auto& fifo : m_fifos)
+            fifo.reset();
         setState(StreamState::Disconnected);
         
         DBG("Streaming stopped");
@@ -165,10 +536,12 @@ public:
     // Status als Text für GUI
     juce::String getStateString()
     {
-        if (m_state == StreamState::Disconnected) return "Disconnected";
-        if (m_state == StreamState::Connecting) return "Connecting...";
-        if (m_state == StreamState::Streaming) return "Streaming";
-        if (m_state == StreamState::Error) return "Error";
+        const StreamState state = m_state;
+        if (state == StreamState::Disconnected) return "Disconnected";
+        if (state == StreamState::Connecting) return "Connecting...";
+        if (state == StreamState::Streaming) return "Streaming";
+        if (state == StreamState::Degraded) return "Degraded";
+        if (state == StreamState::Error) return "Error";
         return "Unknown";
     }
     
@@ -176,18 +549,71 @@ public:
     // Audio Thread
     //==========================================================================
     
-    // Hier kommen die Daten vom Audio Thread an
-    void pushAudioData(const juce::AudioBuffer<float>& buffer)
+    // Hier kommen die Daten vom Audio Thread an, mit dem Host-Transport
+    // von diesem Block (ohne Playhead einfach leer lassen)
+    void pushAudioData(const juce::AudioBuffer<float>& buffer, const TransportInfo& transport = {})
     {
         if (!m_isStreaming)
             return;
 
-        // Push immer wenn streaming läuft - kein Silence-Gate.
-        // Das FIFO schickt dann auch Stille, damit der Empfänger
-        // einen kontinuierlichen Datenstrom bekommt.
-        m_fifo.push(buffer);
+        // Stille-Erkennung einmal pro Block (findMinAndMax ist vektorisiert),
+        // für hasAudioSignal(), Auto-Pause und DTX
+        const bool silent = isSilent(buffer);
+        m_silentBlocks = silent ? juce::jmin(m_silentBlocks.load(std::memory_order_relaxed) + 1, 1 << 30) : 0;
+
+        // Lokaler Empfänger: direkt in den Shared-Memory Ring, ohne FIFO
+        // und ohne Network Thread
+        if (m_transport == Transport::SharedMemory)
+        {
+            m_sharedMemory.write(buffer);
+            return;
+        }
+
+        // Auto-Pause: Transport steht und nichts mehr zu hören (Hall ist
+        // ausgeklungen). Der Network Thread schickt noch den Rest aus dem
+        // FIFO und hört dann auf.
+        if (m_autoPause && transport.hasPlayHead() && !transport.isPlaying() && silent)
+        {
+            m_transportPaused.store(true, std::memory_order_release);
+            return;
+        }
+
+        // Sonst immer pushen, auch Stille, damit der Empfänger einen
+        // kontinuierlichen Datenstrom bekommt. Transport nur mitzählen wenn
+        // die Samples auch im FIFO gelandet sind.
+        const int slot = m_writeSlot.load(std::memory_order_acquire);
+
+        // Für DTX: Ende vom letzten hörbaren Block. Vor dem Push setzen, sonst
+        // könnte der Network Thread die Samples schon lesen und für still halten.
+        if (!silent)
+            m_loudEnd[(size_t)slot].store(m_transportTracker.getWritePosition(slot) + (uint64_t)buffer.getNumSamples(),
+                                          std::memory_order_release);
+
+        if (m_fifos[(size_t)slot].push(buffer))
+            m_transportTracker.push(slot, transport, buffer.getNumSamples());
+
+        // Erst nach dem Push, sonst sieht der Network Thread ein leeres FIFO
+        // ohne Pause und schickt ein Stille-Paket
+        m_transportPaused.store(false, std::memory_order_release);
+
+        // Kopie für die Meter-Analyse (macht nichts wenn der Thread nicht läuft)
+        m_meters.push(buffer);
     }
     
+    // Talkback vom Empfänger in den Aux Bus (mono auf alle Kanäle).
+    // Ohne Stream oder Rückkanal wird dest gelöscht.
+    void readTalkback(juce::AudioBuffer<float>& dest)
+    {
+        if (!m_isStreaming || !m_talkbackEnabled)
+        {
+            dest.clear();
+            return;
+        }
+
+        m_talkback.read(dest);
+    }
+
+    // false nach 10 stillen Blöcken am Stück (unter -90 dBFS)
     bool hasAudioSignal()
     {
         return m_silentBlocks < 10;
@@ -199,9 +625,30 @@ public:
     
     uint64_t getPacketsSent() { return m_sender.getPacketsSent(); }
     uint64_t getBytesSent() { return m_sender.getBytesSent(); }
-    uint64_t getFIFOOverruns() { return m_fifo.getOverrunCount(); }
-    uint64_t getFIFOUnderruns() { return m_fifo.getUnderrunCount(); }
-    int getFIFOLevel() { return m_fifo.getNumReady(); }
+    uint64_t getFIFOOverruns() { return getReadFifo().getOverrunCount(); }
+    uint64_t getFIFOUnderruns() { return getReadFifo().getUnderrunCount(); }
+    int getFIFOLevel() { return getReadFifo().getNumReady(); }
+    uint32_t getFormatGeneration() { return m_configs[(size_t)getReadSlot()].generation; }
+
+    // Loss / Jitter / RTT aus den RTCP Receiver Reports (nur RTP Mode)
+    const RtpSession::Stats& getRtpStats() const { return m_rtp.getStats(); }
+
+    // Aus den Session Reports vom Empfänger (nur native)
+    struct SessionStats
+    {
+        std::atomic<float> lossPercent { 0.0f };   // seit dem letzten Report
+        std::atomic<float> jitterMs { 0.0f };
+        std::atomic<int> bufferMs { 0 };
+        std::atomic<uint64_t> reportsReceived { 0 };
+        std::atomic<PayloadFormat> payload { PayloadFormat::Pcm16 };
+    };
+
+    const SessionStats& getSessionStats() const { return m_sessionStats; }
+    // Macro-Fernsteuerung (siehe RemoteControl.h)
+    RemoteControl& getRemoteControl() { return m_remoteControl; }
+
+    const TalkbackReceiver::Stats& getTalkbackStats() const { return m_talkback.getStats(); }
+    float getTalkbackLatencyMs() const { return m_talkback.getLatencyMs(); }
     
     //==========================================================================
     // Listener
@@ -220,12 +667,11 @@ public:
     }
     
 private:
+    // Kommt vom Message Thread und vom Network Thread
     void setState(StreamState newState)
     {
-        if (m_state == newState)
+        if (m_state.exchange(newState) == newState)
             return;
-            
-        m_state = newState;
         
         // Listener benachrichtigen
         juce::ScopedLock lock(m_listenerLock);
@@ -236,86 +682,1042 @@ private:
         }
     }
     
-    // Wird vom Network Thread aufgerufen
-    bool fillPacketFromFIFO(AudioPacket& packet)
+    bool startSharedMemory()
+    {
+        const auto& config = m_configs[(size_t)getReadSlot()];
+
+        if (!m_sharedMemory.open(m_sharedMemoryName, config.sampleRate, config.numChannels))
+        {
+            setState(StreamState::Error);
+            return false;
+        }
+
+        m_sharedMemory.setWriterActive(true);
+        m_isStreaming = true;
+        setState(StreamState::Streaming);
+
+        DBG("[Mix2Go] === Streaming Started (shared memory) ============");
+        DBG("[Mix2Go]   Segment:          " << m_sharedMemory.getName());
+        DBG("[Mix2Go]   SampleRate:       " << (int)config.sampleRate << " Hz");
+        DBG("[Mix2Go]   Channels:         " << config.numChannels);
+        return true;
+    }
+
+    ThreadSafeFIFO& getReadFifo() { return m_fifos[(size_t)getReadSlot()]; }
+
+    // Schreibt nur der Network Thread (bzw. prepare()/startStreaming() wenn
+    // er nicht läuft), GUI und prepare() lesen mit
+    int getReadSlot() const { return m_readSlot.load(std::memory_order_acquire); }
+
+    // Wartet bis der Network Thread einen offenen Format-Wechsel übernommen
+    // hat. m_forceSwitch lässt ihn den Rest im alten FIFO verwerfen, dann
+    // dauert das höchstens einen Tick.
+    bool waitForPendingSwitch()
+    {
+        if (m_writeSlot.load(std::memory_order_acquire) == getReadSlot())
+            return true;
+
+        m_forceSwitch.store(true, std::memory_order_release);
+
+        for (int i = 0; i < PENDING_SWITCH_TIMEOUT_MS; ++i)
+        {
+            if (m_writeSlot.load(std::memory_order_acquire) == getReadSlot())
+                return true;
+
+            juce::Thread::sleep(1);
+        }
+
+        return m_writeSlot.load(std::memory_order_acquire) == getReadSlot();
+    }
+
+    // Alles unter -90 dBFS zählt als Stille (Auto-Pause, DTX)
+    static constexpr float SILENCE_THRESHOLD = 3.1623e-5f;
+
+    static bool isSilent(const juce::AudioBuffer<float>& buffer)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(buffer.getReadPointer(ch),
+                                                                          buffer.getNumSamples());
+            if (juce::jmax(-range.getStart(), range.getEnd()) > SILENCE_THRESHOLD)
+                return false;
+        }
+
+        return true;
+    }
+
+    //==========================================================================
+    // Network Thread
+    //==========================================================================
+
+    // Host-Format + Ergebnis vom Handshake = was tatsächlich gesendet wird
+    StreamConfig getEffectiveConfig(const StreamConfig& host) const
+    {
+        if (host.wire != WireFormat::Native || !m_negotiated.valid)
+            return host;
+
+        auto config = StreamConfig::create(host.sampleRate, host.samplesPerBlock,
+                                           juce::jmin(host.numChannels, m_negotiated.numChannels),
+                                           host.wire, m_negotiated.payload);
+
+        if (m_negotiated.maxPacketSamples > 0 && config.packetSamples > m_negotiated.maxPacketSamples)
+            config.setPacketSamples(m_negotiated.maxPacketSamples);
+
+        config.generation = host.generation;
+        return config;
+    }
+
+    // m_active neu setzen. Network Thread, oder Message Thread bevor der
+    // Network Thread läuft.
+    void activateConfig(const StreamConfig& host)
+    {
+        m_active = getEffectiveConfig(host);
+        m_sender.setSendInterval(m_active.sendIntervalMs);
+        m_rtp.setFormat(m_active.payload, m_active.sampleRate);
+        m_sessionStats.payload = m_active.payload;
+
+       #if MIX2GO_WITH_OPUS
+        if (m_active.payload == PayloadFormat::Opus)
+        {
+            m_opus.prepare(m_active.sampleRate, m_active.numChannels);
+            m_opusFrames.clear();
+        }
+       #endif
+    }
+
+    // Wechselt auf den neuen Slot sobald das alte FIFO kein volles Paket
+    // mehr hergibt. Nur vom Network Thread aufgerufen. Der Rest im alten
+    // FIFO (< 1 Paket) wird verworfen, der Empfänger bekommt stattdessen
+    // ein Descriptor-Paket (native) bzw. das Marker Bit (RTP).
+    bool switchToPendingConfig()
+    {
+        const int pending = m_writeSlot.load(std::memory_order_acquire);
+        if (pending == getReadSlot())
+            return false;
+
+        // prepare() wartet auf uns, dann den Rest nicht mehr ausspielen
+        if (!m_forceSwitch.load(std::memory_order_acquire)
+            && getReadFifo().getNumReady() >= m_active.packetSamples)
+            return false;
+
+        const juce::SpinLock::ScopedTryLockType lock(m_configLock);
+        if (!lock.isLocked())
+            return false; // prepare() baut gerade um, nächstes Paket nochmal
+
+        const int slot = m_writeSlot.load(std::memory_order_acquire);
+        m_readSlot.store(slot, std::memory_order_release);
+        m_forceSwitch.store(false, std::memory_order_relaxed);
+        activateConfig(m_configs[(size_t)slot]);
+        m_preview.prepare(m_configs[(size_t)slot].sampleRate, m_configs[(size_t)slot].numChannels);
+        m_transportTracker.beginRead(slot);
+        m_transportSent = false;
+        m_samplesSinceTransport = 0;
+        m_dtxActive = false;         // das Descriptor-Paket setzt neu auf
+        m_dtxPendingSamples = 0;
+        m_lastLoggedOverruns = 0;
+        m_announceFormat = true;
+
+        DBG("[Mix2Go] Format switched at seq=" << (int)m_sequenceNumber
+            << ": SR=" << (int)m_active.sampleRate
+            << " ch=" << m_active.numChannels
+            << " packetSamples=" << m_active.packetSamples
+            << " gen=" << (int)m_active.generation);
+        return true;
+    }
+
+    void stampPacket(AudioPacket& packet)
+    {
+        double ticksPerMicrosecond = juce::Time::getHighResolutionTicksPerSecond() / 1000000.0;
+        auto ticksSinceStart = juce::Time::getHighResolutionTicks() - m_streamStartTime;
+
+        packet.timestamp      = (uint64_t)(ticksSinceStart / ticksPerMicrosecond);
+        packet.sequenceNumber = m_sequenceNumber++;
+    }
+
+    static uint16_t getNativeCodecFlags(PayloadFormat payload)
+    {
+        switch (payload)
+        {
+            case PayloadFormat::Pcm24: return AudioPacket::FLAG_CODEC_PCM24;
+            case PayloadFormat::Opus:  return AudioPacket::FLAG_CODEC_OPUS;
+            case PayloadFormat::Pcm16: break;
+        }
+        return 0;
+    }
+
+    // Sample Rate und Samples pro Paket so wie sie auf dem Wire stehen
+    // (Opus: 48 kHz Frames, egal was der Host macht)
+    uint32_t getWireSampleRate() const
+    {
+        return m_active.payload == PayloadFormat::Opus ? 48000u : (uint32_t)m_active.sampleRate;
+    }
+
+    int getWirePacketSamples() const
+    {
+       #if MIX2GO_WITH_OPUS
+        if (m_active.payload == PayloadFormat::Opus)
+            return m_opus.getFrameSize();
+       #endif
+        return m_active.packetSamples;
+    }
+
+    static int getNativeHeaderSize(const TransportInfo* transport)
+    {
+        return (int)AudioPacket::HEADER_SIZE
+             + (transport != nullptr ? (int)AudioPacket::EXTENSION_HEADER_SIZE + TransportInfo::DATA_SIZE : 0);
+    }
+
+    // Header plus (optional) Transport Extension, gibt die Größe zurück.
+    // Der Payload gehört an dest + getNativeHeaderSize(transport).
+    int writeNativeHeader(uint8_t* dest, uint16_t flags, int numChannels, int numSamples,
+                          const TransportInfo* transport = nullptr)
+    {
+        if (transport != nullptr)
+            flags |= AudioPacket::FLAG_EXTENSION;
+
+        AudioPacket header;
+        header.flags       = (uint16_t)(flags | getNativeCodecFlags(m_active.payload));
+        header.sampleRate  = getWireSampleRate();
+        header.numChannels = (uint16_t)numChannels;
+        header.numSamples  = (uint32_t)numSamples;
+        stampPacket(header);
+        header.writeHeader(dest);
+
+        if (transport != nullptr)
+        {
+            uint8_t* extension = dest + AudioPacket::HEADER_SIZE;
+            const uint16_t type = AudioPacket::EXTENSION_TRANSPORT;
+            const uint16_t length = (uint16_t)TransportInfo::DATA_SIZE;
+            std::memcpy(extension, &type, sizeof(type));
+            std::memcpy(extension + 2, &length, sizeof(length));
+            transport->write(extension + AudioPacket::EXTENSION_HEADER_SIZE, false);
+        }
+
+        return getNativeHeaderSize(transport);
+    }
+
+    // RTP: Transport als Header Extension ans nächste Paket, oder keine
+    void setRtpExtension(const TransportInfo* transport)
+    {
+        if (transport == nullptr)
+        {
+            m_rtp.clearExtension();
+            return;
+        }
+
+        std::array<uint8_t, TransportInfo::DATA_SIZE> data;
+        transport->write(data.data(), true);
+        m_rtp.setExtension(TransportInfo::RTP_EXTENSION_PROFILE, data.data(), TransportInfo::DATA_SIZE / 4);
+    }
+
+    // Header-only Paket das das neue Format ankündigt (native)
+    int writeNativeDescriptor(uint8_t* dest, int capacity)
+    {
+        if (capacity < (int)AudioPacket::HEADER_SIZE)
+            return 0;
+
+        return writeNativeHeader(dest, AudioPacket::FLAG_FORMAT_DESCRIPTOR,
+                                 m_active.numChannels, getWirePacketSamples());
+    }
+
+    // Ein Paket Audio ins Datagramm, je nach Wire Format und Codec.
+    // transport != nullptr: Transport-Stand als Extension mitschicken
+    // (bei Opus ungefähr, der Encoder puffert intern).
+    int writeAudio(const AudioRegion& region, uint8_t* dest, int capacity,
+                   const TransportInfo* transport = nullptr)
     {
+        const auto& config = m_active;
+        const int headerSize = getNativeHeaderSize(transport);
+
+       #if MIX2GO_WITH_OPUS
+        if (config.payload == PayloadFormat::Opus)
+        {
+            if (!encodeOpus(region))
+                return 0;
+
+            const int frameBytes = (int)m_opusFrame.size();
+
+            if (config.wire == WireFormat::Rtp)
+            {
+                setRtpExtension(transport);
+                return juce::jmax(0, m_rtp.writeOpusPacket(m_opusFrame.data(), frameBytes,
+                                                           m_opus.getFrameSize(), dest, capacity));
+            }
+
+            if (capacity < headerSize + frameBytes)
+                return 0;
+
+            std::memcpy(dest + headerSize, m_opusFrame.data(), (size_t)frameBytes);
+            return writeNativeHeader(dest, 0, region.numChannels, m_opus.getFrameSize(), transport) + frameBytes;
+        }
+       #endif
+
+        if (config.wire == WireFormat::Rtp)
+        {
+            setRtpExtension(transport);
+            return juce::jmax(0, m_rtp.writePcmPacket(region, dest, capacity));
+        }
+
+        if (capacity < headerSize)
+            return 0;
+
+        const int payloadBytes = packetizer::writePcm(region, config.payload, false,
+                                                      dest + headerSize, capacity - headerSize);
+        if (payloadBytes < 0)
+            return 0;
+
+        return writeNativeHeader(dest, 0, region.numChannels, region.getNumSamples(), transport) + payloadBytes;
+    }
+
+    //==========================================================================
+    // Host Transport (siehe TransportInfo.h)
+    //==========================================================================
+
+    // Samples aus dem FIFO gelesen (gesendet oder verworfen)
+    void consumeSamples(int numSamples)
+    {
+        m_transportTracker.consume(numSamples);
+        m_samplesSinceTransport += (uint64_t)numSamples;
+    }
+
+    // Transport-Stand am Anfang vom nächsten Paket. true wenn er mit muss:
+    // erstes Paket, Zustandswechsel, Sprung (Loop, Locate) oder Refresh.
+    bool takeTransportUpdate(TransportInfo& transport)
+    {
+        if (!m_transportTracker.getCurrent(m_active.sampleRate, transport) || !transport.hasPlayHead())
+            return false;
+
+        if (!m_transportSent)
+            return true;
+
+        auto expected = m_lastTransport;
+        expected.advance((int64_t)m_samplesSinceTransport, m_active.sampleRate);
+
+        return !transport.continues(expected)
+            || juce::Time::getMillisecondCounter() - m_lastTransportMs >= TransportInfo::REFRESH_INTERVAL_MS;
+    }
+
+    void commitTransportUpdate(const TransportInfo& transport)
+    {
+        m_lastTransport = transport;
+        m_lastTransportMs = juce::Time::getMillisecondCounter();
+        m_samplesSinceTransport = 0;
+        m_transportSent = true;
+    }
+
+    // Auto-Pause: das FIFO ist leer und der Audio Thread pausiert. Keine
+    // Stille-Pakete, native bekommt ca. jede Sekunde einen Hinweis ohne
+    // Audio (Transport Extension mit FLAG_PAUSED), damit der Empfänger das
+    // nicht für Verlust hält.
+    int writePauseNotice(uint8_t* dest, int capacity)
+    {
+        const auto now = juce::Time::getMillisecondCounter();
+
+        if (!m_transportPausedOnWire)
+        {
+            DBG("[Mix2Go] Transport stopped and input silent, pausing packets");
+            m_transportPausedOnWire = true;
+            m_pauseStartTicks = juce::Time::getHighResolutionTicks();
+            m_lastPauseNoticeMs = now - TransportInfo::PAUSE_NOTICE_INTERVAL_MS;
+        }
+
+        if (m_active.wire != WireFormat::Native
+            || now - m_lastPauseNoticeMs < TransportInfo::PAUSE_NOTICE_INTERVAL_MS)
+            return 0;
+
+        TransportInfo transport;
+        m_transportTracker.getCurrent(m_active.sampleRate, transport);
+        transport.flags |= TransportInfo::FLAG_PAUSED;
+
+        if (capacity < getNativeHeaderSize(&transport))
+            return 0;
+
+        m_lastPauseNoticeMs = now;
+        return writeNativeHeader(dest, 0, m_active.numChannels, 0, &transport);
+    }
+
+    //==========================================================================
+    // DTX (siehe setDtxEnabled())
+    //==========================================================================
+
+    bool canUseDtx() const
+    {
+        return m_dtxEnabled && m_active.payload != PayloadFormat::Opus;
+    }
+
+    // Nächstes Paket [readPosition, + packetSamples) komplett still, inkl.
+    // Hangover nach dem letzten hörbaren Block?
+    bool isPacketSilent() const
+    {
+        const auto hangover = (uint64_t)(m_active.sampleRate * DTX_HANGOVER_MS / 1000.0);
+        const auto loudEnd = m_loudEnd[(size_t)getReadSlot()].load(std::memory_order_acquire);
+        return m_transportTracker.getReadPosition() >= loudEnd + hangover;
+    }
+
+    // Ein Paket Stille per DTX. fromFifo: die stillen Samples liegen im FIFO
+    // und werden verworfen, sonst ist es ein Unterlauf.
+    int writeDtx(ThreadSafeFIFO& fifo, bool fromFifo, uint8_t* dest, int capacity)
+    {
+        if (fromFifo)
+            readPacket(fifo, [](const AudioRegion&) {});
+
+        m_dtxPendingSamples += (uint32_t)m_active.packetSamples;
+
+        const bool first = !m_dtxActive;
+        if (first)
+            m_dtxActive = true;
+
+        // RTP: einfach nichts schicken, endDtx() schiebt den Timestamp weiter
+        if (m_active.wire == WireFormat::Rtp)
+            return 0;
+
+        if (!first && juce::Time::getMillisecondCounter() - m_lastDtxMs < DTX_KEEPALIVE_MS)
+            return 0;
+
+        return writeDtxPacket(dest, capacity);
+    }
+
+    int writeDtxPacket(uint8_t* dest, int capacity)
+    {
+        if (capacity < (int)AudioPacket::HEADER_SIZE)
+            return 0;
+
+        const int bytes = writeNativeHeader(dest, AudioPacket::FLAG_DTX, m_active.numChannels,
+                                            (int)m_dtxPendingSamples);
+        m_dtxPendingSamples = 0;
+        m_lastDtxMs = juce::Time::getMillisecondCounter();
+        return bytes;
+    }
+
+    // Audio kommt wieder: die restliche Stille direkt melden, das Audio-Paket
+    // geht gleich danach im selben Durchlauf raus (keine Verzögerung)
+    void endDtx()
+    {
+        m_dtxActive = false;
+
+        if (m_dtxPendingSamples == 0)
+            return;
+
+        if (m_active.wire == WireFormat::Rtp)
+        {
+            m_rtp.markDiscontinuity(m_dtxPendingSamples);   // PCM: Clock = Sample Rate
+            m_dtxPendingSamples = 0;
+            return;
+        }
+
+        const int bytes = writeDtxPacket(m_dtxBuffer.data(), (int)m_dtxBuffer.size());
+        m_sender.sendToTarget(m_dtxBuffer.data(), bytes);
+    }
+
+    // Erstes Paket nach einer Auto-Pause
+    void resumeAfterPause()
+    {
+        m_transportPausedOnWire = false;
+        m_transportSent = false;   // gleich den aktuellen Stand mitschicken
+
+        // RTP Timestamp läuft über die Pause weiter, Marker Bit für den Neuanfang
+        if (m_active.wire == WireFormat::Rtp)
+        {
+            const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks()
+                                                                          - m_pauseStartTicks);
+            m_rtp.markDiscontinuity((uint32_t)(seconds * m_rtp.getClockRate()));
+        }
+
+        DBG("[Mix2Go] Resuming packets after auto-pause");
+    }
+
+   #if MIX2GO_WITH_OPUS
+    // Füttert den Encoder, false solange noch kein ganzer Frame da ist.
+    // Der fertige Frame liegt danach in m_opusFrame.
+    bool encodeOpus(const AudioRegion& region)
+    {
+        // Der Encoder resampled auf 48 kHz und braucht dafür zusammenhängende
+        // Daten, also hier doch einmal kopieren
+        const int numSamples = region.getNumSamples();
+        m_opusScratch.setSize(region.numChannels, numSamples, false, false, true);
+
+        if (region.channels == nullptr)
+        {
+            m_opusScratch.clear();
+        }
+        else
+        {
+            for (int ch = 0; ch < region.numChannels; ++ch)
+            {
+                auto* out = m_opusScratch.getWritePointer(ch);
+                juce::FloatVectorOperations::copy(out, region.channels[ch] + region.start1, region.size1);
+                juce::FloatVectorOperations::copy(out + region.size1, region.channels[ch] + region.start2, region.size2);
+            }
+        }
+
+        m_opus.pushSamples(m_opusScratch.getArrayOfReadPointers(), region.numChannels, numSamples,
+                           [this](const uint8_t* data, int bytes) {
+                               m_opusFrames.emplace_back(data, data + bytes);
+                           });
+
+        // Durch Rundung im Resampler kommt ab und zu ein Frame mehr raus,
+        // der geht dann mit dem nächsten Paket
+        if (m_opusFrames.empty())
+            return false;
+
+        m_opusFrame = std::move(m_opusFrames.front());
+        m_opusFrames.pop_front();
+        return true;
+    }
+   #endif
+
+    // Ein Paket (m_active.packetSamples) aus dem FIFO lesen, fn bekommt es
+    // direkt im Ringpuffer. Jedes gelesene Paket geht auch an die Vorschau,
+    // egal ob es gesendet, per DTX ersetzt oder verworfen wird.
+    template <typename PacketFunction>
+    bool readPacket(ThreadSafeFIFO& fifo, PacketFunction&& fn)
+    {
+        const int numSamples = m_active.packetSamples;
+
+        const bool ok = fifo.read(numSamples,
+                                  [&](const float* const* channels, int numChannels,
+                                      int start1, int size1, int start2, int size2)
+                                  {
+                                      AudioRegion region;
+                                      region.channels    = channels;
+                                      region.numChannels = numChannels;
+                                      region.start1 = start1;
+                                      region.size1  = size1;
+                                      region.start2 = start2;
+                                      region.size2  = size2;
+
+                                      m_preview.push(region);
+
+                                      region.numChannels = juce::jmin(numChannels, m_active.numChannels);
+                                      fn(region);
+                                  });
+
+        if (!ok)
+            return false;
+
+        consumeSamples(numSamples);
+        sendPreview();
+        return true;
+    }
+
+    // Fertige Vorschau-Pakete direkt an das Vorschau-Ziel
+    void sendPreview()
+    {
+        if (!m_preview.isEnabled())
+            return;
+
+        for (;;)
+        {
+            const int bytes = m_preview.writePacket(m_previewBuffer.data(), (int)m_previewBuffer.size());
+            if (bytes <= 0)
+                break;
+
+            m_sender.sendTo(m_previewIP, m_previewPort, m_previewBuffer.data(), bytes);
+        }
+    }
+
+    // Ein Paket aus dem FIFO wegwerfen, damit es nicht überläuft solange
+    // kein Empfänger zuhört
+    void discardPacket(ThreadSafeFIFO& fifo)
+    {
+        if (fifo.getNumReady() >= m_active.packetSamples)
+            readPacket(fifo, [](const AudioRegion&) {});
+    }
+
+    // Wird vom Network Thread aufgerufen, schreibt das nächste Datagramm
+    int fillDatagram(uint8_t* dest, int capacity)
+    {
+        switchToPendingConfig();
+
+        auto& fifo = getReadFifo();
+        const auto& config = m_active;
+
+        // Session verloren (Bye, Reports bleiben aus, kein gemeinsames
+        // Format): keine Bandbreite verschwenden
+        if (!m_sendAudio)
+        {
+            discardPacket(fifo);
+            return 0;
+        }
+
+        if (m_announceFormat)
+        {
+            m_announceFormat = false;
+            if (config.wire == WireFormat::Native)
+                return writeNativeDescriptor(dest, capacity);
+        }
+
         // Log new overruns
-        auto overruns = m_fifo.getOverrunCount();
+        auto overruns = fifo.getOverrunCount();
         if (overruns > m_lastLoggedOverruns)
         {
             DBG("[Mix2Go] FIFO overrun! total=" << (int)overruns
                 << " (+" << (int)(overruns - m_lastLoggedOverruns) << " new)"
-                << "  fifoLevel=" << m_fifo.getNumReady());
+                << "  fifoLevel=" << fifo.getNumReady());
             m_lastLoggedOverruns = overruns;
         }
 
         // Not enough samples yet — send a silence packet to keep sequence numbers
-        // continuous. Skipping (return false) would create a seq-number gap that
+        // continuous. Skipping (return 0) would create a seq-number gap that
         // the receiver treats as packet loss → silence injected on their side too.
-        if (m_fifo.getNumReady() < m_packetSamples)
+        if (fifo.getNumReady() < config.packetSamples)
         {
+            if (m_transportPaused.load(std::memory_order_acquire))
+                return writePauseNotice(dest, capacity);
+
             ++m_networkUnderruns;
             if (m_networkUnderruns == 1 || (m_networkUnderruns % 200) == 0)
-                DBG("[Mix2Go] FIFO underrun (net thread): ready=" << m_fifo.getNumReady()
-                    << " needed=" << m_packetSamples
+                DBG("[Mix2Go] FIFO underrun (net thread): ready=" << fifo.getNumReady()
+                    << " needed=" << config.packetSamples
                     << " total=" << (int)m_networkUnderruns);
 
-            // Fill packet with silence and send it — seq number stays continuous
-            packet.sampleRate  = (uint32_t)m_sampleRate;
-            packet.numChannels = (uint16_t)m_numChannels;
-            packet.numSamples  = (uint32_t)m_packetSamples;
-            packet.pcmData.assign((size_t)(m_numChannels * m_packetSamples), 0);
+            // Mit DTX reicht ein kleines Paket statt einem voller Nullen
+            if (canUseDtx())
+                return writeDtx(fifo, false, dest, capacity);
 
-            double ticksPerUs  = juce::Time::getHighResolutionTicksPerSecond() / 1000000.0;
-            packet.timestamp   = (uint64_t)((juce::Time::getHighResolutionTicks() - m_streamStartTime) / ticksPerUs);
-            packet.sequenceNumber = m_sequenceNumber++;
-            return true;
+            return writeAudio(AudioRegion::silence(config.numChannels, config.packetSamples),
+                              dest, capacity);
         }
 
-        // Temp Buffer
-        juce::AudioBuffer<float> tempBuffer(m_numChannels, m_packetSamples);
+        if (canUseDtx() && isPacketSilent())
+            return writeDtx(fifo, true, dest, capacity);
 
-        if (!m_fifo.pop(tempBuffer, m_packetSamples))
-            return false;
+        if (m_dtxActive)
+            endDtx();
 
-        // Paket füllen
-        packet.setFromBuffer(tempBuffer.getArrayOfReadPointers(),
-                             m_numChannels, m_packetSamples,
-                             (uint32_t)m_sampleRate);
+        if (m_transportPausedOnWire)
+            resumeAfterPause();
 
-        // Zeitstempel berechnen
-        double ticksPerMicrosecond = juce::Time::getHighResolutionTicksPerSecond() / 1000000.0;
-        auto ticksSinceStart = juce::Time::getHighResolutionTicks() - m_streamStartTime;
+        TransportInfo transport;
+        const bool withTransport = takeTransportUpdate(transport);
 
-        packet.timestamp      = (uint64_t)(ticksSinceStart / ticksPerMicrosecond);
-        packet.sequenceNumber = m_sequenceNumber++;
+        // Direkt aus dem Ringpuffer ins Datagramm konvertieren
+        int bytesWritten = 0;
+        readPacket(fifo, [&](const AudioRegion& region)
+        {
+            bytesWritten = writeAudio(region, dest, capacity, withTransport ? &transport : nullptr);
+        });
+
+        if (withTransport && bytesWritten > 0)
+            commitTransportUpdate(transport);
 
         // Periodic stats — every 200 packets (~1 second at 200 pkt/s)
-        if ((m_sequenceNumber % 200) == 0)
+        if (++m_packetsBuilt % 200 == 0)
         {
-            DBG("[Mix2Go] Stats: seq=" << m_sequenceNumber
+            DBG("[Mix2Go] Stats: pkt=" << (int)m_packetsBuilt
                 << "  sent=" << (int)m_sender.getPacketsSent()
-                << "  fifoLevel=" << m_fifo.getNumReady()
-                << "  overruns=" << (int)m_fifo.getOverrunCount()
+                << "  fifoLevel=" << fifo.getNumReady()
+                << "  overruns=" << (int)fifo.getOverrunCount()
                 << "  netUnderruns=" << (int)m_networkUnderruns
                 << "  KB=" << (int)(m_sender.getBytesSent() / 1024));
         }
 
-        return true;
+        return bytesWritten;
+    }
+
+    // Antworten der Empfänger (Network Thread)
+    void handleIncoming(const uint8_t* data, int size, bool controlSocket)
+    {
+        juce::ignoreUnused(controlSocket);
+
+        // RTCP kommt normal auf dem Control-Socket, bei rtcp-mux auch auf
+        // dem RTP Socket. handleRtcp() prüft selbst ob es RTCP ist.
+        if (m_active.wire == WireFormat::Rtp)
+        {
+            m_rtp.handleRtcp(data, size);
+            return;
+        }
+
+        // Talkback Audio nur innerhalb einer Session annehmen
+        if (AudioPacket::hasMagic(data, (size_t)size, AudioPacket::TALKBACK_MAGIC))
+        {
+            if (m_sessionEstablished)
+                m_talkback.pushPacket(data, size);
+            return;
+        }
+
+        switch (session::getMessageType(data, size))
+        {
+            case session::MessageType::Offer:
+            {
+                session::Offer offer;
+                session::read(data, offer);
+                handleOffer(offer);
+                break;
+            }
+
+            case session::MessageType::Report:
+            {
+                session::Report report;
+                session::read(data, report);
+                handleReport(report);
+                break;
+            }
+
+            case session::MessageType::MacroUpdate:
+            {
+                session::MacroValues update;
+                if (session::read(data, size, update)
+                    && update.sessionId == m_sessionId && m_sessionEstablished)
+                    m_remoteControl.postRemote(update);
+                break;
+            }
+
+            case session::MessageType::Bye:
+            {
+                session::Bye bye;
+                session::read(data, bye);
+
+                if (bye.sessionId == m_sessionId && m_sessionEstablished)
+                {
+                    DBG("[Mix2Go] Receiver left the session, pausing audio");
+                    endSession();
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    //==========================================================================
+    // Session (native Handshake, siehe SessionControl.h)
+    //==========================================================================
+
+    // Message Thread, bevor der Network Thread startet
+    void resetSession()
+    {
+        m_sessionId = (uint32_t)juce::Random::getSystemRandom().nextInt();
+        m_negotiated = {};
+        m_sessionEstablished = false;
+        m_reportDegraded = false;
+        m_announceFormat = false;
+        m_lastReport = {};
+        m_sessionStartMs = juce::Time::getMillisecondCounter();
+        m_lastHelloMs = m_sessionStartMs - session::HELLO_INTERVAL_MS;
+        m_lastReportMs = m_sessionStartMs;
+        m_lastRtcpReports = 0;
+        m_lastRtcpMs = m_sessionStartMs;
+        m_sessionStats.reportsReceived = 0;
+
+        // Audio erst nach dem Offer. Nur mit setLegacyReceiver(true) sofort
+        // im Host-Format (PCM16), siehe updateNativeSession().
+        m_sendAudio = m_legacyReceiver;
+    }
+
+    void endSession()
+    {
+        m_sessionEstablished = false;
+        m_sendAudio = false;
+        setState(StreamState::Error);
+    }
+
+    void sendSessionMessage(int numBytes)
+    {
+        m_sender.sendToTarget(m_sessionBuffer.data(), numBytes);
+    }
+
+    void sendHello()
+    {
+        const auto& host = m_configs[(size_t)getReadSlot()];
+
+        session::Hello hello;
+        hello.sessionId   = m_sessionId;
+        hello.sampleRate  = (uint32_t)host.sampleRate;
+        hello.numChannels = (uint16_t)host.numChannels;
+        hello.codecs      = session::getLocalCodecs();
+        sendSessionMessage(session::write(hello, m_sessionBuffer.data()));
+    }
+
+    void handleOffer(const session::Offer& offer)
+    {
+        // Offer für eine alte Session oder einen anderen Sender
+        if (offer.sessionId != m_sessionId)
+            return;
+
+        const auto& host = m_configs[(size_t)getReadSlot()];
+        const auto negotiated = session::negotiate(offer, host.sampleRate, host.numChannels,
+                                                   session::getLocalCodecs());
+
+        if (!negotiated.valid)
+        {
+            DBG("[Mix2Go] Handshake failed: " << negotiated.error);
+
+            session::Bye bye;
+            bye.sessionId = m_sessionId;
+            sendSessionMessage(session::write(bye, m_sessionBuffer.data()));
+            endSession();
+            return;
+        }
+
+        // Offer kommt auch nochmal wenn die Answer verloren ging, dann
+        // einfach die gleiche Answer nochmal schicken
+        m_negotiated = negotiated;
+        activateConfig(host);
+
+        session::Answer answer;
+        answer.sessionId         = m_sessionId;
+        answer.sampleRate        = getWireSampleRate();
+        answer.numChannels       = (uint16_t)m_active.numChannels;
+        answer.codec             = session::getCodecBit(m_active.payload);
+        answer.packetSamples     = (uint16_t)getWirePacketSamples();
+        answer.preferredBufferMs = (uint16_t)negotiated.preferredBufferMs;
+        answer.talkbackCodecs    = m_talkbackEnabled ? TalkbackReceiver::getSupportedCodecs() : 0;
+        sendSessionMessage(session::write(answer, m_sessionBuffer.data()));
+
+        if (!m_sessionEstablished)
+        {
+            // Neuer Empfänger braucht einmal den kompletten Macro-Stand
+            m_remoteControl.requestFullState();
+
+            DBG("[Mix2Go] Session established: codec=" << (int)answer.codec
+                << " SR=" << (int)answer.sampleRate
+                << " ch=" << m_active.numChannels
+                << " packetSamples=" << m_active.packetSamples
+                << " (~" << m_active.getPacketBytes() << " bytes/pkt)"
+                << " buffer=" << negotiated.preferredBufferMs << " ms");
+        }
+
+        m_sessionEstablished = true;
+        m_sendAudio = true;
+        m_announceFormat = true;
+        m_reportDegraded = false;
+        m_lastReportMs = juce::Time::getMillisecondCounter();
+        setState(StreamState::Streaming);
+    }
+
+    void handleReport(const session::Report& report)
+    {
+        if (report.sessionId != m_sessionId || !m_sessionEstablished)
+            return;
+
+        // Differenz zum letzten Report, die Zähler sind kumulativ
+        const uint32_t received = report.packetsReceived - m_lastReport.packetsReceived;
+        const uint32_t lost = report.packetsLost - m_lastReport.packetsLost;
+        const uint32_t total = received + lost;
+        const float lossRatio = total > 0 ? (float)lost / (float)total : 0.0f;
+
+        const bool underruns = report.underruns != m_lastReport.underruns;
+        const bool lowBuffer = m_negotiated.preferredBufferMs > 0
+                               && (int)report.bufferMs < m_negotiated.preferredBufferMs / 2;
+
+        m_reportDegraded = lossRatio > session::DEGRADED_LOSS_RATIO || underruns || lowBuffer;
+        m_lastReport = report;
+        m_lastReportMs = juce::Time::getMillisecondCounter();
+
+        m_sessionStats.lossPercent = lossRatio * 100.0f;
+        m_sessionStats.jitterMs = (float)report.jitterUs / 1000.0f;
+        m_sessionStats.bufferMs = (int)report.bufferMs;
+        ++m_sessionStats.reportsReceived;
+    }
+
+    void updateNativeSession(uint32_t now)
+    {
+        if (!m_sessionEstablished)
+        {
+            // Legacy nur solange die Session nicht beendet wurde (Bye, Reports
+            // weg), dann gilt wie sonst: erst das nächste Offer
+            const bool legacy = m_legacyReceiver && m_state != StreamState::Error;
+            m_sendAudio = legacy;
+
+            if (legacy)
+                setState(StreamState::Streaming);
+            else if (m_state == StreamState::Streaming)
+                setState(StreamState::Connecting);   // Legacy gerade ausgeschaltet
+
+            // Nach einem Fehler (oder im Legacy-Modus) nur noch selten anklopfen
+            const auto interval = m_state == StreamState::Connecting ? session::HELLO_INTERVAL_MS
+                                                                     : session::PROBE_INTERVAL_MS;
+            if (now - m_lastHelloMs >= interval)
+            {
+                sendHello();
+                m_lastHelloMs = now;
+            }
+
+            // Kein Offer: Error, ab jetzt nur noch im Probe-Intervall. Ein
+            // späteres Offer baut die Session trotzdem noch auf.
+            if (m_state == StreamState::Connecting && now - m_sessionStartMs >= session::CONNECT_TIMEOUT_MS)
+            {
+                DBG("[Mix2Go] No handshake from " << m_targetIP << ":" << m_targetPort << ", probing every "
+                    << (int)session::PROBE_INTERVAL_MS << " ms");
+                setState(StreamState::Error);
+            }
+            return;
+        }
+
+        const auto silence = now - m_lastReportMs;
+
+        if (silence >= session::LOST_TIMEOUT_MS)
+        {
+            DBG("[Mix2Go] No reports for " << (int)silence << " ms, pausing audio");
+            endSession();
+            return;
+        }
+
+        setState(silence >= session::REPORT_TIMEOUT_MS || m_reportDegraded ? StreamState::Degraded
+                                                                           : StreamState::Streaming);
+
+        // Neueste Meter-Daten, der Analyse Thread liefert ca. 30 pro Sekunde
+        MeterFrame meters;
+        if (m_meters.takeLatest(meters))
+            sendSessionMessage(session::write(m_sessionId, meters, m_sessionBuffer.data()));
+
+        // Geänderte Macros gesammelt zurückschicken, höchstens 30 mal pro Sekunde
+        if (now - m_lastEchoMs >= RemoteControl::ECHO_INTERVAL_MS)
+        {
+            session::MacroValues state;
+            state.sessionId = m_sessionId;
+
+            if (m_remoteControl.takeState(state))
+            {
+                sendSessionMessage(session::write(state, session::MessageType::MacroState,
+                                                  m_sessionBuffer.data()));
+                m_lastEchoMs = now;
+            }
+        }
+    }
+
+    // RTP: RTCP Receiver Reports sind die Reports. Player ohne RTCP
+    // bekommen einfach weiter Audio.
+    void updateRtpSession(uint32_t now)
+    {
+        if (m_rtp.isSenderReportDue())
+        {
+            const int bytes = m_rtp.writeSenderReport(m_controlBuffer.data(), (int)m_controlBuffer.size());
+            if (bytes > 0)
+                m_sender.sendControl(m_controlBuffer.data(), bytes, m_targetPort + 1);
+        }
+
+        const auto& stats = m_rtp.getStats();
+        const auto reports = stats.reportsReceived.load();
+
+        if (reports != m_lastRtcpReports)
+        {
+            m_lastRtcpReports = reports;
+            m_lastRtcpMs = now;
+
+            if (!m_sendAudio)
+            {
+                DBG("[Mix2Go] RTCP receiver reports are back, resuming audio");
+                m_sendAudio = true;
+            }
+        }
+
+        if (reports == 0 || !m_sendAudio)
+            return;
+
+        if (now - m_lastRtcpMs >= RtpSession::RECEIVER_TIMEOUT_MS)
+        {
+            DBG("[Mix2Go] No RTCP receiver reports, pausing audio");
+            m_sendAudio = false;
+            setState(StreamState::Error);
+            return;
+        }
+
+        setState(stats.fractionLost.load() > session::DEGRADED_LOSS_RATIO ? StreamState::Degraded
+                                                                          : StreamState::Streaming);
+    }
+
+    // Einmal pro Sende-Durchlauf (Network Thread)
+    void onNetworkTick()
+    {
+        const auto now = juce::Time::getMillisecondCounter();
+
+        if (m_active.wire == WireFormat::Rtp)
+            updateRtpSession(now);
+        else
+            updateNativeSession(now);
     }
-    
-    double m_sampleRate = 44100.0;
-    int m_samplesPerBlock = 512;
-    int m_numChannels = 2;
-    int m_packetSamples = 441;
     
     juce::String m_targetIP = "127.0.0.1";
     int m_targetPort = 12345;
     
-    ThreadSafeFIFO m_fifo;
+    // Doppelt gepuffertes Format + FIFO (siehe prepare())
+    std::array<StreamConfig, 2> m_configs;
+    std::array<ThreadSafeFIFO, 2> m_fifos;
+    std::atomic<int> m_writeSlot { 0 };  // Audio Thread schreibt in diesen Slot
+    std::atomic<int> m_readSlot { 0 };   // Network Thread liest aus diesem Slot
+    std::atomic<bool> m_forceSwitch { false }; // prepare() wartet auf den Wechsel
+    juce::SpinLock m_configLock;
+    static constexpr int PENDING_SWITCH_TIMEOUT_MS = 250;
+
     NetworkSender m_sender;
+
+    // Was der Network Thread gerade sendet: Host-Format aus m_configs plus
+    // Ergebnis vom Handshake. Gehört dem Network Thread.
+    StreamConfig m_active;
+
+    WireFormat m_wireFormat = WireFormat::Native;
+    PayloadFormat m_payloadFormat = PayloadFormat::Pcm16;
+    RtpSession m_rtp;
+
+    std::atomic<Transport> m_transport { Transport::Udp };
+    juce::String m_sharedMemoryName { shm::DEFAULT_NAME };
+    SharedMemoryTransport m_sharedMemory;
+
+    // Host Transport. m_transportPaused: Audio Thread → Network Thread,
+    // der Rest gehört dem Network Thread.
+    TransportTracker m_transportTracker;
+    std::atomic<bool> m_autoPause { false };
+    std::atomic<bool> m_transportPaused { false };
+    bool m_transportPausedOnWire = false;
+    bool m_transportSent = false;
+    TransportInfo m_lastTransport;
+    uint64_t m_samplesSinceTransport = 0;
+    uint32_t m_lastTransportMs = 0;
+    uint32_t m_lastPauseNoticeMs = 0;
+    juce::int64 m_pauseStartTicks = 0;
+
+    // DTX. m_loudEnd: Audio Thread → Network Thread (pro Slot, Position im
+    // FIFO hinter dem letzten hörbaren Block), der Rest gehört dem Network
+    // Thread (m_dtxActive ist atomic für die GUI).
+    std::atomic<bool> m_dtxEnabled { false };
+    std::atomic<bool> m_legacyReceiver { false };
+    std::array<std::atomic<uint64_t>, 2> m_loudEnd {};
+    std::atomic<bool> m_dtxActive { false };
+    uint32_t m_dtxPendingSamples = 0;
+    uint32_t m_lastDtxMs = 0;
+    std::array<uint8_t, AudioPacket::HEADER_SIZE> m_dtxBuffer {};
+
+    // Vorschau (Ziel nur ändern wenn nicht gestreamt wird)
+    PreviewStream m_preview;
+    juce::String m_previewIP;
+    int m_previewPort = 0;
+    std::array<uint8_t, AudioPacket::HEADER_SIZE + PreviewStream::MAX_PAYLOAD_BYTES> m_previewBuffer {};
+
+    RemoteControl m_remoteControl;
+    TalkbackReceiver m_talkback;
+    MeterAnalyzer m_meters;
+    std::atomic<MeteringMode> m_meteringMode { MeteringMode::Levels };
+    std::atomic<bool> m_talkbackEnabled { false };
+    std::array<uint8_t, 512> m_controlBuffer {};
+
+   #if MIX2GO_WITH_OPUS
+    MixOpusEncoder m_opus;
+    juce::AudioBuffer<float> m_opusScratch;
+    std::deque<std::vector<uint8_t>> m_opusFrames;
+    std::vector<uint8_t> m_opusFrame;
+   #endif
+
+    // Session (Network Thread, vor dem Start vom Message Thread gesetzt)
+    uint32_t m_sessionId = 0;
+    session::Negotiated m_negotiated;
+    session::Report m_lastReport;
+    bool m_sessionEstablished = false;
+    bool m_sendAudio = false;
+    bool m_reportDegraded = false;
+    bool m_announceFormat = false;
+    uint32_t m_sessionStartMs = 0;
+    uint32_t m_lastHelloMs = 0;
+    uint32_t m_lastReportMs = 0;
+    uint32_t m_lastEchoMs = 0;
+    uint64_t m_lastRtcpReports = 0;
+    uint32_t m_lastRtcpMs = 0;
+    std::array<uint8_t, session::MAX_MESSAGE_SIZE> m_sessionBuffer {};
+    SessionStats m_sessionStats;
     
-    StreamState m_state = StreamState::Disconnected;
+    std::atomic<StreamState> m_state { StreamState::Disconnected };
     std::atomic<bool> m_isStreaming { false };
     std::atomic<int> m_silentBlocks { 0 };
     uint32_t m_sequenceNumber = 0;
@@ -323,6 +1725,7 @@ private:
     uint64_t m_lastLoggedOverruns = 0;
     
     uint64_t m_networkUnderruns = 0;
+    uint64_t m_packetsBuilt = 0;
 
     juce::CriticalSection m_listenerLock;
     juce::Array<StreamListener*> m_listeners;
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace mix2go {
+namespace streaming {
+
+// 2:1 Dezimierung mit einem Halbband-FIR (Kaiser-Fenster, ca. 70 dB
+// Sperrdämpfung, Durchlass bis ca. 0.43 der neuen Sample Rate).
+//
+// Beim Halbband ist jeder zweite Koeffizient 0 und der mittlere 0.5, und
+// weil nur jedes zweite Ausgangssample gebraucht wird, bleiben pro Sample
+// NUM_SIDE_TAPS Multiplikationen. Gerechnet wird blockweise pro Koeffizient
+// über den ganzen Block (FloatVectorOperations, also SIMD) statt pro Sample:
+//
+//   y[m] = 0.5 * even[m - P] + sum_j c_j * (odd[m - P - j - 1] + odd[m - P + j])
+//
+// Latenz: NUM_SIDE_TAPS Samples bei der Ausgangsrate.
+class HalfBandDecimator
+{
+public:
+    static constexpr int NUM_SIDE_TAPS = 16;   // P, ergibt 4P - 1 = 63 Taps
+
+    HalfBandDecimator()
+    {
+        designCoefficients();
+    }
+
+    // Message / Network Thread, nicht während process()
+    void prepare(int maxInputSamples)
+    {
+        const int maxOutput = maxInputSamples / 2 + 1;
+        m_even.assign((size_t)(NUM_SIDE_TAPS + maxOutput), 0.0f);
+        m_odd.assign((size_t)(2 * NUM_SIDE_TAPS + maxOutput), 0.0f);
+        m_pairSum.assign((size_t)maxOutput, 0.0f);
+        m_maxInput = maxInputSamples;
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill(m_even.begin(), m_even.end(), 0.0f);
+        std::fill(m_odd.begin(), m_odd.end(), 0.0f);
+        m_hasPending = false;
+    }
+
+    // Gibt die Anzahl Ausgangssamples zurück (numInput / 2, bei ungeraden
+    // Blöcken wartet ein Sample auf den nächsten Aufruf). output braucht
+    // Platz für numInput / 2 + 1 Samples, input und output dürfen gleich sein.
+    int process(const float* input, int numInput, float* output)
+    {
+        jassert(numInput <= m_maxInput);
+
+        // Neue Samples hinter die History, getrennt nach gerade / ungerade
+        float* even = m_even.data() + NUM_SIDE_TAPS;
+        float* odd = m_odd.data() + 2 * NUM_SIDE_TAPS;
+        int numOut = 0;
+        int i = 0;
+
+        if (m_hasPending && numInput > 0)
+        {
+            even[0] = m_pending;
+            odd[0] = input[0];
+            numOut = 1;
+            i = 1;
+        }
+
+        for (; i + 1 < numInput; i += 2, ++numOut)
+        {
+            even[numOut] = input[i];
+            odd[numOut] = input[i + 1];
+        }
+
+        m_hasPending = i < numInput;
+        if (m_hasPending)
+            m_pending = input[i];
+
+        if (numOut == 0)
+            return 0;
+
+        // Mittlerer Tap
+        juce::FloatVectorOperations::multiply(output, m_even.data(), 0.5f, numOut);
+
+        // Symmetrische Paare: erst addieren, dann einmal multiplizieren
+        for (int j = 0; j < NUM_SIDE_TAPS; ++j)
+        {
+            juce::FloatVectorOperations::add(m_pairSum.data(),
+                                             m_odd.data() + (NUM_SIDE_TAPS - j - 1),
+                                             m_odd.data() + (NUM_SIDE_TAPS + j),
+                                             numOut);
+            juce::FloatVectorOperations::addWithMultiply(output, m_pairSum.data(),
+                                                         m_coefficients[(size_t)j], numOut);
+        }
+
+        // History für den nächsten Block nach vorne
+        std::memmove(m_even.data(), m_even.data() + numOut, (size_t)NUM_SIDE_TAPS * sizeof(float));
+        std::memmove(m_odd.data(), m_odd.data() + numOut, (size_t)(2 * NUM_SIDE_TAPS) * sizeof(float));
+
+        return numOut;
+    }
+
+private:
+    // c_j = h[2j + 1], windowed sinc mit Kaiser (beta 7), normiert auf DC = 1
+    void designCoefficients()
+    {
+        constexpr double beta = 7.0;
+        constexpr double halfLength = 2.0 * NUM_SIDE_TAPS;   // n läuft bis +-(2P - 1)
+
+        double sum = 0.0;
+        for (int j = 0; j < NUM_SIDE_TAPS; ++j)
+        {
+            const double n = 2.0 * j + 1.0;
+            const double sinc = std::sin(juce::MathConstants<double>::halfPi * n)
+                              / (juce::MathConstants<double>::pi * n);
+            const double ratio = n / halfLength;
+            const double window = besselI0(beta * std::sqrt(1.0 - ratio * ratio)) / besselI0(beta);
+
+            m_coefficients[(size_t)j] = (float)(sinc * window);
+            sum += sinc * window;
+        }
+
+        // 0.5 + 2 * sum(c) = 1
+        const double scale = 0.25 / sum;
+        for (auto& c : m_coefficients)
+            c = (float)(c * scale);
+    }
+
+    static double besselI0(double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    std::array<float, NUM_SIDE_TAPS> m_coefficients {};
+
+    // [History | neue Samples] pro Phase
+    std::vector<float> m_even;
+    std::vector<float> m_odd;
+    std::vector<float> m_pairSum;
+    int m_maxInput = 0;
+
+    float m_pending = 0.0f;
+    bool m_hasPending = false;
+};
+
+} // namespace streaming
+} // namespace mix2go
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <cmath>
+#include "ThreadSafeFIFO.h"
+
+namespace mix2go {
+namespace streaming {
+
+// Ein Satz Meter-Daten so wie er an die Empfänger geht.
+// Pegel als Byte: 0 = 0 dBFS, 0.5 dB Schritte, 255 = -127.5 dB oder leiser.
+struct MeterFrame
+{
+    static constexpr int MAX_CHANNELS = 2;
+    static constexpr int NUM_BANDS = 32;
+
+    uint8_t numChannels = 0;
+    uint8_t numBands = 0;      // 0 = kein Spektrum
+    std::array<uint8_t, MAX_CHANNELS> peak {};
+    std::array<uint8_t, MAX_CHANNELS> rms {};
+    std::array<uint8_t, NUM_BANDS> bands {};
+
+    static uint8_t toByte(float gain)
+    {
+        const float db = juce::Decibels::gainToDecibels(gain, -127.5f);
+        return (uint8_t)juce::jlimit(0, 255, (int)std::lround(-db * 2.0f));
+    }
+};
+
+// Meter (Peak/RMS pro Kanal) und optional ein 32-Band Spektrum, einmal im
+// Plugin berechnet statt auf jedem Handy. Läuft in einem eigenen Thread mit
+// ca. 30 Hz, der Audio Thread kopiert nur in ein FIFO.
+//
+//   Audio Thread    → push()        Block ins Analyse-FIFO
+//   Analyse Thread  → alle 33 ms auswerten, MeterFrame ablegen
+//   Network Thread  → takeLatest()  neuesten Frame abholen und senden
+class MeterAnalyzer : private juce::Thread
+{
+public:
+    static constexpr int UPDATE_RATE_HZ = 30;
+    static constexpr int FFT_ORDER = 11;               // 2048 Punkte, ~23 Hz Auflösung @ 48 kHz
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+
+    MeterAnalyzer() : juce::Thread("Mix2Go Meter Analysis") {}
+
+    ~MeterAnalyzer() override
+    {
+        stop();
+    }
+
+    // Message Thread (prepareToPlay). Hält den Thread kurz an, falls er läuft.
+    void prepare(double sampleRate, int numChannels)
+    {
+        const bool wasRunning = isThreadRunning();
+        stop();
+
+        m_numChannels = juce::jlimit(1, MeterFrame::MAX_CHANNELS, numChannels);
+        m_fifo.prepare(m_numChannels, (int)(sampleRate * 0.25));
+        m_history.assign((size_t)FFT_SIZE, 0.0f);
+        m_historyPos = 0;
+
+        // Logarithmische Bänder 20 Hz .. 20 kHz, mindestens ein Bin pro Band
+        const double nyquistBin = FFT_SIZE / 2;
+        int previous = 1;
+        for (int b = 0; b <= MeterFrame::NUM_BANDS; ++b)
+        {
+            const double hz = 20.0 * std::pow(1000.0, (double)b / MeterFrame::NUM_BANDS);
+            const int bin = (int)juce::jlimit(1.0, nyquistBin, std::round(hz * FFT_SIZE / sampleRate));
+            m_bandEdges[(size_t)b] = b == 0 ? bin : juce::jmin((int)nyquistBin, juce::jmax(bin, previous + 1));
+            previous = m_bandEdges[(size_t)b];
+        }
+
+        if (wasRunning)
+            start();
+    }
+
+    void setSpectrumEnabled(bool shouldBeEnabled) { m_spectrumEnabled = shouldBeEnabled; }
+
+    void start()
+    {
+        if (isThreadRunning())
+            return;
+
+        m_fifo.reset();
+        m_frames.reset();
+        startThread(juce::Thread::Priority::low);
+    }
+
+    void stop()
+    {
+        if (isThreadRunning())
+            stopThread(1000);
+    }
+
+    // Audio Thread
+    void push(const juce::AudioBuffer<float>& buffer)
+    {
+        if (isThreadRunning())
+            m_fifo.push(buffer);
+    }
+
+    // Network Thread: neuesten Frame holen, ältere werden verworfen
+    bool takeLatest(MeterFrame& frame)
+    {
+        int start1, size1, start2, size2;
+        m_frames.prepareToRead(m_frames.getNumReady(), start1, size1, start2, size2);
+
+        const int count = size1 + size2;
+        if (count == 0)
+            return false;
+
+        frame = m_frameSlots[(size_t)(size2 > 0 ? start2 + size2 - 1 : start1 + size1 - 1)];
+        m_frames.finishedRead(count);
+        return true;
+    }
+
+private:
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            wait(1000 / UPDATE_RATE_HZ);
+            analyse();
+        }
+    }
+
+    void analyse()
+    {
+        const int ready = m_fifo.getNumReady();
+        if (ready == 0)
+            return;
+
+        MeterFrame frame;
+        frame.numChannels = (uint8_t)m_numChannels;
+
+        std::array<float, MeterFrame::MAX_CHANNELS> peak {};
+        std::array<double, MeterFrame::MAX_CHANNELS> sumSquares {};
+
+        m_fifo.read(ready, [&](const float* const* channels, int numChannels,
+                               int start1, int size1, int start2, int size2)
+        {
+            const int channelsToRead = juce::jmin(numChannels, m_numChannels);
+
+            auto analyseRange = [&](int start, int size)
+            {
+                if (size <= 0)
+                    return;
+
+                for (int ch = 0; ch < channelsToRead; ++ch)
+                {
+                    const float* data = channels[ch] + start;
+                    const auto range = juce::FloatVectorOperations::findMinAndMax(data, size);
+                    peak[(size_t)ch] = juce::jmax(peak[(size_t)ch], -range.getStart(), range.getEnd());
+
+                    double sum = 0.0;
+                    for (int i = 0; i < size; ++i)
+                        sum += (double)data[i] * data[i];
+                    sumSquares[(size_t)ch] += sum;
+                }
+
+                // Mono-Summe für das Spektrum
+                if (m_spectrumEnabled)
+                {
+                    const float gain = 1.0f / (float)channelsToRead;
+                    for (int i = 0; i < size; ++i)
+                    {
+                        float sum = 0.0f;
+                        for (int ch = 0; ch < channelsToRead; ++ch)
+                            sum += channels[ch][start + i];
+
+                        m_history[(size_t)m_historyPos] = sum * gain;
+                        m_historyPos = (m_historyPos + 1) & (FFT_SIZE - 1);
+                    }
+                }
+            };
+
+            analyseRange(start1, size1);
+            analyseRange(start2, size2);
+        });
+
+        for (int ch = 0; ch < m_numChannels; ++ch)
+        {
+            frame.peak[(size_t)ch] = MeterFrame::toByte(peak[(size_t)ch]);
+            frame.rms[(size_t)ch] = MeterFrame::toByte((float)std::sqrt(sumSquares[(size_t)ch] / ready));
+        }
+
+        if (m_spectrumEnabled)
+            analyseSpectrum(frame);
+
+        int start1, size1, start2, size2;
+        m_frames.prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 > 0)
+        {
+            m_frameSlots[(size_t)start1] = frame;
+            m_frames.finishedWrite(1);
+        }
+    }
+
+    void analyseSpectrum(MeterFrame& frame)
+    {
+        // Die letzten FFT_SIZE Samples in zeitlicher Reihenfolge, mit Fenster
+        for (int i = 0; i < FFT_SIZE; ++i)
+            m_fftData[(size_t)i] = m_history[(size_t)((m_historyPos + i) & (FFT_SIZE - 1))];
+
+        std::fill(m_fftData.begin() + FFT_SIZE, m_fftData.end(), 0.0f);
+        m_window.multiplyWithWindowingTable(m_fftData.data(), (size_t)FFT_SIZE);
+        m_fft.performFrequencyOnlyForwardTransform(m_fftData.data(), true);
+
+        // Hann hat 0.5 Coherent Gain: Vollaussteuerung-Sinus = FFT_SIZE / 4
+        const float scale = 4.0f / (float)FFT_SIZE;
+
+        for (int b = 0; b < MeterFrame::NUM_BANDS; ++b)
+        {
+            float maxMagnitude = 0.0f;
+            for (int bin = m_bandEdges[(size_t)b]; bin < m_bandEdges[(size_t)b + 1]; ++bin)
+                maxMagnitude = juce::jmax(maxMagnitude, m_fftData[(size_t)bin]);
+
+            frame.bands[(size_t)b] = MeterFrame::toByte(maxMagnitude * scale);
+        }
+
+        frame.numBands = (uint8_t)MeterFrame::NUM_BANDS;
+    }
+
+    ThreadSafeFIFO m_fifo;
+    int m_numChannels = 2;
+    std::atomic<bool> m_spectrumEnabled { false };
+
+    // Nur Analyse Thread
+    std::vector<float> m_history;
+    int m_historyPos = 0;
+    juce::dsp::FFT m_fft { FFT_ORDER };
+    juce::dsp::WindowingFunction<float> m_window { (size_t)FFT_SIZE, juce::dsp::WindowingFunction<float>::hann, false };
+    std::array<float, FFT_SIZE * 2> m_fftData {};
+    std::array<int, MeterFrame::NUM_BANDS + 1> m_bandEdges {};
+
+    // Analyse Thread → Network Thread
+    juce::AbstractFifo m_frames { 4 };
+    std::array<MeterFrame, 4> m_frameSlots {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeterAnalyzer)
+};
+
+} // namespace streaming
+} // namespace mix2go
@@ -20,10 +20,24 @@ namespace streaming {
 class NetworkSender : public juce::Thread
 {
 public:
-    using AudioDataCallback = std::function<bool(AudioPacket&)>;
-    
+    // Schreibt das nächste Datagramm nach dest, gibt die Anzahl Bytes zurück
+    // (0 = diesmal nichts senden)
+    using AudioDataCallback = std::function<int(uint8_t* dest, int capacity)>;
+
+    // Eingehende Datagramme (RTCP, Antworten der Empfänger ...)
+    // controlSocket = true wenn es auf dem Control-Socket ankam
+    using ReceiveCallback = std::function<void(const uint8_t* data, int size, bool controlSocket)>;
+
+    // Wird einmal pro Durchlauf vom Network Thread aufgerufen (Reports usw)
+    using TickCallback = std::function<void()>;
+
+    // Größtes UDP Datagramm
+    static const int MAX_DATAGRAM_SIZE = 65507;
+
     NetworkSender()
-        : juce::Thread("Mix2Go Network Sender")
+        : juce::Thread("Mix2Go Network Sender"),
+          m_datagram((size_t)MAX_DATAGRAM_SIZE),
+          m_receiveBuffer((size_t)MAX_DATAGRAM_SIZE)
     {
     }
     
@@ -45,11 +59,53 @@ public:
     {
         m_audioCallback = callback;
     }
+
+    void setReceiveCallback(ReceiveCallback callback)
+    {
+        m_receiveCallback = callback;
+    }
+
+    void setTickCallback(TickCallback callback)
+    {
+        m_tickCallback = callback;
+    }
+
+    // Vom Control-Socket an die Ziel-IP senden (z.B. RTCP an Port + 1).
+    // Nur aus den Callbacks heraus aufrufen (Network Thread).
+    bool sendControl(const uint8_t* data, int size, int port)
+    {
+        if (!m_controlSocket || size <= 0)
+            return false;
+
+        return m_controlSocket->write(m_activeTargetIP, port, data, size) == size;
+    }
+
+    // An den Ziel-Port vom Audio-Socket senden (z.B. Steuer-Nachrichten).
+    // Nur aus den Callbacks heraus aufrufen (Network Thread).
+    bool sendToTarget(const uint8_t* data, int size)
+    {
+        if (!m_socket || size <= 0)
+            return false;
+
+        return m_socket->write(m_activeTargetIP, m_activeTargetPort, data, size) == size;
+    }
     
+    // An eine beliebige Adresse vom Audio-Socket senden (z.B. Vorschau-Stream).
+    // Nur aus den Callbacks heraus aufrufen (Network Thread).
+    bool sendTo(const juce::String& ipAddress, int port, const uint8_t* data, int size)
+    {
+        if (!m_socket || size <= 0)
+            return false;
+
+        return m_socket->write(ipAddress, port, data, size) == size;
+    }
+
     // Interval ändern (double für sample-genaue Berechnung, z.B. 4.9887ms)
+    // Darf auch während dem Senden aufgerufen werden, der Thread übernimmt
+    // den neuen Wert ab dem nächsten Paket.
     void setSendInterval(double intervalMs)
     {
-        m_sendIntervalMs = intervalMs;
+        m_sendIntervalMs.store(intervalMs, std::memory_order_relaxed);
     }
     
     bool start()
@@ -71,6 +127,14 @@ public:
             return false;
         }
 
+        m_controlSocket = std::make_unique<juce::DatagramSocket>();
+
+        if (!m_controlSocket->bindToPort(0))
+        {
+            DBG("[Mix2Go] Fehler: Control Socket Bind geht nicht");
+            m_controlSocket.reset();
+        }
+
         startThread();
         return true;
     }
@@ -85,6 +149,7 @@ public:
         }
         
         m_socket.reset();
+        m_controlSocket.reset();
     }
     
     bool isActive()
@@ -114,6 +179,9 @@ private:
             targetPort = m_targetPort;
         }
         
+        m_activeTargetIP   = targetIP;
+        m_activeTargetPort = targetPort;
+
         DBG("Sender läuft. Ziel: " << targetIP << ":" << targetPort);
 
         // Windows-Timer auf 1ms stellen damit sleep() genau ist
@@ -126,20 +194,21 @@ private:
 
         // Absolutes Scheduling: nächsten Send-Zeitpunkt vorausberechnen
         // Fehler akkumulieren sich NICHT über Zeit → kein systematischer Drift
-        const juce::int64 intervalTicks = (juce::int64)(m_sendIntervalMs * ticksPerMs);
+        double intervalMs = m_sendIntervalMs.load(std::memory_order_relaxed);
+        juce::int64 intervalTicks = (juce::int64)(intervalMs * ticksPerMs);
         juce::int64 nextSendTick = juce::Time::getHighResolutionTicks() + intervalTicks;
 
         while (!threadShouldExit() && !m_shouldStop)
         {
-            AudioPacket packet;
+            const int datagramSize = m_audioCallback
+                                         ? m_audioCallback(m_datagram.data(), (int)m_datagram.size())
+                                         : 0;
 
-            if (m_audioCallback && m_audioCallback(packet))
+            if (datagramSize > 0)
             {
-                auto data = packet.serialize();
-
                 int bytesSent = m_socket->write(
                     targetIP, targetPort,
-                    data.data(), (int)data.size()
+                    m_datagram.data(), datagramSize
                 );
 
                 if (bytesSent > 0)
@@ -173,6 +242,14 @@ private:
                 }
             }
 
+            pollIncoming(*m_socket, false);
+
+            if (m_controlSocket)
+                pollIncoming(*m_controlSocket, true);
+
+            if (m_tickCallback)
+                m_tickCallback();
+
             // Absolutes Timing: schlafen bis zum nächsten geplanten Zeitpunkt
             auto now      = juce::Time::getHighResolutionTicks();
             auto remaining = nextSendTick - now;
@@ -189,6 +266,15 @@ private:
                 nextSendTick = now;
             }
             nextSendTick += intervalTicks;
+
+            // Hot reconfiguration: the callback may have switched to a new
+            // stream format, pick up its interval from the next packet on
+            const double requestedMs = m_sendIntervalMs.load(std::memory_order_relaxed);
+            if (requestedMs != intervalMs)
+            {
+                intervalMs    = requestedMs;
+                intervalTicks = (juce::int64)(intervalMs * ticksPerMs);
+            }
         }
 
         #if JUCE_WINDOWS
@@ -197,9 +283,39 @@ private:
 
         DBG("Sender gestoppt");
     }
+
+    // Alles abholen was schon da ist, ohne zu blockieren
+    void pollIncoming(juce::DatagramSocket& socket, bool controlSocket)
+    {
+        // Begrenzen damit ein Flood den Sende-Takt nicht kaputt macht
+        for (int i = 0; i < 16 && socket.waitUntilReady(true, 0) == 1; ++i)
+        {
+            juce::String senderIP;
+            int senderPort = 0;
+
+            const int bytesRead = socket.read(m_receiveBuffer.data(), (int)m_receiveBuffer.size(),
+                                              false, senderIP, senderPort);
+            if (bytesRead <= 0)
+                break;
+
+            if (m_receiveCallback)
+                m_receiveCallback(m_receiveBuffer.data(), bytesRead, controlSocket);
+        }
+    }
     
     std::unique_ptr<juce::DatagramSocket> m_socket;
+    std::unique_ptr<juce::DatagramSocket> m_controlSocket;
     AudioDataCallback m_audioCallback;
+    ReceiveCallback m_receiveCallback;
+    TickCallback m_tickCallback;
+
+    // Einmal angelegt, vom Network Thread wiederverwendet
+    std::vector<uint8_t> m_datagram;
+    std::vector<uint8_t> m_receiveBuffer;
+
+    // Kopie der Zieladresse für den laufenden Thread
+    juce::String m_activeTargetIP;
+    int m_activeTargetPort = 0;
     
     juce::CriticalSection m_settingsLock;
     juce::String m_targetIP = "127.0.0.1";
@@ -207,7 +323,7 @@ private:
     
     // simple state variables
     bool m_shouldStop = false;
-    double m_sendIntervalMs = 10.0;
+    std::atomic<double> m_sendIntervalMs { 10.0 };
     
     // stats
     std::atomic<uint64_t> m_packetsSent { 0 };
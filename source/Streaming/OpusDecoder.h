@@ -0,0 +1,90 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <opus.h>   // FetchContent build: headers are in include/, not include/opus/
+
+namespace mix2go {
+namespace streaming {
+
+// Wraps libopus decoding for the talkback return channel (mono, 48 kHz).
+//
+// Usage:
+//   1. Call prepare() once before decoding.
+//   2. decode() for every received packet, decodeLost() for every missing
+//      one (packet loss concealment, uses in-band FEC when available).
+//
+// Thread safety: all methods must be called from the same thread (talkback worker).
+class MixOpusDecoder
+{
+public:
+    static constexpr int SAMPLE_RATE = 48000;
+    static constexpr int MAX_FRAME_SIZE = 5760; // 120 ms @ 48 kHz
+
+    MixOpusDecoder() = default;
+
+    ~MixOpusDecoder()
+    {
+        destroyDecoder();
+    }
+
+    void prepare()
+    {
+        destroyDecoder();
+
+        int error = OPUS_OK;
+        m_decoder = opus_decoder_create(SAMPLE_RATE, 1, &error);
+        if (error != OPUS_OK || !m_decoder)
+        {
+            DBG("[OpusDecoder] Failed to create decoder: " << opus_strerror(error));
+            m_decoder = nullptr;
+            return;
+        }
+
+        DBG("[OpusDecoder] Created: 48000 Hz / 1ch");
+    }
+
+    // Returns the number of decoded samples, 0 on error
+    int decode(const uint8_t* data, int bytes, float* output, int maxSamples)
+    {
+        if (!m_decoder || bytes <= 0)
+            return 0;
+
+        const int samples = opus_decode_float(m_decoder, data, static_cast<opus_int32>(bytes),
+                                              output, juce::jmin(maxSamples, MAX_FRAME_SIZE), 0);
+        if (samples < 0)
+        {
+            DBG("[OpusDecoder] decode error: " << opus_strerror(samples));
+            return 0;
+        }
+
+        return samples;
+    }
+
+    // Concealment for one lost frame of frameSize samples
+    int decodeLost(float* output, int frameSize)
+    {
+        if (!m_decoder || frameSize <= 0)
+            return 0;
+
+        const int samples = opus_decode_float(m_decoder, nullptr, 0, output,
+                                              juce::jmin(frameSize, MAX_FRAME_SIZE), 0);
+        return juce::jmax(0, samples);
+    }
+
+private:
+    void destroyDecoder()
+    {
+        if (m_decoder)
+        {
+            opus_decoder_destroy(m_decoder);
+            m_decoder = nullptr;
+        }
+    }
+
+    ::OpusDecoder* m_decoder = nullptr; // libopus opaque type (global namespace)
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixOpusDecoder)
+};
+
+} // namespace streaming
+} // namespace mix2go
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace mix2go {
+namespace streaming {
+
+// Welche Audio-Daten im Paket stecken
+enum class PayloadFormat
+{
+    Pcm16,  // native "M2G0" (little endian) oder RTP L16 (big endian)
+    Pcm24,  // RTP L24, RFC 3190
+    Opus    // RTP Opus, RFC 7587 (nur mit MIX2GO_WITH_OPUS)
+};
+
+// Ein Stück Audio im FIFO-Ringpuffer, so wie ThreadSafeFIFO::read() es liefert.
+// Zwei Bereiche wegen wrap around. channels == nullptr bedeutet Stille.
+struct AudioRegion
+{
+    const float* const* channels = nullptr;
+    int numChannels = 0;
+    int start1 = 0, size1 = 0;
+    int start2 = 0, size2 = 0;
+
+    int getNumSamples() const { return size1 + size2; }
+
+    static AudioRegion silence(int numChannels, int numSamples)
+    {
+        AudioRegion region;
+        region.numChannels = numChannels;
+        region.size1 = numSamples;
+        return region;
+    }
+};
+
+// Konvertiert float Audio direkt aus dem FIFO in das Datagramm.
+// Kein Zwischenpuffer und keine Allokation, egal welches Wire-Format.
+namespace packetizer
+{
+    // Ganzes Datagramm unter 1200 Bytes, damit unterwegs nichts fragmentiert
+    // wird (IPv6 Minimum-MTU 1280 minus IP/UDP und Luft für VPN/Tunnel).
+    // Für den Header rechnen wir mit dem größten, den wir schreiben: native
+    // 28 + Transport Extension 28, RTP 12 + Extension bis 36.
+    static constexpr int MAX_DATAGRAM_BYTES = 1200;
+    static constexpr int MAX_HEADER_BYTES = 56;
+
+    inline int getBytesPerSample(PayloadFormat format)
+    {
+        return format == PayloadFormat::Pcm24 ? 3 : 2;
+    }
+
+    inline int getPayloadSize(PayloadFormat format, int numChannels, int numSamples)
+    {
+        return numChannels * numSamples * getBytesPerSample(format);
+    }
+
+    // Höchstens so viele Samples pro Kanal passen in ein PCM Paket.
+    // L16 Stereo: 286, L24 Stereo: 190 (also keine 5 ms @ 48 kHz)
+    inline int getMaxPacketSamples(PayloadFormat format, int numChannels)
+    {
+        const int frameBytes = (numChannels > 0 ? numChannels : 1) * getBytesPerSample(format);
+        return (MAX_DATAGRAM_BYTES - MAX_HEADER_BYTES) / frameBytes;
+    }
+
+    // float [-1, 1] → Ganzzahl mit Clipping, asymmetrisch wie bisher
+    // (-1.0 → -32768, +1.0 → +32767)
+    template <int BytesPerSample>
+    inline int32_t toFixed(float s)
+    {
+        constexpr float positiveScale = BytesPerSample == 3 ? 8388607.0f : 32767.0f;
+        constexpr float negativeScale = BytesPerSample == 3 ? 8388608.0f : 32768.0f;
+
+        if (s >  1.0f) s =  1.0f;
+        if (s < -1.0f) s = -1.0f;
+        return static_cast<int32_t>(s * (s < 0.0f ? negativeScale : positiveScale));
+    }
+
+    template <int BytesPerSample, bool BigEndian>
+    inline uint8_t* writeSample(uint8_t* out, int32_t v)
+    {
+        const auto u = static_cast<uint32_t>(v);
+
+        if constexpr (BigEndian)
+        {
+            for (int b = BytesPerSample - 1; b >= 0; --b)
+                *out++ = static_cast<uint8_t>(u >> (8 * b));
+        }
+        else
+        {
+            for (int b = 0; b < BytesPerSample; ++b)
+                *out++ = static_cast<uint8_t>(u >> (8 * b));
+        }
+
+        return out;
+    }
+
+    template <int BytesPerSample, bool BigEndian>
+    inline void writeInterleaved(const AudioRegion& region, uint8_t* dest)
+    {
+        auto* out = dest;
+
+        auto writeBlock = [&](int start, int size)
+        {
+            for (int i = start; i < start + size; ++i)
+                for (int ch = 0; ch < region.numChannels; ++ch)
+                    out = writeSample<BytesPerSample, BigEndian>(
+                        out, toFixed<BytesPerSample>(region.channels[ch][i]));
+        };
+
+        writeBlock(region.start1, region.size1);
+        writeBlock(region.start2, region.size2);
+    }
+
+    // Schreibt interleaved PCM (L R L R ...). Gibt die Anzahl Bytes zurück,
+    // -1 wenn capacity nicht reicht.
+    inline int writePcm(const AudioRegion& region, PayloadFormat format, bool bigEndian,
+                        uint8_t* dest, int capacity)
+    {
+        const int numBytes = getPayloadSize(format, region.numChannels, region.getNumSamples());
+        if (numBytes > capacity)
+            return -1;
+
+        if (region.channels == nullptr)
+        {
+            std::memset(dest, 0, (size_t)numBytes);
+            return numBytes;
+        }
+
+        if (format == PayloadFormat::Pcm24)
+        {
+            if (bigEndian) writeInterleaved<3, true>(region, dest);
+            else           writeInterleaved<3, false>(region, dest);
+        }
+        else
+        {
+            if (bigEndian) writeInterleaved<2, true>(region, dest);
+            else           writeInterleaved<2, false>(region, dest);
+        }
+
+        return numBytes;
+    }
+}
+
+} // namespace streaming
+} // namespace mix2go
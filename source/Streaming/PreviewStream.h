@@ -0,0 +1,245 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <vector>
+#include "AudioPacket.h"
+#include "HalfBandDecimator.h"
+#include "Packetizer.h"
+
+namespace mix2go {
+namespace streaming {
+
+// Vorschau-Profil für Remote-Producer im Mobilnetz
+enum class PreviewMode
+{
+    Off,
+    Mono,     // (L + R) / 2
+    MidSide   // M = (L + R) / 2, S = (L - R) / 2. Wer nur mono will, nimmt M.
+};
+
+enum class PreviewRate
+{
+    Wide,     // ~24 kHz (22.05 / 24 kHz bei 44.1 / 48 kHz Host)
+    Narrow    // ~12 kHz (11.025 / 12 kHz)
+};
+
+// Zweiter, schmaler Stream parallel zum Haupt-Stream, aus dem selben FIFO.
+// Der Network Thread gibt jedes gelesene Paket an push(), hier wird
+// runtergemischt, mit einer Halbband-Kaskade dezimiert und in native
+// PCM16 Pakete (bis 20 ms) verpackt. PCM16 ist der billigste Codec-Pfad: kein
+// Encoder, und der Opus Encoder hier arbeitet sowieso fest mit 48 kHz Stereo.
+//
+// Beispiel 48 kHz Stereo → Mono 24 kHz: 1536 → 384 kbit/s, Mono 12 kHz 192 kbit/s.
+//
+// Thread safety: setMode() nur wenn nicht gestreamt wird, alles andere
+// nur vom Network Thread (bzw. vorher vom Message Thread).
+class PreviewStream
+{
+public:
+    static constexpr int PACKET_MS = 20;
+    static constexpr int MAX_PAYLOAD_BYTES = 1400;  // unter der MTU bleiben (M/S 24 kHz wären 1920)
+    static constexpr int MAX_STAGES = 4;            // 192 kHz → 12 kHz
+    static constexpr int CHUNK_SIZE = 1024;         // so viele Samples pro Durchlauf
+    static constexpr int MAX_PACKET_INPUT = 8192;   // größtes Haupt-Paket (Opus 20 ms @ 192 kHz: 3840)
+
+    void setMode(PreviewMode mode, PreviewRate rate)
+    {
+        m_mode = mode;
+        m_rate = rate;
+    }
+
+    PreviewMode getMode() const { return m_mode; }
+    bool isEnabled() const { return m_mode != PreviewMode::Off; }
+
+    // Host-Format. Alloziert, also nicht pro Paket aufrufen.
+    void prepare(double hostSampleRate, int hostChannels)
+    {
+        if (!isEnabled())
+            return;
+
+        m_hostChannels = juce::jlimit(1, 2, hostChannels);
+        m_numChannels = m_mode == PreviewMode::MidSide && m_hostChannels > 1 ? 2 : 1;
+
+        // So viele Halbierungen bis die Rate am nächsten am Ziel liegt
+        const double target = m_rate == PreviewRate::Wide ? 24000.0 : 12000.0;
+        m_numStages = 0;
+        while (m_numStages < MAX_STAGES && hostSampleRate / (1 << (m_numStages + 1)) >= target * 0.9)
+            ++m_numStages;
+
+        m_sampleRate = hostSampleRate / (1 << m_numStages);
+        m_packetSamples = juce::jlimit(1, MAX_PAYLOAD_BYTES / (2 * m_numChannels),
+                                       (int)(m_sampleRate * PACKET_MS / 1000.0));
+
+        for (auto& channelStages : m_stages)
+            for (int s = 0; s < MAX_STAGES; ++s)
+                channelStages[(size_t)s].prepare((CHUNK_SIZE >> s) + 1);
+
+        for (auto& buffer : m_work)
+            buffer.assign((size_t)CHUNK_SIZE + 1, 0.0f);
+
+        for (auto& accum : m_accum)
+            accum.assign((size_t)(m_packetSamples + MAX_PACKET_INPUT), 0.0f);
+
+        m_accumCount = 0;
+        m_sequence = 0;
+        m_startTicks = juce::Time::getHighResolutionTicks();
+        m_announce = true;
+
+        DBG("[Mix2Go] Preview: " << (m_numChannels == 2 ? "M/S" : "mono")
+            << " " << (int)m_sampleRate << " Hz (" << m_numStages << " half-band stages)"
+            << ", " << m_packetSamples << " samples/pkt");
+    }
+
+    double getSampleRate() const { return m_sampleRate; }
+
+    // Network Thread: ein gelesenes Paket aus dem Haupt-FIFO
+    void push(const AudioRegion& region)
+    {
+        if (!isEnabled() || region.channels == nullptr)
+            return;
+
+       #if JUCE_DEBUG
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+       #endif
+
+        pushRange(region, region.start1, region.size1);
+        pushRange(region, region.start2, region.size2);
+
+       #if JUCE_DEBUG
+        // Grober CPU-Check: Mittelwert pro Haupt-Paket, alle ~5 s
+        m_debugTicks += juce::Time::getHighResolutionTicks() - startTicks;
+        if (++m_debugPushes == 1000)
+        {
+            DBG("[Mix2Go] Preview: " << juce::String(juce::Time::highResolutionTicksToSeconds(m_debugTicks) * 1.0e6 / m_debugPushes, 2)
+                << " us per packet");
+            m_debugTicks = 0;
+            m_debugPushes = 0;
+        }
+       #endif
+    }
+
+    // Network Thread: fertiges Paket nach dest, 0 wenn noch keins voll ist.
+    // Vor dem ersten Audio-Paket kommt ein Descriptor.
+    int writePacket(uint8_t* dest, int capacity)
+    {
+        const int headerSize = (int)AudioPacket::HEADER_SIZE;
+
+        if (m_announce)
+        {
+            if (capacity < headerSize)
+                return 0;
+
+            m_announce = false;
+            return writeHeader(dest, AudioPacket::FLAG_FORMAT_DESCRIPTOR, m_packetSamples);
+        }
+
+        if (m_accumCount < m_packetSamples)
+            return 0;
+
+        std::array<const float*, 2> channels { m_accum[0].data(), m_accum[1].data() };
+
+        AudioRegion region;
+        region.channels = channels.data();
+        region.numChannels = m_numChannels;
+        region.size1 = m_packetSamples;
+
+        const int payloadBytes = packetizer::writePcm(region, PayloadFormat::Pcm16, false,
+                                                      dest + headerSize, capacity - headerSize);
+        if (payloadBytes < 0)
+            return 0;
+
+        writeHeader(dest, 0, m_packetSamples);
+
+        // Rest nach vorne
+        m_accumCount -= m_packetSamples;
+        for (int ch = 0; ch < m_numChannels; ++ch)
+            std::memmove(m_accum[(size_t)ch].data(), m_accum[(size_t)ch].data() + m_packetSamples,
+                         (size_t)m_accumCount * sizeof(float));
+
+        return headerSize + payloadBytes;
+    }
+
+private:
+    void pushRange(const AudioRegion& region, int start, int size)
+    {
+        for (int offset = 0; offset < size; offset += CHUNK_SIZE)
+        {
+            const int numSamples = juce::jmin(CHUNK_SIZE, size - offset);
+            const float* left = region.channels[0] + start + offset;
+            const float* right = region.numChannels > 1 && m_hostChannels > 1
+                                   ? region.channels[1] + start + offset
+                                   : left;
+
+            // Runtermischen, SIMD über den ganzen Chunk
+            juce::FloatVectorOperations::add(m_work[0].data(), left, right, numSamples);
+            juce::FloatVectorOperations::multiply(m_work[0].data(), 0.5f, numSamples);
+
+            if (m_numChannels == 2)
+            {
+                juce::FloatVectorOperations::subtract(m_work[1].data(), left, right, numSamples);
+                juce::FloatVectorOperations::multiply(m_work[1].data(), 0.5f, numSamples);
+            }
+
+            for (int ch = 0; ch < m_numChannels; ++ch)
+            {
+                // Kaskade in place, jede Stufe halbiert
+                float* data = m_work[(size_t)ch].data();
+                int count = numSamples;
+
+                for (int s = 0; s < m_numStages; ++s)
+                    count = m_stages[(size_t)ch][(size_t)s].process(data, count, data);
+
+                auto& accum = m_accum[(size_t)ch];
+                jassert(m_accumCount + count <= (int)accum.size());
+                count = juce::jmin(count, (int)accum.size() - m_accumCount);
+                std::memcpy(accum.data() + m_accumCount, data, (size_t)count * sizeof(float));
+
+                if (ch == m_numChannels - 1)
+                    m_accumCount += count;
+            }
+        }
+    }
+
+    int writeHeader(uint8_t* dest, uint16_t flags, int numSamples)
+    {
+        const double ticksPerMicrosecond = juce::Time::getHighResolutionTicksPerSecond() / 1000000.0;
+
+        AudioPacket header;
+        header.flags          = (uint16_t)(flags | (m_numChannels == 2 ? AudioPacket::FLAG_MID_SIDE : 0));
+        header.sampleRate     = (uint32_t)m_sampleRate;
+        header.numChannels    = (uint16_t)m_numChannels;
+        header.numSamples     = (uint32_t)numSamples;
+        header.timestamp      = (uint64_t)((juce::Time::getHighResolutionTicks() - m_startTicks) / ticksPerMicrosecond);
+        header.sequenceNumber = m_sequence++;
+        header.writeHeader(dest);
+        return (int)AudioPacket::HEADER_SIZE;
+    }
+
+    PreviewMode m_mode = PreviewMode::Off;
+    PreviewRate m_rate = PreviewRate::Wide;
+
+    int m_hostChannels = 2;
+    int m_numChannels = 1;
+    int m_numStages = 1;
+    double m_sampleRate = 24000.0;
+    int m_packetSamples = 480;
+
+    std::array<std::array<HalfBandDecimator, MAX_STAGES>, 2> m_stages;
+    std::array<std::vector<float>, 2> m_work;
+    std::array<std::vector<float>, 2> m_accum;
+    int m_accumCount = 0;
+
+    uint32_t m_sequence = 0;
+    juce::int64 m_startTicks = 0;
+    bool m_announce = true;
+
+   #if JUCE_DEBUG
+    juce::int64 m_debugTicks = 0;
+    int m_debugPushes = 0;
+   #endif
+};
+
+} // namespace streaming
+} // namespace mix2go
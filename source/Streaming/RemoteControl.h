@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cmath>
+#include "SessionControl.h"
+
+namespace mix2go {
+namespace streaming {
+
+// Postfach für die Macro-Fernsteuerung vom Handy, in beide Richtungen.
+//
+// Remote → Plugin: der Network Thread legt jeden empfangenen Wert ab und
+// setzt ein Dirty-Bit. Der Message Thread holt alle Dirty-Bits auf einmal
+// ab (RemoteMacroControl, 30 Hz). Kommen zwischendurch zehn Updates für das
+// gleiche Macro, zählt nur das letzte.
+//
+// Plugin → Remote: genauso andersrum. Der Message Thread legt den aktuellen
+// Wert ab wenn er sich (quantisiert) geändert hat, der Network Thread
+// schickt höchstens alle ECHO_INTERVAL_MS ein MacroState mit allen Änderungen.
+//
+// Beide Seiten sind wait-free (nur atomics, keine Queue die voll laufen kann).
+class RemoteControl
+{
+public:
+    static constexpr int NUM_MACROS = 10;
+    static constexpr uint32_t ECHO_INTERVAL_MS = 33;   // max. 30 Hz
+    static_assert(NUM_MACROS <= session::MAX_MACROS, "MacroValues mask too small");
+
+    static uint16_t quantize(float normalised)
+    {
+        const float clamped = normalised < 0.0f ? 0.0f : (normalised > 1.0f ? 1.0f : normalised);
+        return (uint16_t)std::lround(clamped * 65535.0f);
+    }
+
+    static float dequantize(uint16_t value) { return (float)value / 65535.0f; }
+
+    //==========================================================================
+    // Remote → Plugin
+    //==========================================================================
+
+    // Network Thread
+    void postRemote(const session::MacroValues& update)
+    {
+        uint32_t mask = 0;
+
+        for (int i = 0; i < NUM_MACROS; ++i)
+        {
+            if ((update.mask & (1u << i)) == 0)
+                continue;
+
+            m_remoteValues[(size_t)i].store(update.values[i], std::memory_order_relaxed);
+            mask |= 1u << i;
+        }
+
+        if (mask != 0)
+            m_remoteDirty.fetch_or(mask, std::memory_order_release);
+    }
+
+    // Message Thread. Gibt die Maske der geänderten Macros zurück.
+    uint32_t takeRemote(std::array<float, NUM_MACROS>& values)
+    {
+        const uint32_t mask = m_remoteDirty.exchange(0, std::memory_order_acquire);
+
+        for (int i = 0; i < NUM_MACROS; ++i)
+            if ((mask & (1u << i)) != 0)
+                values[(size_t)i] = dequantize(m_remoteValues[(size_t)i].load(std::memory_order_relaxed));
+
+        return mask;
+    }
+
+    //==========================================================================
+    // Plugin → Remote
+    //==========================================================================
+
+    // Message Thread: aktuellen Wert melden, wird nur bei Änderung verschickt
+    void postState(int index, float normalised, bool force = false)
+    {
+        const auto value = quantize(normalised);
+        const auto i = (size_t)index;
+
+        if (!force && m_lastPosted[i] == value)
+            return;
+
+        m_lastPosted[i] = value;
+        m_stateValues[i].store(value, std::memory_order_relaxed);
+        m_stateDirty.fetch_or(1u << index, std::memory_order_release);
+    }
+
+    // Network Thread: neue Session, der Empfänger braucht einmal alles
+    void requestFullState() { m_fullStateRequested = true; }
+
+    // Message Thread
+    bool takeFullStateRequest() { return m_fullStateRequested.exchange(false); }
+
+    // Network Thread. Füllt update mit allen Änderungen seit dem letzten Aufruf.
+    bool takeState(session::MacroValues& update)
+    {
+        const uint32_t mask = m_stateDirty.exchange(0, std::memory_order_acquire);
+        update.mask = (uint16_t)mask;
+
+        for (int i = 0; i < NUM_MACROS; ++i)
+            if ((mask & (1u << i)) != 0)
+                update.values[i] = m_stateValues[(size_t)i].load(std::memory_order_relaxed);
+
+        return mask != 0;
+    }
+
+private:
+    std::array<std::atomic<uint16_t>, NUM_MACROS> m_remoteValues {};
+    std::atomic<uint32_t> m_remoteDirty { 0 };
+
+    std::array<std::atomic<uint16_t>, NUM_MACROS> m_stateValues {};
+    std::atomic<uint32_t> m_stateDirty { 0 };
+    std::array<uint16_t, NUM_MACROS> m_lastPosted {};   // nur Message Thread
+    std::atomic<bool> m_fullStateRequested { false };
+};
+
+} // namespace streaming
+} // namespace mix2go
@@ -0,0 +1,394 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include "Packetizer.h"
+
+namespace mix2go {
+namespace streaming {
+
+// RTP/RTCP nach RFC 3550, damit Standard-Tools (ffplay, VLC, GStreamer ...)
+// den Stream direkt abspielen können.
+//
+// Payloads:
+//   L16 / L24  RFC 3190, big endian, Clock = Sample Rate
+//   Opus       RFC 7587, Clock immer 48 kHz, ein Frame pro Paket
+//
+// Alle Payload Types sind dynamisch, die Beschreibung kommt per SDP
+// (siehe createSdp()). Sender Reports gehen alle 5 s raus, Receiver Reports
+// der Empfänger werden ausgewertet (Loss, Jitter, Round Trip).
+//
+// Thread safety: alles außer getStats() nur vom Network Thread.
+class RtpSession
+{
+public:
+    static const size_t HEADER_SIZE = 12;
+    static const int SENDER_REPORT_INTERVAL_MS = 5000;
+
+    // Kommen so lange keine Receiver Reports mehr, hört niemand mehr zu
+    static const uint32_t RECEIVER_TIMEOUT_MS = 15000;
+
+    static const uint8_t PT_L16  = 96;
+    static const uint8_t PT_L24  = 97;
+    static const uint8_t PT_OPUS = 111;
+
+    // Ergebnisse aus den Receiver Reports
+    struct Stats
+    {
+        std::atomic<float> fractionLost { 0.0f };   // 0..1 seit letztem Report
+        std::atomic<int> cumulativeLost { 0 };
+        std::atomic<float> jitterMs { 0.0f };
+        std::atomic<float> roundTripMs { 0.0f };
+        std::atomic<uint64_t> reportsReceived { 0 };
+    };
+
+    RtpSession() = default;
+
+    // Neue Session: zufällige SSRC, Sequenz und Timestamp (RFC 3550 5.1)
+    void reset()
+    {
+        juce::Random random;
+        m_ssrc        = (uint32_t)random.nextInt();
+        m_sequence    = (uint16_t)random.nextInt(65536);
+        m_timestamp   = (uint32_t)random.nextInt();
+        m_packetCount = 0;
+        m_octetCount  = 0;
+        m_marker      = true;
+        m_hasExtension = false;
+        m_lastReportTime = 0;
+
+        m_stats.fractionLost    = 0.0f;
+        m_stats.cumulativeLost  = 0;
+        m_stats.jitterMs        = 0.0f;
+        m_stats.roundTripMs     = 0.0f;
+        m_stats.reportsReceived = 0;
+    }
+
+    void setFormat(PayloadFormat format, double sampleRate)
+    {
+        m_format    = format;
+        m_clockRate = getClockRate(format, sampleRate);
+
+        // Format hat sich geändert → Empfänger soll neu synchronisieren
+        m_marker = true;
+    }
+
+    static uint8_t getPayloadType(PayloadFormat format)
+    {
+        switch (format)
+        {
+            case PayloadFormat::Pcm24: return PT_L24;
+            case PayloadFormat::Opus:  return PT_OPUS;
+            case PayloadFormat::Pcm16: break;
+        }
+        return PT_L16;
+    }
+
+    static uint32_t getClockRate(PayloadFormat format, double sampleRate)
+    {
+        return format == PayloadFormat::Opus ? 48000u : (uint32_t)sampleRate;
+    }
+
+    //==========================================================================
+    // RTP
+    //==========================================================================
+
+    // Header + L16/L24 Payload direkt aus dem FIFO
+    int writePcmPacket(const AudioRegion& region, uint8_t* dest, int capacity)
+    {
+        const int headerSize = getHeaderSize();
+        if (capacity < headerSize)
+            return -1;
+
+        const int payloadBytes = packetizer::writePcm(region, m_format, true,
+                                                      dest + headerSize,
+                                                      capacity - headerSize);
+        if (payloadBytes < 0)
+            return -1;
+
+        writeHeader(dest);
+        advance((uint32_t)region.getNumSamples(), payloadBytes);
+        return headerSize + payloadBytes;
+    }
+
+    // Header + ein fertig kodierter Opus Frame
+    int writeOpusPacket(const uint8_t* frame, int frameBytes, int samplesAt48k,
+                        uint8_t* dest, int capacity)
+    {
+        const int headerSize = getHeaderSize();
+        if (capacity < headerSize + frameBytes)
+            return -1;
+
+        writeHeader(dest);
+        std::memcpy(dest + headerSize, frame, (size_t)frameBytes);
+        advance((uint32_t)samplesAt48k, frameBytes);
+        return headerSize + frameBytes;
+    }
+
+    // Header Extension (RFC 3550 5.3.1) für das nächste Paket, danach wieder
+    // ohne. data sind numWords 32 bit Worte, schon in Netzwerk-Byte-Order.
+    void setExtension(uint16_t profile, const uint8_t* data, int numWords)
+    {
+        jassert(numWords >= 0 && numWords <= MAX_EXTENSION_WORDS);
+        m_extensionProfile = profile;
+        m_extensionWords = juce::jlimit(0, MAX_EXTENSION_WORDS, numWords);
+        std::memcpy(m_extension.data(), data, (size_t)m_extensionWords * 4);
+        m_hasExtension = true;
+    }
+
+    void clearExtension() { m_hasExtension = false; }
+
+    // Nach einer Lücke (Format-Wechsel, Pause) bekommt das nächste Paket
+    // das Marker Bit. skippedSamples (Clock Rate) schiebt den Timestamp um
+    // die Pause weiter, damit der Empfänger die Lücke richtig einordnet.
+    void markDiscontinuity(uint32_t skippedSamples = 0)
+    {
+        m_marker = true;
+        m_timestamp += skippedSamples;
+    }
+
+    uint32_t getClockRate() const { return m_clockRate; }
+
+    //==========================================================================
+    // RTCP
+    //==========================================================================
+
+    bool isSenderReportDue() const
+    {
+        return m_packetCount > 0
+            && juce::Time::getMillisecondCounter() - m_lastReportTime >= (juce::uint32)SENDER_REPORT_INTERVAL_MS;
+    }
+
+    // Compound Paket: Sender Report + SDES CNAME (RFC 3550 6.4.1 / 6.5)
+    int writeSenderReport(uint8_t* dest, int capacity)
+    {
+        const auto cname = juce::String("mix2go@") + juce::SystemStats::getComputerName();
+        const auto cnameBytes = juce::jmin(255, (int)cname.getNumBytesAsUTF8());
+
+        // SDES chunk: SSRC + CNAME item (2 + n) + END, auf 32 bit aufgefüllt
+        const int sdesChunk  = (4 + 2 + cnameBytes + 1 + 3) & ~3;
+        const int srBytes    = 28;
+        const int sdesBytes  = 4 + sdesChunk;
+
+        if (capacity < srBytes + sdesBytes)
+            return -1;
+
+        const uint64_t ntp = getNtpTime();
+        m_lastReportTime = juce::Time::getMillisecondCounter();
+
+        uint8_t* p = dest;
+        p[0] = 0x80;                // V=2, P=0, RC=0
+        p[1] = 200;                 // SR
+        writeBE16(p + 2, (uint16_t)(srBytes / 4 - 1));
+        writeBE32(p + 4, m_ssrc);
+        writeBE32(p + 8, (uint32_t)(ntp >> 32));
+        writeBE32(p + 12, (uint32_t)ntp);
+        writeBE32(p + 16, m_timestamp);
+        writeBE32(p + 20, m_packetCount);
+        writeBE32(p + 24, m_octetCount);
+
+        p += srBytes;
+        std::memset(p, 0, (size_t)sdesBytes);
+        p[0] = 0x81;                // V=2, SC=1
+        p[1] = 202;                 // SDES
+        writeBE16(p + 2, (uint16_t)(sdesBytes / 4 - 1));
+        writeBE32(p + 4, m_ssrc);
+        p[8] = 1;                   // CNAME
+        p[9] = (uint8_t)cnameBytes;
+        std::memcpy(p + 10, cname.toRawUTF8(), (size_t)cnameBytes);
+        // END + Padding sind schon 0
+
+        return srBytes + sdesBytes;
+    }
+
+    // Receiver Reports (oder SRs mit Report Blocks) auswerten.
+    // Nur Blöcke für unsere SSRC zählen.
+    void handleRtcp(const uint8_t* data, int size)
+    {
+        const uint32_t arrival = (uint32_t)(getNtpTime() >> 16);
+        int offset = 0;
+
+        while (offset + 8 <= size)
+        {
+            const uint8_t* p = data + offset;
+            if ((p[0] >> 6) != 2)
+                return; // kein RTCP
+
+            const int count  = p[0] & 0x1f;
+            const int type   = p[1];
+            const int length = (readBE16(p + 2) + 1) * 4;
+
+            if (offset + length > size)
+                return;
+
+            const int blocksStart = type == 201 ? 8 : (type == 200 ? 28 : -1);
+            if (blocksStart > 0)
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    const int blockOffset = blocksStart + i * 24;
+                    if (blockOffset + 24 > length)
+                        break;
+
+                    parseReportBlock(p + blockOffset, arrival);
+                }
+            }
+
+            offset += length;
+        }
+    }
+
+    const Stats& getStats() const { return m_stats; }
+    uint32_t getSsrc() const { return m_ssrc; }
+
+    // SDP für den Empfänger, z.B. "ffplay -protocol_whitelist file,udp,rtp stream.sdp"
+    static juce::String createSdp(PayloadFormat format, double sampleRate, int numChannels,
+                                  int packetSamples, const juce::String& targetIP, int port)
+    {
+        const auto pt = (int)getPayloadType(format);
+
+        juce::String sdp;
+        sdp << "v=0\r\n"
+            << "o=- 0 0 IN IP4 127.0.0.1\r\n"
+            << "s=Mix2Go\r\n"
+            << "c=IN IP4 " << targetIP << "\r\n"
+            << "t=0 0\r\n"
+            << "m=audio " << port << " RTP/AVP " << pt << "\r\n";
+
+        if (format == PayloadFormat::Opus)
+        {
+            sdp << "a=rtpmap:" << pt << " opus/48000/2\r\n"
+                << "a=fmtp:" << pt << " stereo=" << (numChannels > 1 ? 1 : 0)
+                << "; sprop-stereo=" << (numChannels > 1 ? 1 : 0) << "\r\n"
+                << "a=ptime:20\r\n";
+        }
+        else
+        {
+            sdp << "a=rtpmap:" << pt << (format == PayloadFormat::Pcm24 ? " L24/" : " L16/")
+                << (int)sampleRate << "/" << numChannels << "\r\n"
+                << "a=ptime:" << juce::jmax(1, juce::roundToInt(packetSamples * 1000.0 / sampleRate)) << "\r\n";
+        }
+
+        return sdp;
+    }
+
+private:
+    static constexpr int MAX_EXTENSION_WORDS = 8;
+
+    int getHeaderSize() const
+    {
+        return (int)HEADER_SIZE + (m_hasExtension ? 4 + m_extensionWords * 4 : 0);
+    }
+
+    void writeHeader(uint8_t* dest)
+    {
+        dest[0] = (uint8_t)(m_hasExtension ? 0x90 : 0x80);  // V=2, P=0, X, CC=0
+        dest[1] = (uint8_t)((m_marker ? 0x80 : 0x00) | getPayloadType(m_format));
+        writeBE16(dest + 2, m_sequence);
+        writeBE32(dest + 4, m_timestamp);
+        writeBE32(dest + 8, m_ssrc);
+
+        if (m_hasExtension)
+        {
+            writeBE16(dest + HEADER_SIZE, m_extensionProfile);
+            writeBE16(dest + HEADER_SIZE + 2, (uint16_t)m_extensionWords);
+            std::memcpy(dest + HEADER_SIZE + 4, m_extension.data(), (size_t)m_extensionWords * 4);
+        }
+    }
+
+    void advance(uint32_t samples, int payloadBytes)
+    {
+        ++m_sequence;
+        m_timestamp += samples;
+        ++m_packetCount;
+        m_octetCount += (uint32_t)payloadBytes;
+        m_marker = false;
+        m_hasExtension = false;
+    }
+
+    void parseReportBlock(const uint8_t* block, uint32_t arrival)
+    {
+        if (readBE32(block) != m_ssrc)
+            return;
+
+        // cumulative lost ist ein 24 bit signed Wert
+        int32_t lost = (int32_t)((uint32_t)block[5] << 16 | (uint32_t)block[6] << 8 | block[7]);
+        if (lost & 0x800000)
+            lost -= 0x1000000;
+
+        const uint32_t jitter = readBE32(block + 12);
+        const uint32_t lsr    = readBE32(block + 16);
+        const uint32_t dlsr   = readBE32(block + 20);
+
+        m_stats.fractionLost   = (float)block[4] / 256.0f;
+        m_stats.cumulativeLost = lost;
+        m_stats.jitterMs       = m_clockRate > 0 ? (float)jitter * 1000.0f / (float)m_clockRate : 0.0f;
+
+        // RTT = A - LSR - DLSR, Einheit 1/65536 s (RFC 3550 6.4.1)
+        if (lsr != 0)
+        {
+            const uint32_t rtt = arrival - lsr - dlsr;
+            m_stats.roundTripMs = (float)rtt * 1000.0f / 65536.0f;
+        }
+
+        m_stats.reportsReceived++;
+    }
+
+    // NTP 64 bit: Sekunden seit 1900 . Bruchteil
+    static uint64_t getNtpTime()
+    {
+        const auto ms = (uint64_t)juce::Time::currentTimeMillis();
+        const uint64_t seconds  = ms / 1000 + 2208988800ULL;
+        const uint64_t fraction = ((ms % 1000) << 32) / 1000;
+        return (seconds << 32) | fraction;
+    }
+
+    static void writeBE16(uint8_t* p, uint16_t v)
+    {
+        p[0] = (uint8_t)(v >> 8);
+        p[1] = (uint8_t)v;
+    }
+
+    static void writeBE32(uint8_t* p, uint32_t v)
+    {
+        p[0] = (uint8_t)(v >> 24);
+        p[1] = (uint8_t)(v >> 16);
+        p[2] = (uint8_t)(v >> 8);
+        p[3] = (uint8_t)v;
+    }
+
+    static uint16_t readBE16(const uint8_t* p)
+    {
+        return (uint16_t)((p[0] << 8) | p[1]);
+    }
+
+    static uint32_t readBE32(const uint8_t* p)
+    {
+        return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | (uint32_t)p[3];
+    }
+
+    PayloadFormat m_format = PayloadFormat::Pcm16;
+    uint32_t m_clockRate = 44100;
+
+    uint32_t m_ssrc = 0;
+    uint16_t m_sequence = 0;
+    uint32_t m_timestamp = 0;
+    uint32_t m_packetCount = 0;
+    uint32_t m_octetCount = 0;
+    bool m_marker = true;
+    juce::uint32 m_lastReportTime = 0;
+
+    // Header Extension, gilt nur für das nächste Paket
+    std::array<uint8_t, MAX_EXTENSION_WORDS * 4> m_extension {};
+    uint16_t m_extensionProfile = 0;
+    int m_extensionWords = 0;
+    bool m_hasExtension = false;
+
+    Stats m_stats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RtpSession)
+};
+
+} // namespace streaming
+} // namespace mix2go
@@ -0,0 +1,429 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include "AudioPacket.h"
+#include "Packetizer.h"
+#include "MeterAnalyzer.h"
+
+namespace mix2go {
+namespace streaming {
+
+// Session-Aufbau zwischen Sender (Plugin) und Empfänger, nur für das native
+// Wire Format. Läuft über den Audio-Socket, Empfänger antworten einfach an
+// die Absender-Adresse vom Hello.
+//
+//   Sender                          Empfänger
+//     | --- Hello (alle 250 ms) -->   |  Session ID, Host-Format, Codecs
+//     | <-- Offer -----------------   |  Codecs, Sample Rates, Kanäle,
+//     |                               |  max. Paketgröße, Wunsch-Puffer
+//     | --- Answer --------------->   |  gewähltes Format, danach Audio,
+//     |                               |  Talkback-Codecs (0 = kein Rückkanal)
+//     | <-- Report (ca. 1 pro s) --   |  Empfang, Verlust, Jitter, Puffer
+//     | <-> Bye -------------------   |  Ende, von beiden Seiten
+//     | <-- Talkback Audio --------   |  "M2GT" Pakete, siehe TalkbackReceiver
+//     | <-- MacroUpdate -----------   |  Macro-Werte vom Handy (gebündelt)
+//     | --- MacroState ------------>  |  geänderte Werte zurück (max. 30 Hz)
+//     | --- Meters ---------------->  |  Peak/RMS + Spektrum (ca. 30 Hz)
+//
+// Ohne Offer geht kein Audio raus, nach CONNECT_TIMEOUT_MS ist die Session
+// Error und das Hello kommt nur noch alle PROBE_INTERVAL_MS. Ältere Empfänger
+// ohne Handshake nur per AudioStreamManager::setLegacyReceiver() (Opt-in).
+//
+// Jede Nachricht: 8 Byte Header (magic, version, type, reserved) + feste
+// Felder, little endian wie AudioPacket.
+namespace session
+{
+    static constexpr uint32_t MAGIC = 0x4D324743; // "M2GC"
+    static constexpr uint8_t VERSION = 1;
+    static constexpr int HEADER_SIZE = 8;
+    static constexpr int MAX_MESSAGE_SIZE = 64;
+
+    // Timing (ms)
+    static constexpr uint32_t HELLO_INTERVAL_MS = 250;     // solange Connecting
+    static constexpr uint32_t PROBE_INTERVAL_MS = 2000;    // nach Error und im Legacy-Modus
+    static constexpr uint32_t CONNECT_TIMEOUT_MS = 5000;   // kein Offer → Error
+    static constexpr uint32_t REPORT_TIMEOUT_MS = 2500;    // kein Report → Degraded
+    static constexpr uint32_t LOST_TIMEOUT_MS = 8000;      // kein Report → Error, Audio aus
+
+    // Ab wann ein Report als Degraded zählt
+    static constexpr float DEGRADED_LOSS_RATIO = 0.02f;
+
+    // Kleinste sinnvolle Paketgröße in Samples (sonst nur noch Header)
+    static constexpr int MIN_PACKET_SAMPLES = 32;
+
+    // Opus @ 128 kbps VBR, 20 ms: ca 320 Bytes, mit Luft nach oben
+    static constexpr int OPUS_MAX_FRAME_BYTES = 400;
+
+    enum class MessageType : uint8_t
+    {
+        Invalid = 0,
+        Hello   = 1,
+        Offer   = 2,
+        Answer  = 3,
+        Report  = 4,
+        Bye     = 5,
+        MacroUpdate = 6,
+        MacroState  = 7,
+        Meters      = 8
+    };
+
+    // Codec Bits (Hello, Offer, Answer)
+    static constexpr uint16_t CODEC_PCM16 = 1 << 0;
+    static constexpr uint16_t CODEC_PCM24 = 1 << 1;
+    static constexpr uint16_t CODEC_OPUS  = 1 << 2;
+
+    // Sample Rate Bits im Offer: Bit i = SAMPLE_RATES[i]
+    static constexpr uint32_t SAMPLE_RATES[] = { 8000, 11025, 16000, 22050, 24000, 32000,
+                                                 44100, 48000, 88200, 96000, 176400, 192000 };
+
+    inline uint32_t getSampleRateBit(double sampleRate)
+    {
+        const auto rate = (uint32_t)std::lround(sampleRate);
+        for (size_t i = 0; i < sizeof(SAMPLE_RATES) / sizeof(SAMPLE_RATES[0]); ++i)
+            if (SAMPLE_RATES[i] == rate)
+                return 1u << i;
+
+        return 0;
+    }
+
+    inline uint16_t getCodecBit(PayloadFormat format)
+    {
+        switch (format)
+        {
+            case PayloadFormat::Pcm24: return CODEC_PCM24;
+            case PayloadFormat::Opus:  return CODEC_OPUS;
+            case PayloadFormat::Pcm16: break;
+        }
+        return CODEC_PCM16;
+    }
+
+    // Was dieser Build senden kann
+    inline uint16_t getLocalCodecs()
+    {
+       #if MIX2GO_WITH_OPUS
+        return CODEC_PCM16 | CODEC_PCM24 | CODEC_OPUS;
+       #else
+        return CODEC_PCM16 | CODEC_PCM24;
+       #endif
+    }
+
+    struct Hello
+    {
+        uint32_t sessionId = 0;
+        uint32_t sampleRate = 0;
+        uint16_t numChannels = 0;
+        uint16_t codecs = 0;
+    };
+
+    struct Offer
+    {
+        uint32_t sessionId = 0;
+        uint32_t sampleRates = 0;        // SAMPLE_RATES Bits
+        uint16_t codecs = 0;
+        uint16_t maxChannels = 0;
+        uint16_t maxPacketBytes = 0;     // inkl. AudioPacket Header
+        uint16_t preferredBufferMs = 0;
+    };
+
+    struct Answer
+    {
+        uint32_t sessionId = 0;
+        uint32_t sampleRate = 0;         // auf dem Wire (Opus: 48000)
+        uint16_t numChannels = 0;
+        uint16_t codec = 0;              // genau ein CODEC_* Bit
+        uint16_t packetSamples = 0;      // pro Paket, bei sampleRate
+        uint16_t preferredBufferMs = 0;  // Echo vom Offer
+        uint16_t talkbackCodecs = 0;     // was der Empfänger zurückschicken darf
+        uint16_t reserved = 0;
+    };
+
+    struct Report
+    {
+        uint32_t sessionId = 0;
+        uint32_t packetsReceived = 0;    // kumulativ
+        uint32_t packetsLost = 0;        // kumulativ
+        uint32_t jitterUs = 0;
+        uint16_t bufferMs = 0;           // aktueller Jitter-Buffer Stand
+        uint16_t underruns = 0;          // kumulativ, läuft über
+    };
+
+    struct Bye
+    {
+        uint32_t sessionId = 0;
+    };
+
+    // MacroUpdate und MacroState: nur die Macros deren Bit in mask gesetzt
+    // ist, Werte normalisiert 0..65535 in Bit-Reihenfolge hintereinander
+    static constexpr int MAX_MACROS = 16;
+
+    struct MacroValues
+    {
+        uint32_t sessionId = 0;
+        uint16_t mask = 0;
+        uint16_t values[MAX_MACROS] = {};   // Index = Macro, nur mask-Bits gültig
+    };
+
+    //==========================================================================
+    // Serialisierung
+    //==========================================================================
+
+    namespace detail
+    {
+        template <typename T>
+        inline uint8_t* put(uint8_t* out, T value)
+        {
+            std::memcpy(out, &value, sizeof(T));
+            return out + sizeof(T);
+        }
+
+        template <typename T>
+        inline const uint8_t* get(const uint8_t* in, T& value)
+        {
+            std::memcpy(&value, in, sizeof(T));
+            return in + sizeof(T);
+        }
+
+        inline uint8_t* putHeader(uint8_t* out, MessageType type)
+        {
+            out = put(out, MAGIC);
+            out = put(out, VERSION);
+            out = put(out, (uint8_t)type);
+            return put(out, (uint16_t)0);
+        }
+
+        constexpr int getBodySize(MessageType type)
+        {
+            return type == MessageType::Hello  ? 12
+                 : type == MessageType::Offer  ? 16
+                 : type == MessageType::Answer ? 20
+                 : type == MessageType::Report ? 20
+                 : type == MessageType::Bye    ? 4
+                 : type == MessageType::MacroUpdate ? 6   // + 2 Byte pro gesetztem Bit
+                 : type == MessageType::MacroState  ? 6
+                 : type == MessageType::Meters      ? 6   // + Kanäle * 2 + Bänder
+                 : 0;
+        }
+    }
+
+    // Typ einer empfangenen Nachricht, Invalid wenn es keine (vollständige)
+    // Session-Nachricht ist
+    inline MessageType getMessageType(const uint8_t* data, int size)
+    {
+        if (size < HEADER_SIZE)
+            return MessageType::Invalid;
+
+        uint32_t magic = 0;
+        std::memcpy(&magic, data, sizeof(magic));
+        if (magic != MAGIC || data[4] != VERSION)
+            return MessageType::Invalid;
+
+        const auto type = (MessageType)data[5];
+        const int bodySize = detail::getBodySize(type);
+
+        if (bodySize == 0 || size < HEADER_SIZE + bodySize)
+            return MessageType::Invalid;
+
+        return type;
+    }
+
+    inline int write(const Hello& m, uint8_t* dest)
+    {
+        auto* out = detail::putHeader(dest, MessageType::Hello);
+        out = detail::put(out, m.sessionId);
+        out = detail::put(out, m.sampleRate);
+        out = detail::put(out, m.numChannels);
+        out = detail::put(out, m.codecs);
+        return (int)(out - dest);
+    }
+
+    inline int write(const Offer& m, uint8_t* dest)
+    {
+        auto* out = detail::putHeader(dest, MessageType::Offer);
+        out = detail::put(out, m.sessionId);
+        out = detail::put(out, m.sampleRates);
+        out = detail::put(out, m.codecs);
+        out = detail::put(out, m.maxChannels);
+        out = detail::put(out, m.maxPacketBytes);
+        out = detail::put(out, m.preferredBufferMs);
+        return (int)(out - dest);
+    }
+
+    inline int write(const Answer& m, uint8_t* dest)
+    {
+        auto* out = detail::putHeader(dest, MessageType::Answer);
+        out = detail::put(out, m.sessionId);
+        out = detail::put(out, m.sampleRate);
+        out = detail::put(out, m.numChannels);
+        out = detail::put(out, m.codec);
+        out = detail::put(out, m.packetSamples);
+        out = detail::put(out, m.preferredBufferMs);
+        out = detail::put(out, m.talkbackCodecs);
+        out = detail::put(out, m.reserved);
+        return (int)(out - dest);
+    }
+
+    inline int write(const Bye& m, uint8_t* dest)
+    {
+        auto* out = detail::putHeader(dest, MessageType::Bye);
+        out = detail::put(out, m.sessionId);
+        return (int)(out - dest);
+    }
+
+    // read() erwartet dass getMessageType() den passenden Typ geliefert hat
+    inline void read(const uint8_t* data, Offer& m)
+    {
+        auto* in = data + HEADER_SIZE;
+        in = detail::get(in, m.sessionId);
+        in = detail::get(in, m.sampleRates);
+        in = detail::get(in, m.codecs);
+        in = detail::get(in, m.maxChannels);
+        in = detail::get(in, m.maxPacketBytes);
+        detail::get(in, m.preferredBufferMs);
+    }
+
+    inline void read(const uint8_t* data, Report& m)
+    {
+        auto* in = data + HEADER_SIZE;
+        in = detail::get(in, m.sessionId);
+        in = detail::get(in, m.packetsReceived);
+        in = detail::get(in, m.packetsLost);
+        in = detail::get(in, m.jitterUs);
+        in = detail::get(in, m.bufferMs);
+        detail::get(in, m.underruns);
+    }
+
+    inline void read(const uint8_t* data, Bye& m)
+    {
+        detail::get(data + HEADER_SIZE, m.sessionId);
+    }
+
+    inline int write(const MacroValues& m, MessageType type, uint8_t* dest)
+    {
+        auto* out = detail::putHeader(dest, type);
+        out = detail::put(out, m.sessionId);
+        out = detail::put(out, m.mask);
+
+        for (int i = 0; i < MAX_MACROS; ++i)
+            if ((m.mask & (1u << i)) != 0)
+                out = detail::put(out, m.values[i]);
+
+        return (int)(out - dest);
+    }
+
+    // Meters: sessionId, numChannels, numBands, dann peak/rms pro Kanal und
+    // die Bänder. Bytes wie MeterFrame (0 = 0 dBFS, 0.5 dB Schritte).
+    inline int write(uint32_t sessionId, const MeterFrame& frame, uint8_t* dest)
+    {
+        auto* out = detail::putHeader(dest, MessageType::Meters);
+        out = detail::put(out, sessionId);
+        out = detail::put(out, frame.numChannels);
+        out = detail::put(out, frame.numBands);
+
+        for (int ch = 0; ch < frame.numChannels; ++ch)
+        {
+            out = detail::put(out, frame.peak[(size_t)ch]);
+            out = detail::put(out, frame.rms[(size_t)ch]);
+        }
+
+        std::memcpy(out, frame.bands.data(), frame.numBands);
+        out += frame.numBands;
+
+        return (int)(out - dest);
+    }
+
+    // false wenn die Nachricht kürzer ist als die Maske verspricht
+    inline bool read(const uint8_t* data, int size, MacroValues& m)
+    {
+        auto* in = data + HEADER_SIZE;
+        in = detail::get(in, m.sessionId);
+        in = detail::get(in, m.mask);
+
+        int count = 0;
+        for (int i = 0; i < MAX_MACROS; ++i)
+            count += (m.mask >> i) & 1;
+
+        if (size < HEADER_SIZE + 6 + count * 2)
+            return false;
+
+        for (int i = 0; i < MAX_MACROS; ++i)
+            if ((m.mask & (1u << i)) != 0)
+                in = detail::get(in, m.values[i]);
+
+        return true;
+    }
+
+    //==========================================================================
+    // Format-Auswahl
+    //==========================================================================
+
+    struct Negotiated
+    {
+        bool valid = false;
+        PayloadFormat payload = PayloadFormat::Pcm16;
+        int numChannels = 0;
+        int maxPacketSamples = 0;   // 0 = kein Limit (Opus: immer ein Frame)
+        int preferredBufferMs = 0;
+        const char* error = "";
+    };
+
+    // Billigstes Format das beide Seiten können: Opus vor PCM16 vor PCM24.
+    // PCM braucht die Host Sample Rate beim Empfänger, Opus läuft immer mit
+    // 48 kHz auf dem Wire (der Encoder resampled).
+    inline Negotiated negotiate(const Offer& offer, double sampleRate, int numChannels,
+                                uint16_t localCodecs)
+    {
+        Negotiated result;
+        result.preferredBufferMs = offer.preferredBufferMs;
+        result.numChannels = std::min(numChannels, (int)offer.maxChannels);
+
+        if (result.numChannels <= 0)
+        {
+            result.error = "receiver accepts no channels";
+            return result;
+        }
+
+        const uint16_t common = (uint16_t)(offer.codecs & localCodecs);
+        const int headerSize = (int)AudioPacket::HEADER_SIZE;
+        const int payloadBytes = (int)offer.maxPacketBytes - headerSize;
+
+        if ((common & CODEC_OPUS) != 0 && payloadBytes >= OPUS_MAX_FRAME_BYTES)
+        {
+            result.valid = true;
+            result.payload = PayloadFormat::Opus;
+            return result;
+        }
+
+        if ((offer.sampleRates & getSampleRateBit(sampleRate)) == 0)
+        {
+            result.error = "receiver does not support the host sample rate";
+            return result;
+        }
+
+        for (auto format : { PayloadFormat::Pcm16, PayloadFormat::Pcm24 })
+        {
+            if ((common & getCodecBit(format)) == 0)
+                continue;
+
+            const int frameBytes = result.numChannels * packetizer::getBytesPerSample(format);
+            const int maxSamples = payloadBytes / frameBytes;
+
+            if (maxSamples >= MIN_PACKET_SAMPLES)
+            {
+                result.valid = true;
+                result.payload = format;
+                result.maxPacketSamples = maxSamples;
+                return result;
+            }
+        }
+
+        result.error = "no common codec fits the receiver's packet size";
+        return result;
+    }
+}
+
+} // namespace streaming
+} // namespace mix2go
@@ -0,0 +1,245 @@
+#pragma once
+
+// Kleine Client-Library für Apps auf dem selben Rechner (Broadcast Tool,
+// lokaler Recorder, zweite Audio App ...). Header-only, ohne JUCE.
+//
+// Usage:
+//   mix2go::streaming::SharedMemoryClient client;
+//   if (client.attach("/mix2go"))
+//   {
+//       // im eigenen Audio Callback, blockiert nie:
+//       int frames = client.read(interleaved, maxFrames);
+//
+//       // oder in einem eigenen Thread auf Daten warten:
+//       if (client.waitForData(256, 10))
+//           client.read(interleaved, 256);
+//   }
+//
+// isWriterActive() fragen, wenn lange nichts kommt: nach einem Absturz des
+// Plugins wird es spätestens nach shm::HEARTBEAT_TIMEOUT_MS false.
+//
+// Der Name ist der, den das Plugin im Editor anzeigt: "/mix2go", bei mehreren
+// Instanzen "/mix2go-2", "/mix2go-3" ... (siehe shm::MAX_SEGMENTS).
+//
+// Latenz = Zeit bis der Leser liest, es gibt keinen Netzwerk-Thread dazwischen.
+// read() macht keine Syscalls. waitForData() schläft per futex (Linux) und
+// pollt auf anderen POSIX Systemen in 0.25 ms Schritten.
+
+#include "SharedMemoryLayout.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+ #include <fcntl.h>
+ #include <sys/mman.h>
+ #include <unistd.h>
+ #include <ctime>
+ #if defined(__linux__)
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+ #endif
+ #define MIX2GO_SHM_SUPPORTED 1
+#else
+ #define MIX2GO_SHM_SUPPORTED 0
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace mix2go {
+namespace streaming {
+
+class SharedMemoryClient
+{
+public:
+    SharedMemoryClient() = default;
+    ~SharedMemoryClient() { detach(); }
+
+    SharedMemoryClient(const SharedMemoryClient&) = delete;
+    SharedMemoryClient& operator=(const SharedMemoryClient&) = delete;
+
+    bool attach(const char* name = shm::DEFAULT_NAME)
+    {
+        detach();
+
+       #if MIX2GO_SHM_SUPPORTED
+        const int fd = shm_open(name, O_RDWR, 0);
+        if (fd < 0)
+            return false;
+
+        void* mapped = mmap(nullptr, shm::getSegmentSize(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (mapped == MAP_FAILED)
+            return false;
+
+        m_header = static_cast<shm::SharedRingHeader*>(mapped);
+
+        if (m_header->magic != shm::MAGIC || m_header->version != shm::VERSION)
+        {
+            detach();
+            return false;
+        }
+
+        resync();
+        return true;
+       #else
+        (void)name;
+        return false;
+       #endif
+    }
+
+    void detach()
+    {
+       #if MIX2GO_SHM_SUPPORTED
+        if (m_header != nullptr)
+            munmap(m_header, shm::getSegmentSize());
+       #endif
+        m_header = nullptr;
+    }
+
+    bool isAttached() const { return m_header != nullptr; }
+
+    // false auch, wenn das Plugin abgestürzt ist oder hängt (writerActive
+    // steht dann noch auf 1, aber der Herzschlag bleibt aus)
+    bool isWriterActive() const
+    {
+        return m_header != nullptr && m_header->writerActive.load() != 0 && shm::isHeartbeatFresh(*m_header);
+    }
+
+    uint32_t getSampleRate() const { return m_header ? m_header->sampleRate.load() : 0; }
+    uint32_t getNumChannels() const { return m_header ? m_header->numChannels.load() : 0; }
+
+    // Wie oft der Leser zu langsam war und Daten übersprungen wurden
+    uint64_t getOverrunCount() const { return m_overruns; }
+
+    // true wenn sich seit dem letzten Aufruf das Format geändert hat
+    bool formatChanged()
+    {
+        if (m_header == nullptr)
+            return false;
+
+        const auto generation = m_header->formatGeneration.load(std::memory_order_acquire);
+        if (generation == m_generation)
+            return false;
+
+        resync();
+        return true;
+    }
+
+    int getNumAvailable() const
+    {
+        if (m_header == nullptr)
+            return 0;
+
+        const auto available = m_header->writePosition.load(std::memory_order_acquire) - m_readPosition;
+        return (int)std::min<uint64_t>(available, m_header->capacityFrames);
+    }
+
+    // Bis zu maxFrames interleaved Frames (numChannels floats pro Frame) lesen.
+    // Blockiert nie, gibt die Anzahl gelesener Frames zurück.
+    int read(float* interleaved, int maxFrames)
+    {
+        if (m_header == nullptr || maxFrames <= 0)
+            return 0;
+
+        formatChanged();
+
+        const uint32_t capacity = m_header->capacityFrames;
+        const uint32_t mask = capacity - 1;
+        const uint32_t stride = m_header->maxChannels;
+        const uint32_t channels = m_numChannels;
+
+        uint64_t writePosition = m_header->writePosition.load(std::memory_order_acquire);
+
+        // Zu weit hinten: auf einen halben Ring vor dem Writer springen
+        if (writePosition - m_readPosition > capacity)
+        {
+            m_readPosition = writePosition - capacity / 2;
+            ++m_overruns;
+        }
+
+        const int frames = (int)std::min<uint64_t>(writePosition - m_readPosition, (uint64_t)maxFrames);
+        const float* data = shm::getData(m_header);
+
+        for (int i = 0; i < frames; ++i)
+        {
+            const uint32_t frame = (uint32_t)(m_readPosition + (uint64_t)i) & mask;
+            std::memcpy(interleaved + (size_t)i * channels, data + (size_t)frame * stride,
+                        channels * sizeof(float));
+        }
+
+        // Hat der Writer uns während dem Kopieren überholt, sind die Daten kaputt
+        writePosition = m_header->writePosition.load(std::memory_order_acquire);
+        if (writePosition - m_readPosition > capacity)
+        {
+            m_readPosition = writePosition - capacity / 2;
+            ++m_overruns;
+            return 0;
+        }
+
+        m_readPosition += (uint64_t)frames;
+        return frames;
+    }
+
+    // Wartet bis mindestens minFrames bereit sind oder timeoutMs vorbei ist
+    bool waitForData(int minFrames, int timeoutMs)
+    {
+        if (m_header == nullptr)
+            return false;
+
+        if (getNumAvailable() >= minFrames)
+            return true;
+
+        m_header->waiters.fetch_add(1);
+
+        bool ready = false;
+        int remainingUs = timeoutMs * 1000;
+
+        while (remainingUs > 0)
+        {
+            const uint32_t sequence = m_header->wakeSequence.load();
+
+            if (getNumAvailable() >= minFrames)
+            {
+                ready = true;
+                break;
+            }
+
+           #if defined(__linux__)
+            const int sliceUs = std::min(remainingUs, 1000);
+            timespec timeout { 0, (long)sliceUs * 1000 };
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_header->wakeSequence),
+                    FUTEX_WAIT, sequence, &timeout, nullptr, 0);
+           #elif MIX2GO_SHM_SUPPORTED
+            (void)sequence;
+            const int sliceUs = std::min(remainingUs, 250);
+            timespec timeout { 0, (long)sliceUs * 1000 };
+            nanosleep(&timeout, nullptr);
+           #else
+            (void)sequence;
+            const int sliceUs = remainingUs;
+           #endif
+
+            remainingUs -= sliceUs;
+        }
+
+        m_header->waiters.fetch_sub(1);
+        return ready || getNumAvailable() >= minFrames;
+    }
+
+private:
+    void resync()
+    {
+        m_generation = m_header->formatGeneration.load(std::memory_order_acquire);
+        m_numChannels = std::min(m_header->numChannels.load(), m_header->maxChannels);
+        m_readPosition = m_header->writePosition.load(std::memory_order_acquire);
+    }
+
+    shm::SharedRingHeader* m_header = nullptr;
+    uint64_t m_readPosition = 0;
+    uint32_t m_generation = 0;
+    uint32_t m_numChannels = 0;
+    uint64_t m_overruns = 0;
+};
+
+} // namespace streaming
+} // namespace mix2go
@@ -0,0 +1,118 @@
+#pragma once
+
+// Speicher-Layout des Shared-Memory Rings für Empfänger auf dem selben Rechner.
+// Wird vom Plugin (SharedMemoryTransport) und von fremden Apps
+// (SharedMemoryClient) benutzt, deshalb ohne JUCE und nur mit festen Typen.
+//
+//   [ SharedRingHeader | float data[capacityFrames * MAX_CHANNELS] ]
+//
+// Der Writer (Audio Thread im Plugin) schreibt interleaved Frames in den Ring
+// und veröffentlicht danach writePosition (Frames seit Start, läuft nie über).
+// Leser merken sich ihre eigene Position, es gibt beliebig viele Leser.
+// Aufwecken per futex auf wakeSequence, aber nur wenn waiters > 0 ist.
+// Im Normalbetrieb also kein einziger Syscall pro Block.
+//
+// Der Writer trägt seine PID ein und schreibt alle HEARTBEAT_INTERVAL_MS
+// einen Herzschlag (auch wenn gerade kein Audio kommt). Ein abgestürztes
+// Plugin hinterlässt sein Segment mit writerActive == 1: daran, dass die PID
+// nicht mehr lebt oder der Herzschlag älter als HEARTBEAT_TIMEOUT_MS ist,
+// erkennen Clients und neue Writer, dass es verwaist ist.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__) || defined(__APPLE__)
+ #include <ctime>
+#endif
+
+namespace mix2go {
+namespace streaming {
+namespace shm {
+
+static constexpr uint32_t MAGIC = 0x4D324753;   // "M2GS"
+static constexpr uint32_t VERSION = 2;
+static constexpr uint32_t MAX_CHANNELS = 2;
+static constexpr uint32_t CAPACITY_FRAMES = 1u << 16;  // ~1.4 s @ 48 kHz
+static constexpr const char* DEFAULT_NAME = "/mix2go";
+
+// Jede Plugin-Instanz legt ihr eigenes Segment an: DEFAULT_NAME, ist das
+// schon vergeben DEFAULT_NAME-2, -3 ... bis MAX_SEGMENTS. Welchen Namen eine
+// Instanz bekommen hat, zeigt der Editor an.
+static constexpr int MAX_SEGMENTS = 16;
+
+static constexpr uint32_t HEARTBEAT_INTERVAL_MS = 500;
+static constexpr uint32_t HEARTBEAT_TIMEOUT_MS = 5000;
+
+struct SharedRingHeader
+{
+    uint32_t magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t capacityFrames = CAPACITY_FRAMES;   // immer Zweierpotenz
+    uint32_t maxChannels = MAX_CHANNELS;
+
+    // Format, geändert nur vom Writer. formatGeneration wird danach erhöht,
+    // Leser die eine neue Generation sehen synchronisieren sich neu.
+    std::atomic<uint32_t> sampleRate { 0 };
+    std::atomic<uint32_t> numChannels { 0 };
+    std::atomic<uint32_t> formatGeneration { 0 };
+
+    // 0 = kein Writer (Plugin weg oder Stream gestoppt)
+    std::atomic<uint32_t> writerActive { 0 };
+
+    // Prozess vom Writer und sein letzter Herzschlag (getMonotonicMs())
+    std::atomic<int32_t> writerPid { 0 };
+    std::atomic<uint64_t> heartbeatMs { 0 };
+
+    alignas(64) std::atomic<uint64_t> writePosition { 0 };
+
+    alignas(64) std::atomic<uint32_t> wakeSequence { 0 };
+    std::atomic<uint32_t> waiters { 0 };
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Shared memory ring needs address-free 64 bit atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "Shared memory ring needs address-free 32 bit atomics");
+
+static constexpr size_t DATA_OFFSET = (sizeof(SharedRingHeader) + 63) & ~size_t(63);
+
+inline constexpr size_t getSegmentSize()
+{
+    return DATA_OFFSET + (size_t)CAPACITY_FRAMES * MAX_CHANNELS * sizeof(float);
+}
+
+// CLOCK_MONOTONIC in ms, gilt für alle Prozesse auf dem Rechner
+inline uint64_t getMonotonicMs()
+{
+   #if defined(__linux__) || defined(__APPLE__)
+    timespec now {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000u + (uint64_t)now.tv_nsec / 1000000u;
+   #else
+    return 0;
+   #endif
+}
+
+// false, wenn der Writer seit HEARTBEAT_TIMEOUT_MS nichts mehr von sich
+// hören lassen hat (abgestürzt, hängt, oder noch nie geschlagen)
+inline bool isHeartbeatFresh(const SharedRingHeader& header)
+{
+    const auto beat = header.heartbeatMs.load(std::memory_order_acquire);
+    const auto now = getMonotonicMs();
+    return beat != 0 && (now < beat || now - beat < HEARTBEAT_TIMEOUT_MS);
+}
+
+inline float* getData(SharedRingHeader* header)
+{
+    return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(header) + DATA_OFFSET);
+}
+
+inline const float* getData(const SharedRingHeader* header)
+{
+    return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(header) + DATA_OFFSET);
+}
+
+} // namespace shm
+} // namespace streaming
+} // namespace mix2go
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_events/juce_events.h>
+#include "SharedMemoryLayout.h"
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <cerrno>
+ #include <csignal>
+ #include <fcntl.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <unistd.h>
+ #if JUCE_LINUX
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+ #endif
+#endif
+
+namespace mix2go {
+namespace streaming {
+
+// Writer-Seite des Shared-Memory Rings (Layout siehe SharedMemoryLayout.h).
+// Für Empfänger auf dem selben Rechner: kein UDP Stack, kein Network Thread,
+// der Audio Thread schreibt direkt in den Ring den der Client liest.
+//
+// open()/close()/setFormat() vom Message Thread, write() vom Audio Thread.
+// write() ist wait-free und macht nur einen Syscall (futex wake) wenn ein
+// Leser tatsächlich schläft. Beim Stoppen bleibt das Mapping bestehen
+// (setWriterActive(false)), close() erst wenn kein write() mehr kommen kann.
+//
+// Das Segment gehört genau dieser Instanz (O_EXCL), eine zweite Instanz
+// bekommt einen eigenen Namen statt den Ring der ersten zu überschreiben.
+// getName() ist der Name, an den sich ein Client hängt.
+//
+// Solange das Segment offen ist, schlägt ein Timer im Message Thread den
+// Herzschlag (siehe SharedMemoryLayout.h). Segmente von abgestürzten
+// Instanzen räumt open() weg, statt auf den nächsten Namen auszuweichen.
+class SharedMemoryTransport : private juce::Timer
+{
+public:
+    SharedMemoryTransport() = default;
+
+    ~SharedMemoryTransport() override
+    {
+        close();
+    }
+
+    static bool isSupported()
+    {
+       #if JUCE_LINUX || JUCE_MAC
+        return true;
+       #else
+        return false;
+       #endif
+    }
+
+    // baseName: gewünschter Name, vergeben wird baseName oder baseName-2 ...
+    bool open(const juce::String& baseName, double sampleRate, int numChannels)
+    {
+        if (m_header != nullptr && baseName == m_base_name)
+        {
+            setFormat(sampleRate, numChannels);
+            return true;
+        }
+
+        close();
+
+       #if JUCE_LINUX || JUCE_MAC
+        // Nur neu anlegen, nie ein bestehendes Segment übernehmen: das kann
+        // noch eine andere Instanz beschreiben (und ftruncate auf ein schon
+        // angelegtes Segment schlägt auf macOS fehl)
+        juce::String name;
+        int fd = -1;
+
+        for (int index = 1; index <= shm::MAX_SEGMENTS && fd < 0; ++index)
+        {
+            name = index == 1 ? baseName : baseName + "-" + juce::String(index);
+            fd = shm_open(name.toRawUTF8(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+            if (fd >= 0)
+                break;
+
+            if (errno != EEXIST)
+                break;
+
+            // Vergeben, aber vielleicht von einer abgestürzten Instanz
+            if (unlinkIfStale(name))
+            {
+                fd = shm_open(name.toRawUTF8(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+                if (fd < 0 && errno != EEXIST)
+                    break;
+            }
+        }
+
+        if (fd < 0)
+        {
+            DBG("[Mix2Go] shm_open failed for " << baseName);
+            return false;
+        }
+
+        const auto size = shm::getSegmentSize();
+        if (ftruncate(fd, (off_t)size) != 0)
+        {
+            DBG("[Mix2Go] ftruncate failed for " << name);
+            ::close(fd);
+            shm_unlink(name.toRawUTF8());
+            return false;
+        }
+
+        void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (mapped == MAP_FAILED)
+        {
+            DBG("[Mix2Go] mmap failed for " << name);
+            shm_unlink(name.toRawUTF8());
+            return false;
+        }
+
+        // Seiten jetzt anfassen damit der Audio Thread keine Page Faults bekommt
+        std::memset(mapped, 0, size);
+
+        m_header = new (mapped) shm::SharedRingHeader();
+        m_name = name;
+        m_base_name = baseName;
+
+        // Erst der Herzschlag, dann die PID: ein Segment mit PID aber ohne
+        // Herzschlag hielte eine andere Instanz sonst für verwaist
+        timerCallback();
+        m_header->writerPid.store((int32_t)getpid(), std::memory_order_release);
+        startTimer((int)shm::HEARTBEAT_INTERVAL_MS);
+
+        setFormat(sampleRate, numChannels);
+        m_header->writerActive.store(1, std::memory_order_release);
+
+        DBG("[Mix2Go] Shared memory ring " << name << " ready ("
+            << (int)(size / 1024) << " KB, " << (int)shm::CAPACITY_FRAMES << " frames)");
+        return true;
+       #else
+        juce::ignoreUnused(baseName, sampleRate, numChannels);
+        return false;
+       #endif
+    }
+
+    void close()
+    {
+        stopTimer();
+
+       #if JUCE_LINUX || JUCE_MAC
+        if (m_header != nullptr)
+        {
+            m_header->writerActive.store(0, std::memory_order_release);
+            wakeReaders();
+            munmap(m_header, shm::getSegmentSize());
+
+            // Nur unser eigenes Segment, angehängte Clients behalten ihr Mapping
+            shm_unlink(m_name.toRawUTF8());
+        }
+       #endif
+
+        m_header = nullptr;
+        m_name.clear();
+        m_base_name.clear();
+    }
+
+    bool isOpen() const { return m_header != nullptr; }
+
+    // Tatsächlicher Name vom Segment, leer wenn nicht offen
+    const juce::String& getName() const { return m_name; }
+
+    // Leser sehen ob gerade Audio kommt
+    void setWriterActive(bool shouldBeActive)
+    {
+        if (m_header == nullptr)
+            return;
+
+        m_header->writerActive.store(shouldBeActive ? 1 : 0, std::memory_order_release);
+        wakeReaders();
+    }
+
+    // Neues Format ankündigen. Nicht parallel zu write() aufrufen
+    // (kommt aus prepareToPlay()).
+    void setFormat(double sampleRate, int numChannels)
+    {
+        if (m_header == nullptr)
+            return;
+
+        m_header->sampleRate.store((uint32_t)sampleRate, std::memory_order_relaxed);
+        m_header->numChannels.store((uint32_t)juce::jlimit(1, (int)shm::MAX_CHANNELS, numChannels),
+                                    std::memory_order_relaxed);
+        m_header->formatGeneration.fetch_add(1, std::memory_order_release);
+        wakeReaders();
+    }
+
+    // Audio Thread
+    void write(const juce::AudioBuffer<float>& buffer)
+    {
+        auto* header = m_header;
+        if (header == nullptr)
+            return;
+
+        const int numSamples = buffer.getNumSamples();
+        const int sourceChannels = buffer.getNumChannels();
+        if (numSamples <= 0 || sourceChannels <= 0)
+            return;
+
+        const uint32_t mask = header->capacityFrames - 1;
+        const uint32_t stride = header->maxChannels;
+        const uint32_t channels = header->numChannels.load(std::memory_order_relaxed);
+        const uint64_t position = header->writePosition.load(std::memory_order_relaxed);
+        float* data = shm::getData(header);
+
+        for (uint32_t ch = 0; ch < channels; ++ch)
+        {
+            const float* source = buffer.getReadPointer(juce::jmin((int)ch, sourceChannels - 1));
+
+            for (int i = 0; i < numSamples; ++i)
+                data[(size_t)((uint32_t)(position + (uint64_t)i) & mask) * stride + ch] = source[i];
+        }
+
+        header->writePosition.store(position + (uint64_t)numSamples, std::memory_order_release);
+
+        // Pairs with waiters.fetch_add() in SharedMemoryClient::waitForData()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (header->waiters.load(std::memory_order_relaxed) != 0)
+            wakeReaders();
+    }
+
+private:
+    // Message Thread, Herzschlag für Clients und andere Instanzen
+    void timerCallback() override
+    {
+        if (m_header != nullptr)
+            m_header->heartbeatMs.store(shm::getMonotonicMs(), std::memory_order_release);
+    }
+
+   #if JUCE_LINUX || JUCE_MAC
+    // Segment von einem Writer, den es nicht mehr gibt (Prozess tot) oder der
+    // seit HEARTBEAT_TIMEOUT_MS hängt: unlinken, damit der Name wieder frei
+    // ist. Clients, die noch dranhängen, behalten ihr Mapping und sehen am
+    // Herzschlag, dass nichts mehr kommt. Fremde oder ältere Layouts und
+    // Segmente, die gerade erst angelegt werden (PID noch 0), bleiben.
+    static bool unlinkIfStale(const juce::String& name)
+    {
+        const int fd = shm_open(name.toRawUTF8(), O_RDONLY, 0);
+        if (fd < 0)
+            return errno == ENOENT;   // inzwischen weg, Name ist frei
+
+        struct stat info {};
+        const bool large_enough = fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(shm::SharedRingHeader);
+        void* mapped = large_enough ? mmap(nullptr, sizeof(shm::SharedRingHeader), PROT_READ, MAP_SHARED, fd, 0)
+                                    : MAP_FAILED;
+        ::close(fd);
+
+        if (mapped == MAP_FAILED)
+            return false;
+
+        const auto& header = *static_cast<const shm::SharedRingHeader*>(mapped);
+        bool stale = false;
+        int32_t pid = 0;
+
+        if (header.magic == shm::MAGIC && header.version == shm::VERSION)
+        {
+            pid = header.writerPid.load(std::memory_order_acquire);
+            const bool alive = pid > 0 && (kill((pid_t)pid, 0) == 0 || errno == EPERM);
+            stale = pid > 0 && (!alive || !shm::isHeartbeatFresh(header));
+        }
+
+        munmap(mapped, sizeof(shm::SharedRingHeader));
+
+        if (!stale)
+            return false;
+
+        DBG("[Mix2Go] Reclaiming stale shared memory ring " << name << " (writer pid " << pid << ")");
+        return shm_unlink(name.toRawUTF8()) == 0 || errno == ENOENT;
+    }
+   #endif
+
+    void wakeReaders()
+    {
+        if (m_header == nullptr)
+            return;
+
+        m_header->wakeSequence.fetch_add(1, std::memory_order_release);
+
+       #if JUCE_LINUX
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_header->wakeSequence),
+                FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+       #endif
+    }
+
+    shm::SharedRingHeader* m_header = nullptr;
+    juce::String m_name;
+    juce::String m_base_name;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedMemoryTransport)
+};
+
+} // namespace streaming
+} // namespace mix2go
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "AudioPacket.h"
+#include "SessionControl.h"
+
+#if MIX2GO_WITH_OPUS
+ #include "OpusDecoder.h"
+#endif
+
+namespace mix2go {
+namespace streaming {
+
+// Rückkanal: Mic-Audio vom Empfänger (Musiker am Handy) zurück ins Plugin.
+//
+//   Network Thread  → pushPacket()  Paket in eine Slot-Queue kopieren
+//   Worker Thread   → dekodieren, auf Host-Rate resamplen, ins Sample-FIFO
+//   Audio Thread    → read()        aus dem Sample-FIFO
+//
+// pushPacket() und read() sind wait-free, das Dekodieren (Opus) passiert
+// nur im Worker. Pakete: AudioPacket Header mit TALKBACK_MAGIC, Codec in
+// den Flags (PCM16 oder Opus), mono.
+//
+// Der Jitter-Puffer ist bewusst klein: für ein Gespräch ist Latenz wichtiger
+// als ab und zu ein Aussetzer. Läuft der Puffer über MAX_LATENCY_MS (Drift
+// zwischen Handy und Host Clock), wird auf TARGET_LATENCY_MS zurückgesprungen.
+class TalkbackReceiver : private juce::Thread
+{
+public:
+    static constexpr int MAX_PACKET_SIZE = 1500;
+    static constexpr int NUM_PACKET_SLOTS = 32;
+    static constexpr int TARGET_LATENCY_MS = 30;
+    static constexpr int MAX_LATENCY_MS = 80;
+
+    struct Stats
+    {
+        std::atomic<uint64_t> packetsReceived { 0 };
+        std::atomic<uint64_t> packetsLost { 0 };
+        std::atomic<uint64_t> underruns { 0 };
+        std::atomic<uint64_t> packetsDropped { 0 };   // Queue voll
+    };
+
+    TalkbackReceiver() : juce::Thread("Mix2Go Talkback")
+    {
+        m_packetSizes.fill(0);
+    }
+
+    ~TalkbackReceiver() override
+    {
+        stop();
+    }
+
+    // Codecs die der Empfänger schicken darf (session::CODEC_* Bits)
+    static uint16_t getSupportedCodecs()
+    {
+       #if MIX2GO_WITH_OPUS
+        return session::CODEC_PCM16 | session::CODEC_OPUS;
+       #else
+        return session::CODEC_PCM16;
+       #endif
+    }
+
+    // Message Thread (prepareToPlay). Hält den Worker kurz an, falls er läuft.
+    void prepare(double hostSampleRate, int maxBlockSize)
+    {
+        const bool wasRunning = isThreadRunning();
+        stop();
+
+        m_hostSampleRate = hostSampleRate;
+
+        // Platz für MAX_LATENCY_MS + ein paar Blöcke, damit der Worker nie
+        // auf den Audio Thread warten muss
+        const int fifoSize = (int)(hostSampleRate * 0.25) + maxBlockSize * 2;
+        m_samples.assign((size_t)fifoSize, 0.0f);
+        m_sampleFifo.setTotalSize(fifoSize);
+
+        m_targetLatency = (int)(hostSampleRate * TARGET_LATENCY_MS / 1000.0);
+        m_maxLatency = (int)(hostSampleRate * MAX_LATENCY_MS / 1000.0);
+
+        // Dekodierte Pakete: max. 120 ms @ 48 kHz, plus Reserve für den Resampler
+        m_decoded.assign(5760 + 8, 0.0f);
+        m_resampled.assign((size_t)(5760.0 * juce::jmax(1.0, hostSampleRate / 8000.0)) + 8, 0.0f);
+
+        if (wasRunning)
+            start();
+    }
+
+    void start()
+    {
+        if (isThreadRunning())
+            return;
+
+        m_packetFifo.reset();
+        m_sampleFifo.reset();
+        m_playing = false;
+        m_hasSequence = false;
+        m_resampler.reset();
+        m_outputFraction = 0.0;
+
+       #if MIX2GO_WITH_OPUS
+        m_opus.prepare();
+       #endif
+
+        startThread(juce::Thread::Priority::high);
+    }
+
+    void stop()
+    {
+        if (isThreadRunning())
+        {
+            signalThreadShouldExit();
+            m_packetReady.signal();
+            stopThread(1000);
+        }
+    }
+
+    const Stats& getStats() const { return m_stats; }
+
+    // Aktueller Puffer in ms (GUI)
+    float getLatencyMs() const
+    {
+        return m_hostSampleRate > 0.0 ? (float)(m_sampleFifo.getNumReady() * 1000.0 / m_hostSampleRate)
+                                      : 0.0f;
+    }
+
+    //==========================================================================
+    // Network Thread
+    //==========================================================================
+
+    void pushPacket(const uint8_t* data, int size)
+    {
+        if (size <= (int)AudioPacket::HEADER_SIZE || size > MAX_PACKET_SIZE || !isThreadRunning())
+            return;
+
+        int start1, size1, start2, size2;
+        m_packetFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+        if (size1 == 0)
+        {
+            ++m_stats.packetsDropped;
+            return;
+        }
+
+        std::memcpy(m_packets[(size_t)start1].data(), data, (size_t)size);
+        m_packetSizes[(size_t)start1] = size;
+        m_packetFifo.finishedWrite(1);
+        m_packetReady.signal();
+    }
+
+    //==========================================================================
+    // Audio Thread
+    //==========================================================================
+
+    // Schreibt Talkback in alle Kanäle von dest (mono → alle Kanäle)
+    void read(juce::AudioBuffer<float>& dest)
+    {
+        const int numSamples = dest.getNumSamples();
+        const int numChannels = dest.getNumChannels();
+
+        if (numChannels == 0 || numSamples == 0)
+            return;
+
+        dest.clear();
+
+        int ready = m_sampleFifo.getNumReady();
+
+        // Erst loslegen wenn der Jitter-Puffer gefüllt ist
+        if (!m_playing)
+        {
+            if (ready < m_targetLatency)
+                return;
+
+            m_playing = true;
+        }
+
+        // Zu viel im Puffer (Clock Drift, Burst nach WLAN Hänger): überspringen
+        if (ready > m_maxLatency + numSamples)
+        {
+            const int skip = ready - m_targetLatency - numSamples;
+            m_sampleFifo.finishedRead(skip);
+            ready -= skip;
+        }
+
+        const int toRead = juce::jmin(ready, numSamples);
+        int start1, size1, start2, size2;
+        m_sampleFifo.prepareToRead(toRead, start1, size1, start2, size2);
+
+        auto* out = dest.getWritePointer(0);
+        if (size1 > 0)
+            juce::FloatVectorOperations::copy(out, m_samples.data() + start1, size1);
+        if (size2 > 0)
+            juce::FloatVectorOperations::copy(out + size1, m_samples.data() + start2, size2);
+
+        m_sampleFifo.finishedRead(size1 + size2);
+
+        for (int ch = 1; ch < numChannels; ++ch)
+            dest.copyFrom(ch, 0, dest, 0, 0, numSamples);
+
+        if (toRead < numSamples)
+        {
+            // Leer gelaufen: Rest bleibt still, neu puffern
+            m_playing = false;
+            ++m_stats.underruns;
+        }
+    }
+
+private:
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            m_packetReady.wait(20);
+
+            int start1, size1, start2, size2;
+            for (;;)
+            {
+                m_packetFifo.prepareToRead(1, start1, size1, start2, size2);
+                if (size1 == 0)
+                    break;
+
+                decodePacket(m_packets[(size_t)start1].data(), m_packetSizes[(size_t)start1]);
+                m_packetFifo.finishedRead(1);
+            }
+        }
+    }
+
+    void decodePacket(const uint8_t* data, int size)
+    {
+        AudioPacket header;
+        if (!AudioPacket::readHeader(data, (size_t)size, header)
+            || header.magic != AudioPacket::TALKBACK_MAGIC
+            || header.numChannels == 0 || header.sampleRate == 0)
+            return;
+
+        ++m_stats.packetsReceived;
+
+        // Verlust / Reihenfolge. Verspätete Pakete wegwerfen, für ein
+        // Gespräch ist es zu spät dafür.
+        int lost = 0;
+        if (m_hasSequence)
+        {
+            const auto delta = (int32_t)(header.sequenceNumber - m_expectedSequence);
+            if (delta < 0)
+                return;
+
+            lost = juce::jmin(delta, 5);
+            m_stats.packetsLost += (uint64_t)delta;
+        }
+
+        m_hasSequence = true;
+        m_expectedSequence = header.sequenceNumber + 1;
+
+        const uint8_t* payload = data + AudioPacket::HEADER_SIZE;
+        const int payloadBytes = size - (int)AudioPacket::HEADER_SIZE;
+        const int maxSamples = (int)m_decoded.size() - 8;
+
+        if (header.getCodec() == AudioPacket::FLAG_CODEC_OPUS)
+        {
+           #if MIX2GO_WITH_OPUS
+            const int frameSize = juce::jmin((int)header.numSamples, maxSamples);
+
+            for (int i = 0; i < lost; ++i)
+                pushDecoded(m_opus.decodeLost(m_decoded.data(), frameSize), MixOpusDecoder::SAMPLE_RATE);
+
+            pushDecoded(m_opus.decode(payload, payloadBytes, m_decoded.data(), maxSamples),
+                        MixOpusDecoder::SAMPLE_RATE);
+           #endif
+            return;
+        }
+
+        if (header.getCodec() != 0)
+            return; // PCM24 kommt hier nicht vor
+
+        // PCM16, bei mehreren Kanälen nur den ersten nehmen
+        const int channels = (int)header.numChannels;
+        const int numSamples = juce::jmin(payloadBytes / (2 * channels), maxSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            int16_t value;
+            std::memcpy(&value, payload + (size_t)i * 2 * (size_t)channels, sizeof(value));
+            m_decoded[(size_t)i] = (float)value / 32768.0f;
+        }
+
+        pushDecoded(numSamples, (double)header.sampleRate);
+    }
+
+    // m_decoded[0..numSamples) auf Host-Rate bringen und ins Sample-FIFO
+    void pushDecoded(int numSamples, double sourceRate)
+    {
+        if (numSamples <= 0)
+            return;
+
+        const float* source = m_decoded.data();
+        int numOut = numSamples;
+
+        if (std::abs(sourceRate - m_hostSampleRate) > 0.5)
+        {
+            // Lagrange liest evtl. ein Sample über das Ende hinaus
+            for (int i = 0; i < 8; ++i)
+                m_decoded[(size_t)(numSamples + i)] = m_decoded[(size_t)(numSamples - 1)];
+
+            const double ratio = sourceRate / m_hostSampleRate;
+            m_outputFraction += numSamples / ratio;
+            numOut = juce::jmin((int)m_outputFraction, (int)m_resampled.size());
+            m_outputFraction -= numOut;
+
+            m_resampler.process(ratio, source, m_resampled.data(), numOut);
+            source = m_resampled.data();
+        }
+
+        int start1, size1, start2, size2;
+        m_sampleFifo.prepareToWrite(numOut, start1, size1, start2, size2);
+
+        if (size1 + size2 < numOut)
+            ++m_stats.packetsDropped;
+
+        if (size1 > 0)
+            std::memcpy(m_samples.data() + start1, source, (size_t)size1 * sizeof(float));
+        if (size2 > 0)
+            std::memcpy(m_samples.data() + start2, source + size1, (size_t)size2 * sizeof(float));
+
+        m_sampleFifo.finishedWrite(size1 + size2);
+    }
+
+    // Network Thread → Worker
+    juce::AbstractFifo m_packetFifo { NUM_PACKET_SLOTS };
+    std::array<std::array<uint8_t, MAX_PACKET_SIZE>, NUM_PACKET_SLOTS> m_packets;
+    std::array<int, NUM_PACKET_SLOTS> m_packetSizes;
+    juce::WaitableEvent m_packetReady;
+
+    // Worker → Audio Thread (mono, Host-Rate)
+    juce::AbstractFifo m_sampleFifo { 1 };
+    std::vector<float> m_samples;
+    bool m_playing = false;           // nur Audio Thread
+    int m_targetLatency = 0;
+    int m_maxLatency = 0;
+
+    // Nur Worker
+    std::vector<float> m_decoded;
+    std::vector<float> m_resampled;
+    juce::LagrangeInterpolator m_resampler;
+    double m_outputFraction = 0.0;
+    bool m_hasSequence = false;
+    uint32_t m_expectedSequence = 0;
+   #if MIX2GO_WITH_OPUS
+    MixOpusDecoder m_opus;
+   #endif
+
+    double m_hostSampleRate = 44100.0;
+    Stats m_stats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TalkbackReceiver)
+};
+
+} // namespace streaming
+} // namespace mix2go
@@ -109,6 +109,27 @@ public:
         return true;
     }
     
+    // Daten direkt aus dem Ringpuffer lesen, ohne Zwischenkopie.
+    // fn bekommt die Channel-Pointer und die beiden Bereiche (wrap around),
+    // z.B. um gleich ins Netzwerk-Paket zu konvertieren.
+    // fn(const float* const* channels, int numChannels,
+    //    int start1, int size1, int start2, int size2)
+    template <typename ReadFunction>
+    bool read(int numSamples, ReadFunction&& fn)
+    {
+        if (m_fifo.getNumReady() < numSamples)
+        {
+            m_underruns++;
+            return false;
+        }
+
+        auto scope = m_fifo.read(numSamples);
+        fn(m_buffer.getArrayOfReadPointers(), m_buffer.getNumChannels(),
+           scope.startIndex1, scope.blockSize1,
+           scope.startIndex2, scope.blockSize2);
+        return true;
+    }
+
     // Wie viel ist drin?
     int getNumReady()
     {
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace mix2go {
+namespace streaming {
+
+// Host Transport (Playhead) so wie er an die Empfänger geht. Der Audio
+// Thread nimmt ihn pro Block auf, im Paket beschreibt er immer das erste
+// Sample vom Paket. Dazwischen kann der Empfänger selbst weiterrechnen.
+//
+// Auf dem Wire (DATA_SIZE Bytes, native little endian, RTP big endian):
+//   uint16 flags          @ 0   (FLAG_*)
+//   uint8  timeSigNum     @ 2
+//   uint8  timeSigDen     @ 3
+//   float  bpm            @ 4
+//   double ppqPosition    @ 8
+//   int64  timeInSamples  @ 16
+//                           24
+struct TransportInfo
+{
+    static constexpr uint16_t FLAG_PLAYING      = 1 << 0;
+    static constexpr uint16_t FLAG_RECORDING    = 1 << 1;
+    static constexpr uint16_t FLAG_LOOPING      = 1 << 2;
+    static constexpr uint16_t FLAG_HAS_PPQ      = 1 << 3;
+    static constexpr uint16_t FLAG_HAS_BPM      = 1 << 4;
+    static constexpr uint16_t FLAG_HAS_TIME_SIG = 1 << 5;
+    static constexpr uint16_t FLAG_HAS_TIME     = 1 << 6;
+    static constexpr uint16_t FLAG_PAUSED       = 1 << 7;   // Sender pausiert (Auto-Pause)
+    static constexpr uint16_t FLAG_HAS_PLAYHEAD = 1 << 8;   // ohne: Host liefert nichts
+
+    static constexpr int DATA_SIZE = 24;
+
+    // Ohne Änderung trotzdem so oft mitschicken (neue Empfänger, Verlust)
+    static constexpr uint32_t REFRESH_INTERVAL_MS = 100;
+
+    // Auto-Pause: so oft geht ein Pausen-Hinweis ohne Audio raus
+    static constexpr uint32_t PAUSE_NOTICE_INTERVAL_MS = 1000;
+
+    // RTP Header Extension Profil ("MG"), DATA_SIZE / 4 Worte
+    static constexpr uint16_t RTP_EXTENSION_PROFILE = 0x4D47;
+
+    uint16_t flags = 0;
+    uint8_t timeSigNumerator = 4;
+    uint8_t timeSigDenominator = 4;
+    float bpm = 120.0f;
+    double ppqPosition = 0.0;
+    int64_t timeInSamples = 0;
+
+    bool hasPlayHead() const { return (flags & FLAG_HAS_PLAYHEAD) != 0; }
+    bool isPlaying() const { return (flags & FLAG_PLAYING) != 0; }
+
+    // Audio Thread, aus AudioPlayHead::getPosition()
+    static TransportInfo fromPosition(const juce::AudioPlayHead::PositionInfo& position)
+    {
+        TransportInfo info;
+        info.flags = FLAG_HAS_PLAYHEAD;
+
+        if (position.getIsPlaying())   info.flags |= FLAG_PLAYING;
+        if (position.getIsRecording()) info.flags |= FLAG_RECORDING;
+        if (position.getIsLooping())   info.flags |= FLAG_LOOPING;
+
+        if (const auto ppq = position.getPpqPosition())
+        {
+            info.flags |= FLAG_HAS_PPQ;
+            info.ppqPosition = *ppq;
+        }
+
+        if (const auto bpm = position.getBpm())
+        {
+            info.flags |= FLAG_HAS_BPM;
+            info.bpm = (float)*bpm;
+        }
+
+        if (const auto timeSig = position.getTimeSignature())
+        {
+            info.flags |= FLAG_HAS_TIME_SIG;
+            info.timeSigNumerator = (uint8_t)juce::jlimit(1, 255, timeSig->numerator);
+            info.timeSigDenominator = (uint8_t)juce::jlimit(1, 255, timeSig->denominator);
+        }
+
+        if (const auto samples = position.getTimeInSamples())
+        {
+            info.flags |= FLAG_HAS_TIME;
+            info.timeInSamples = (int64_t)*samples;
+        }
+
+        return info;
+    }
+
+    // numSamples weiter, so wie der Host es bei laufendem Transport täte
+    void advance(int64_t numSamples, double sampleRate)
+    {
+        if (!isPlaying() || numSamples == 0)
+            return;
+
+        timeInSamples += numSamples;
+
+        if ((flags & FLAG_HAS_BPM) != 0 && sampleRate > 0.0)
+            ppqPosition += (double)numSamples / sampleRate * (double)bpm / 60.0;
+    }
+
+    // Läuft *this nahtlos aus previous weiter (gleicher Zustand, kein Sprung)?
+    // previous muss schon auf die gleiche Position vorgerechnet sein.
+    bool continues(const TransportInfo& previous) const
+    {
+        if (flags != previous.flags
+            || timeSigNumerator != previous.timeSigNumerator
+            || timeSigDenominator != previous.timeSigDenominator
+            || std::abs(bpm - previous.bpm) > 0.001f)
+            return false;
+
+        // Loop, Locate oder Tempo-Automation. Rundung vom Host tolerieren.
+        return std::abs(ppqPosition - previous.ppqPosition) < 0.01
+            && std::abs(timeInSamples - previous.timeInSamples) <= 1;
+    }
+
+    void write(uint8_t* dest, bool bigEndian) const
+    {
+        uint32_t bpmBits;
+        uint64_t ppqBits;
+        std::memcpy(&bpmBits, &bpm, sizeof(bpmBits));
+        std::memcpy(&ppqBits, &ppqPosition, sizeof(ppqBits));
+
+        auto put = [bigEndian](uint8_t* out, auto value)
+        {
+            if (bigEndian)
+                value = juce::ByteOrder::swapIfLittleEndian(value);
+            std::memcpy(out, &value, sizeof(value));
+        };
+
+        put(dest, flags);
+        dest[2] = timeSigNumerator;
+        dest[3] = timeSigDenominator;
+        put(dest + 4, bpmBits);
+        put(dest + 8, ppqBits);
+        put(dest + 16, (uint64_t)timeInSamples);
+    }
+};
+
+// Ordnet die Transport-Infos der Blöcke den Samples im Stream-FIFO zu.
+//
+//   Audio Thread    → push()        pro Block, nur wenn der FIFO push klappt
+//   Network Thread  → consume()     pro gelesenem Paket
+//                   → getCurrent()  Stand am ersten Sample vom nächsten Paket
+//
+// Die Positionen zählen Samples pro FIFO-Slot (siehe AudioStreamManager).
+// Jeder Slot bekommt bei resetSlot() eine neue Stream ID, so werden alte
+// Einträge nach einem Format-Wechsel erkannt und verworfen.
+class TransportTracker
+{
+public:
+    static constexpr int QUEUE_SIZE = 256;   // reicht für ~170 ms bei 32 Sample Blöcken
+
+    // Message Thread, nie parallel zum Audio Thread (prepareToPlay, Start)
+    void resetSlot(int slot)
+    {
+        m_writePositions[(size_t)slot] = 0;
+        m_streamIds[(size_t)slot] = ++m_nextStreamId;
+    }
+
+    // Message Thread, bevor der Network Thread startet
+    void reset(int readSlot)
+    {
+        m_queue.reset();
+        resetSlot(0);
+        resetSlot(1);
+        beginRead(readSlot);
+    }
+
+    // Audio Thread. Bei voller Queue geht der Eintrag verloren, der nächste
+    // Block bringt den Stand wieder.
+    void push(int slot, const TransportInfo& info, int numSamples)
+    {
+        auto& position = m_writePositions[(size_t)slot];
+
+        int start1, size1, start2, size2;
+        m_queue.prepareToWrite(1, start1, size1, start2, size2);
+
+        if (size1 > 0)
+        {
+            m_entries[(size_t)start1] = { info, position, m_streamIds[(size_t)slot].load(std::memory_order_relaxed) };
+            m_queue.finishedWrite(1);
+        }
+
+        position += (uint64_t)numSamples;
+    }
+
+    // Network Thread: ab jetzt aus diesem Slot lesen, Position 0
+    void beginRead(int slot)
+    {
+        m_readStreamId = m_streamIds[(size_t)slot].load(std::memory_order_relaxed);
+        m_readPosition = 0;
+        m_hasCurrent = false;
+    }
+
+    void consume(int numSamples) { m_readPosition += (uint64_t)numSamples; }
+
+    // Sample-Positionen im FIFO, auch für andere Marker im Stream (DTX).
+    // Write: Audio Thread, Read: Network Thread.
+    uint64_t getWritePosition(int slot) const { return m_writePositions[(size_t)slot]; }
+    uint64_t getReadPosition() const { return m_readPosition; }
+
+    // Network Thread. false solange für diesen Slot noch nichts da ist.
+    bool getCurrent(double sampleRate, TransportInfo& out)
+    {
+        for (;;)
+        {
+            int start1, size1, start2, size2;
+            m_queue.prepareToRead(1, start1, size1, start2, size2);
+            if (size1 == 0)
+                break;
+
+            const auto& entry = m_entries[(size_t)start1];
+
+            // Schon der neue Slot, der Network Thread hat noch nicht gewechselt
+            if (entry.streamId > m_readStreamId)
+                break;
+
+            // Ältere Stream IDs sind von einem alten Slot und fliegen raus
+            if (entry.streamId == m_readStreamId)
+            {
+                // Block fängt erst im nächsten Paket an
+                if (entry.position > m_readPosition)
+                    break;
+
+                m_current = entry;
+                m_hasCurrent = true;
+            }
+
+            m_queue.finishedRead(1);
+        }
+
+        if (!m_hasCurrent)
+            return false;
+
+        out = m_current.info;
+        out.advance((int64_t)(m_readPosition - m_current.position), sampleRate);
+        return true;
+    }
+
+private:
+    struct Entry
+    {
+        TransportInfo info;
+        uint64_t position = 0;
+        uint32_t streamId = 0;
+    };
+
+    juce::AbstractFifo m_queue { QUEUE_SIZE };
+    std::array<Entry, QUEUE_SIZE> m_entries {};
+
+    // Audio Thread (und Message Thread in resetSlot)
+    std::array<uint64_t, 2> m_writePositions {};
+    std::array<std::atomic<uint32_t>, 2> m_streamIds {};
+    uint32_t m_nextStreamId = 0;
+
+    // Nur Network Thread
+    uint32_t m_readStreamId = 0;
+    uint64_t m_readPosition = 0;
+    Entry m_current;
+    bool m_hasCurrent = false;
+};
+
+} // namespace streaming
+} // namespace mix2go
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace viator::tests
+{
+    // Sekunden pro Sample als Zyklen, wenn JUCE die CPU-Frequenz kennt,
+    // sonst als Nanosekunden
+    inline juce::String formatPerSample(const double seconds, const int decimals = 2)
+    {
+        static const double cpu_hz = juce::SystemStats::getCpuSpeedInMegahertz() * 1.0e6;
+
+        return cpu_hz > 0.0
+                   ? juce::String(seconds * cpu_hz, decimals) + " cycles"
+                   : juce::String(seconds * 1.0e9, decimals) + " ns";
+    }
+
+    inline double ticksToSeconds(const juce::int64 ticks)
+    {
+        return juce::Time::highResolutionTicksToSeconds(ticks);
+    }
+}
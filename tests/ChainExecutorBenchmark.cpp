@@ -0,0 +1,104 @@
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "Engine/ChainExecutor.h"
+#include "BenchmarkUtils.h"
+
+namespace viator::tests
+{
+    // Kosten der Chain selbst: 1 .. 32 Processors, die nichts tun, in Serie,
+    // einmal ohne Mix und einmal mit Dry/Wet 50 % (Dry-Kopie und Mischen).
+    // Stereo, Mikrosekunden pro Block und Anteil an der Blockdauer.
+    class ChainExecutorBenchmark : public juce::UnitTest
+    {
+    public:
+        ChainExecutorBenchmark() : juce::UnitTest("ChainExecutor", "Mix2Go Benchmarks") {}
+
+        void runTest() override
+        {
+            using viator::engine::ChainExecutor;
+
+            beginTest("No-op stages, 1 .. 32");
+
+            constexpr double sample_rate = 48000.0;
+            constexpr int block_size = 512;
+            constexpr double seconds = 1.0;
+            const int num_blocks = juce::jmax(1, static_cast<int>(sample_rate * seconds) / block_size);
+            const double block_us = block_size * 1.0e6 / sample_rate;
+
+            juce::AudioBuffer<float> buffer(2, block_size);
+            juce::MidiBuffer midi;
+            juce::Random random(1234);
+
+            const auto measure = [&](const int num_stages, const float mix)
+            {
+                ChainExecutor executor;
+                executor.prepare(sample_rate, block_size, buffer.getNumChannels());
+
+                std::vector<std::unique_ptr<viator::dsp::processors::BaseProcessor>> stages;
+                for (int i = 0; i < num_stages; ++i)
+                {
+                    auto stage = std::make_unique<NoOpStage>();
+                    stage->prepareToPlay(sample_rate, block_size);
+                    stage->setMix(mix);
+                    ChainExecutor::prepareStage(*stage, sample_rate);
+                    stages.push_back(std::move(stage));
+                }
+
+                juce::int64 ticks = 0;
+                for (int block = 0; block < num_blocks; ++block)
+                {
+                    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                        for (int i = 0; i < block_size; ++i)
+                            buffer.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+                    const auto start = juce::Time::getHighResolutionTicks();
+                    executor.process(buffer, midi, stages);
+                    ticks += juce::Time::getHighResolutionTicks() - start;
+                }
+
+                return ticksToSeconds(ticks) * 1.0e6 / num_blocks;
+            };
+
+            for (const int num_stages : { 1, 2, 4, 8, 16, 32 })
+            {
+                const auto plain = measure(num_stages, 1.0f);
+                const auto mixed = measure(num_stages, 0.5f);
+
+                logMessage(juce::String(num_stages) + " stages, " + juce::String(block_size)
+                           + " samples: " + juce::String(plain, 2) + " us/block ("
+                           + juce::String(plain / num_stages, 3) + " us/stage, CPU "
+                           + juce::String(plain / block_us * 100.0, 3) + " %), mix 50 % "
+                           + juce::String(mixed, 2) + " us/block ("
+                           + juce::String(mixed / num_stages, 3) + " us/stage)");
+            }
+        }
+
+    private:
+        // Stereo, tut nichts, misst also nur die Chain
+        class NoOpStage : public viator::dsp::processors::BaseProcessor
+        {
+        public:
+            NoOpStage()
+                : BaseProcessor(BusesProperties().withInput("Input", juce::AudioChannelSet::stereo(), true)
+                                                 .withOutput("Output", juce::AudioChannelSet::stereo(), true)) {}
+
+            const juce::String getName() const override { return "NoOp"; }
+            void prepareToPlay(double, int) override {}
+            void releaseResources() override {}
+            void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+            double getTailLengthSeconds() const override { return 0.0; }
+            bool acceptsMidi() const override { return false; }
+            bool producesMidi() const override { return false; }
+            juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+            bool hasEditor() const override { return false; }
+            int getNumPrograms() override { return 1; }
+            int getCurrentProgram() override { return 0; }
+            void setCurrentProgram(int) override {}
+            const juce::String getProgramName(int) override { return {}; }
+            void changeProgramName(int, const juce::String&) override {}
+            void getStateInformation(juce::MemoryBlock&) override {}
+            void setStateInformation(const void*, int) override {}
+        };
+    };
+
+    static ChainExecutorBenchmark chain_executor_benchmark;
+}
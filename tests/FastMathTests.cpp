@@ -0,0 +1,138 @@
+#include <juce_dsp/juce_dsp.h>
+#include "DSP/Math/FastMath.h"
+#include "BenchmarkUtils.h"
+
+namespace viator::tests
+{
+    namespace math = viator::dsp::math;
+
+    // Die Fehlergrenzen aus FastMath.h, gegen double über den jeweiligen Bereich
+    class FastMathTests : public juce::UnitTest
+    {
+    public:
+        FastMathTests() : juce::UnitTest("FastMath", "Mix2Go") {}
+
+        void runTest() override
+        {
+            beginTest("expBounded, relative error on [-4, 4]");
+            {
+                double max_error = 0.0;
+                for (int i = 0; i <= 800000; ++i)
+                {
+                    const auto x = -4.0f + 8.0f * static_cast<float>(i) / 800000.0f;
+                    const auto reference = std::exp(static_cast<double>(x));
+                    max_error = juce::jmax(max_error, std::abs(math::expBounded(x) - reference) / reference);
+                }
+
+                logMessage("max error " + juce::String(max_error, 9));
+                expectLessThan(max_error, 1.2e-6);
+            }
+
+            beginTest("tanhUnit, absolute error on [-1, 1]");
+            {
+                double max_error = 0.0;
+                for (int i = 0; i <= 200000; ++i)
+                {
+                    const auto x = -1.0f + 2.0f * static_cast<float>(i) / 200000.0f;
+                    max_error = juce::jmax(max_error, std::abs(math::tanhUnit(x) - std::tanh(static_cast<double>(x))));
+                }
+
+                logMessage("max error " + juce::String(max_error, 9));
+                expectLessThan(max_error, 1.3e-7);
+            }
+
+            beginTest("sinTwoPi block kernel, absolute error on ±1000");
+            {
+                constexpr int num_points = 1 << 20;
+                std::vector<float> input(num_points);
+                std::vector<float> storage(num_points + 32);
+                auto *output = math::align(storage.data());
+
+                for (int i = 0; i < num_points; ++i)
+                {
+                    input[static_cast<size_t>(i)] = -1000.0f + 2000.0f * static_cast<float>(i) / (num_points - 1);
+                }
+
+                std::copy(input.begin(), input.end(), output);
+                math::sinTwoPi(output, num_points);
+
+                double max_error = 0.0;
+                for (int i = 0; i < num_points; ++i)
+                {
+                    const auto reference = std::sin(static_cast<double>(input[static_cast<size_t>(i)])
+                                                    * juce::MathConstants<double>::twoPi);
+                    max_error = juce::jmax(max_error, std::abs(output[i] - reference));
+                }
+
+                logMessage("max error " + juce::String(max_error, 9));
+                expectLessThan(max_error, 2.5e-7);
+            }
+        }
+    };
+
+    // Zyklen pro Sample von sinTwoPi() gegen std::sin bei üblichen
+    // Blockgrößen, dazu jeweils der Maximalfehler gegen double
+    class FastMathBenchmark : public juce::UnitTest
+    {
+    public:
+        FastMathBenchmark() : juce::UnitTest("FastMath", "Mix2Go Benchmarks") {}
+
+        void runTest() override
+        {
+            beginTest("sinTwoPi vs. std::sin");
+
+            constexpr double seconds = 0.5;
+            juce::Random random(1234);
+
+            for (const int block_size: {32, 64, 128, 256, 512, 1024})
+            {
+                const int num_blocks = juce::jmax(1, static_cast<int>(48000.0 * seconds) / block_size);
+                std::vector<float> input(static_cast<size_t>(block_size)), libm(static_cast<size_t>(block_size));
+                std::vector<float> storage(static_cast<size_t>(block_size) + 32);
+                auto *fast = math::align(storage.data());
+
+                juce::int64 libm_ticks = 0, fast_ticks = 0;
+                double libm_error = 0.0, fast_error = 0.0;
+
+                for (int block = 0; block < num_blocks; ++block)
+                {
+                    for (auto &x: input)
+                    {
+                        x = random.nextFloat() * 8.0f - 4.0f;
+                    }
+
+                    auto start = juce::Time::getHighResolutionTicks();
+                    for (int sample = 0; sample < block_size; ++sample)
+                    {
+                        libm[static_cast<size_t>(sample)] = std::sin(input[static_cast<size_t>(sample)]
+                                                                     * juce::MathConstants<float>::twoPi);
+                    }
+                    libm_ticks += juce::Time::getHighResolutionTicks() - start;
+
+                    std::copy(input.begin(), input.end(), fast);
+                    start = juce::Time::getHighResolutionTicks();
+                    math::sinTwoPi(fast, block_size);
+                    fast_ticks += juce::Time::getHighResolutionTicks() - start;
+
+                    for (int sample = 0; sample < block_size; ++sample)
+                    {
+                        const auto reference = std::sin(static_cast<double>(input[static_cast<size_t>(sample)])
+                                                        * juce::MathConstants<double>::twoPi);
+                        libm_error = juce::jmax(libm_error, std::abs(libm[static_cast<size_t>(sample)] - reference));
+                        fast_error = juce::jmax(fast_error, std::abs(fast[sample] - reference));
+                    }
+                }
+
+                const double samples = static_cast<double>(num_blocks) * block_size;
+                logMessage("sin, block " + juce::String(block_size) + ": std::sin "
+                           + formatPerSample(ticksToSeconds(libm_ticks) / samples)
+                           + " (error " + juce::String(libm_error, 9) + "), sinTwoPi "
+                           + formatPerSample(ticksToSeconds(fast_ticks) / samples)
+                           + " (error " + juce::String(fast_error, 9) + ")");
+            }
+        }
+    };
+
+    static FastMathTests fast_math_tests;
+    static FastMathBenchmark fast_math_benchmark;
+}
@@ -0,0 +1,25 @@
+#include <juce_gui_basics/juce_gui_basics.h>
+
+// Läuft alle Tests der Kategorie "Mix2Go", mit --benchmarks zusätzlich
+// "Mix2Go Benchmarks" (dauern ein paar Sekunden pro Test, nicht in ctest).
+// Exit Code 1 sobald ein expect() fehlschlägt.
+int main(int argc, char *argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juce_init;
+    const juce::StringArray args(argv + 1, argc - 1);
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTestsInCategory("Mix2Go");
+
+    if (args.contains("--benchmarks"))
+        runner.runTestsInCategory("Mix2Go Benchmarks");
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+    {
+        if (runner.getResult(i)->failures > 0)
+            return 1;
+    }
+
+    return 0;
+}
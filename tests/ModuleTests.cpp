@@ -0,0 +1,424 @@
+#include <juce_dsp/juce_dsp.h>
+#include "DSP/Modules/Tube.h"
+#include "DSP/Units/ConsoleModule.h"
+#include "DSP/Units/MasterBus.h"
+#include "BenchmarkUtils.h"
+
+namespace viator::tests
+{
+    namespace dsp = viator::dsp;
+
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 512;
+
+    // Stereo Rauschen in [-range, range]
+    inline void fillNoise(juce::Random &random, juce::AudioBuffer<float> &buffer, const float range)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto *data = buffer.getWritePointer(channel);
+            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            {
+                data[sample] = (random.nextFloat() * 2.0f - 1.0f) * range;
+            }
+        }
+    }
+
+    // Sekunden pro Sample (pro Kanal) für process(module, block_index) über
+    // seconds Audio, Stereo Rauschen in [-range, range]
+    template <typename Process>
+    double measureModule(const float range, const double seconds, Process &&process)
+    {
+        const int num_blocks = juce::jmax(1, static_cast<int>(kSampleRate * seconds) / kBlockSize);
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        juce::Random random(1234);
+
+        juce::int64 ticks = 0;
+        for (int block = 0; block < num_blocks; ++block)
+        {
+            fillNoise(random, buffer, range);
+
+            juce::dsp::AudioBlock<float> io(buffer);
+            const auto start = juce::Time::getHighResolutionTicks();
+            process(io, block);
+            ticks += juce::Time::getHighResolutionTicks() - start;
+        }
+
+        return ticksToSeconds(ticks) / (static_cast<double>(num_blocks) * kBlockSize * 2.0);
+    }
+
+    // Das Modul (sinTwoPi im Block) gegen die Kennlinie in double,
+    // Drive eingeschwungen
+    class ConsoleModuleTests : public juce::UnitTest
+    {
+    public:
+        ConsoleModuleTests() : juce::UnitTest("ConsoleModule", "Mix2Go") {}
+
+        void runTest() override
+        {
+            beginTest("Module vs. xn + k / 2pi * sin(2pi xn)");
+
+            constexpr float drive = 0.8f;
+            juce::dsp::ProcessSpec spec { kSampleRate, static_cast<juce::uint32>(kBlockSize), 2 };
+            juce::AudioBuffer<float> buffer(2, kBlockSize), input(2, kBlockSize);
+            juce::Random random(1234);
+
+            dsp::ConsoleModule<float> module;
+            module.prepare(spec);
+            module.setDrive(drive);
+
+            double max_error = 0.0;
+            for (int block = 0; block < 100; ++block)
+            {
+                fillNoise(random, buffer, 1.0f);
+                input.makeCopyOf(buffer, true);
+
+                juce::dsp::AudioBlock<float> io(buffer);
+                module.processBlock(io, kBlockSize);
+
+                // Die ersten Blöcke läuft noch die Drive-Rampe
+                if (block < 8)
+                    continue;
+
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    const auto *xn = input.getReadPointer(channel);
+                    const auto *yn = buffer.getReadPointer(channel);
+                    for (int sample = 0; sample < kBlockSize; ++sample)
+                    {
+                        const auto x = static_cast<double>(xn[sample]);
+                        const auto reference = x + static_cast<double>(drive) / juce::MathConstants<double>::twoPi
+                                                       * std::sin(x * juce::MathConstants<double>::twoPi);
+                        max_error = juce::jmax(max_error, std::abs(static_cast<double>(yn[sample]) - reference));
+                    }
+                }
+            }
+
+            const auto error_db = juce::Decibels::gainToDecibels(max_error, -200.0);
+            logMessage("max error " + juce::String(error_db, 1) + " dB");
+            expectLessThan(error_db, -120.0);
+        }
+    };
+
+    // SIMD-Shaper gegen die skalare Referenz (processConduction +
+    // processTube), Sweep über ±20, also weit in beide Clips
+    class TubeTests : public juce::UnitTest
+    {
+    public:
+        TubeTests() : juce::UnitTest("Tube", "Mix2Go") {}
+
+        void runTest() override
+        {
+            using Tube = dsp::Tube<float>;
+
+            beginTest("Shaper kernel vs. reference");
+
+            constexpr int num_points = 40000;
+            std::vector<float> input(num_points);
+            for (int i = 0; i < num_points; ++i)
+            {
+                input[static_cast<size_t>(i)] = -20.0f + 40.0f * static_cast<float>(i) / (num_points - 1);
+            }
+
+            std::vector<float> storage(input.size() + 16);
+            auto *aligned = dsp::math::align(storage.data());
+            std::copy(input.begin(), input.end(), aligned);
+            Tube::processShaperBlock(aligned, num_points);
+
+            double max_error = 0.0;
+            for (int i = 0; i < num_points; ++i)
+            {
+                const auto reference = Tube::processTube(Tube::processConduction(input[static_cast<size_t>(i)], 1.5f),
+                                                         1.0f, 1.5f, 1.0f, 4.0f, -1.5f);
+                max_error = juce::jmax(max_error, std::abs(static_cast<double>(aligned[i]) - reference));
+            }
+
+            const auto error_db = juce::Decibels::gainToDecibels(max_error, -200.0);
+            logMessage("max error " + juce::String(error_db, 1) + " dB");
+            expectLessThan(error_db, -100.0);
+        }
+    };
+
+    // Fused-Kernel (ohne ADAA) gegen den alten Aufbau pro Sample:
+    // juce::dsp::LinkwitzRileyFilter und die Kennlinie in double aus
+    // adaa::Poletti. Stereo mit verschiedenem Material links und rechts.
+    // Der Drive läuft von 0 über die Rampe auf 12 dB und steht dann, damit
+    // sind beide Zweige drin (Mix pro Sample und pro Block). Die Rampe ist
+    // dieselbe juce::SmoothedValue wie im BlockSmoother.
+    class MasterBusTests : public juce::UnitTest
+    {
+    public:
+        MasterBusTests() : juce::UnitTest("MasterBus", "Mix2Go") {}
+
+        void runTest() override
+        {
+            beginTest("Fused kernel vs. per-sample reference");
+
+            constexpr int num_samples = 48000;
+            constexpr float drive_db = 12.0f;
+            juce::dsp::ProcessSpec spec { kSampleRate, static_cast<juce::uint32>(kBlockSize), 2 };
+
+            juce::AudioBuffer<float> buffer(2, num_samples);
+            for (int i = 0; i < num_samples; ++i)
+            {
+                const auto t = static_cast<float>(i) / static_cast<float>(kSampleRate);
+                buffer.setSample(0, i, 1.2f * std::sin(juce::MathConstants<float>::twoPi * 110.0f * t) + 0.1f);
+                buffer.setSample(1, i, 0.8f * std::sin(juce::MathConstants<float>::twoPi * 1733.0f * t) - 0.05f);
+            }
+
+            juce::AudioBuffer<float> expected(buffer);
+
+            std::array<juce::dsp::LinkwitzRileyFilter<float>, 2> positive_filters, negative_filters;
+            for (auto *filters: { &positive_filters, &negative_filters })
+            {
+                for (auto &filter: *filters)
+                {
+                    filter.prepare(spec);
+                    filter.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+                    filter.setCutoffFrequency(5.0f);
+                }
+            }
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                juce::SmoothedValue<float> drive;
+                drive.reset(kSampleRate, 0.02);
+                drive.setTargetValue(juce::Decibels::decibelsToGain(drive_db));
+
+                auto *data = expected.getWritePointer(channel);
+                for (int i = 0; i < num_samples; ++i)
+                {
+                    const auto xn = data[i];
+                    const auto k = drive.getNextValue();
+                    const auto mix = juce::jmap(k, 1.0f, 3.1f, 0.0f, 1.0f);
+
+                    const auto curve = [k](const float x, const double lp, const double ln)
+                    {
+                        return static_cast<float>(dsp::adaa::Poletti { k, lp, ln }.f(x));
+                    };
+
+                    auto positive = curve(xn, 6.6, 0.6);
+                    auto negative = curve(xn, 0.6, 6.6);
+                    positive = positive_filters[static_cast<size_t>(channel)].processSample(channel, positive);
+                    negative = negative_filters[static_cast<size_t>(channel)].processSample(channel, negative);
+                    positive = curve(positive, 1.6, 1.6);
+                    negative = curve(negative, 1.6, 1.6);
+
+                    data[i] = (1.0f - mix) * xn + (positive + negative) * mix;
+                }
+            }
+
+            dsp::MasterBus<float> bus;
+            bus.prepare(spec);
+            bus.setAntiAliasing(dsp::adaa::Order::kOff);
+            bus.setDrive(drive_db);
+
+            for (int offset = 0; offset < num_samples; offset += kBlockSize)
+            {
+                const auto length = juce::jmin(kBlockSize, num_samples - offset);
+                juce::dsp::AudioBlock<float> io(buffer.getArrayOfWritePointers(), 2,
+                                                static_cast<size_t>(offset), static_cast<size_t>(length));
+                bus.processBlock(io, length);
+            }
+
+            double max_error = 0.0;
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int i = 0; i < num_samples; ++i)
+                {
+                    max_error = juce::jmax(max_error, static_cast<double>(std::abs(buffer.getSample(channel, i)
+                                                                                   - expected.getSample(channel, i))));
+                }
+            }
+
+            const auto error_db = juce::Decibels::gainToDecibels(max_error, -200.0);
+            logMessage("max error " + juce::String(error_db, 1) + " dB");
+            expectLessThan(error_db, -100.0);
+        }
+    };
+
+    // Zyklen pro Sample: SIMD-Shaper gegen die skalare Referenz, dann das
+    // ganze Modul ohne und mit ADAA, Drive eingeschwungen und mit laufender Rampe
+    class TubeBenchmark : public juce::UnitTest
+    {
+    public:
+        TubeBenchmark() : juce::UnitTest("Tube", "Mix2Go Benchmarks") {}
+
+        void runTest() override
+        {
+            using Tube = dsp::Tube<float>;
+
+            beginTest("Shaper and module");
+
+            constexpr double seconds = 1.0;
+            const int num_blocks = juce::jmax(1, static_cast<int>(kSampleRate * seconds) / kBlockSize);
+            juce::Random random(1234);
+
+            const auto fill = [&random](float *data, const int num_samples)
+            {
+                for (int sample = 0; sample < num_samples; ++sample)
+                {
+                    data[sample] = random.nextFloat() * 16.0f - 8.0f;
+                }
+            };
+
+            std::vector<float> storage(static_cast<size_t>(kBlockSize) + 16);
+            auto *aligned = dsp::math::align(storage.data());
+            juce::int64 reference_ticks = 0, shaper_ticks = 0;
+
+            for (int block = 0; block < num_blocks; ++block)
+            {
+                fill(aligned, kBlockSize);
+                auto start = juce::Time::getHighResolutionTicks();
+                for (int sample = 0; sample < kBlockSize; ++sample)
+                {
+                    aligned[sample] = Tube::processTube(Tube::processConduction(aligned[sample], 1.5f),
+                                                        1.0f, 1.5f, 1.0f, 4.0f, -1.5f);
+                }
+                reference_ticks += juce::Time::getHighResolutionTicks() - start;
+
+                fill(aligned, kBlockSize);
+                start = juce::Time::getHighResolutionTicks();
+                Tube::processShaperBlock(aligned, kBlockSize);
+                shaper_ticks += juce::Time::getHighResolutionTicks() - start;
+            }
+
+            const double samples = static_cast<double>(num_blocks) * kBlockSize;
+            logMessage("shaper per sample: reference " + formatPerSample(ticksToSeconds(reference_ticks) / samples)
+                       + ", kernel " + formatPerSample(ticksToSeconds(shaper_ticks) / samples));
+
+            // Ohne ADAA läuft der SIMD-Shaper, mit ADAA die Tabelle pro Sample.
+            // ramping: jeder Block bekommt ein neues Drive-Ziel, die Smoother
+            // liefern also nie eine Konstante.
+            const auto measure = [&](const dsp::adaa::Order order, const bool ramping)
+            {
+                Tube tube;
+                tube.prepare({ kSampleRate, static_cast<juce::uint32>(kBlockSize), 2 });
+                tube.setAntiAliasing(order);
+                tube.setDrive(12.0f);
+
+                return measureModule(8.0f, seconds, [&](juce::dsp::AudioBlock<float> &io, const int block)
+                {
+                    if (ramping)
+                        tube.setDrive(block % 2 == 0 ? 6.0f : 12.0f);
+
+                    tube.processBlock(io, kBlockSize);
+                });
+            };
+
+            const auto off = measure(dsp::adaa::Order::kOff, false);
+            const auto ramping = measure(dsp::adaa::Order::kOff, true);
+            const auto first = measure(dsp::adaa::Order::kFirst, false);
+            const auto second = measure(dsp::adaa::Order::kSecond, false);
+            logMessage("module per sample: off " + formatPerSample(off) + " (drive ramping "
+                       + formatPerSample(ramping) + "), ADAA 1 " + formatPerSample(first)
+                       + ", ADAA 2 " + formatPerSample(second));
+        }
+    };
+
+    // Zyklen pro Sample für das Modul gegen die alte Schleife mit std::sin
+    // pro Sample, dazu mit laufender Drive-Rampe und mit ADAA
+    class ConsoleModuleBenchmark : public juce::UnitTest
+    {
+    public:
+        ConsoleModuleBenchmark() : juce::UnitTest("ConsoleModule", "Mix2Go Benchmarks") {}
+
+        void runTest() override
+        {
+            using ConsoleModule = dsp::ConsoleModule<float>;
+
+            beginTest("Module vs. std::sin loop");
+
+            constexpr double seconds = 1.0;
+            constexpr float drive = 0.8f;
+            constexpr float two_pi = juce::MathConstants<float>::twoPi;
+
+            const auto reference = measureModule(1.0f, seconds, [&](juce::dsp::AudioBlock<float> &io, int)
+            {
+                for (size_t channel = 0; channel < io.getNumChannels(); ++channel)
+                {
+                    auto *data = io.getChannelPointer(channel);
+                    for (int sample = 0; sample < kBlockSize; ++sample)
+                    {
+                        const float xn = data[sample];
+                        data[sample] = xn + drive / two_pi * std::sin(xn * two_pi);
+                    }
+                }
+            });
+
+            // Mit ADAA läuft statt sinTwoPi adaa::SineFold pro Sample.
+            // ramping: jeder Block bekommt ein neues Drive-Ziel, der Kernel
+            // bekommt also nie eine Konstante.
+            const auto measure = [&](const dsp::adaa::Order order, const bool ramping)
+            {
+                ConsoleModule module;
+                module.prepare({ kSampleRate, static_cast<juce::uint32>(kBlockSize), 2 });
+                module.setAntiAliasing(order);
+                module.setDrive(drive);
+
+                return measureModule(1.0f, seconds, [&](juce::dsp::AudioBlock<float> &io, const int block)
+                {
+                    if (ramping)
+                        module.setDrive(block % 2 == 0 ? drive * 0.5f : drive);
+
+                    module.processBlock(io, kBlockSize);
+                });
+            };
+
+            const auto off = measure(dsp::adaa::Order::kOff, false);
+            const auto ramping = measure(dsp::adaa::Order::kOff, true);
+            const auto first = measure(dsp::adaa::Order::kFirst, false);
+            const auto second = measure(dsp::adaa::Order::kSecond, false);
+            logMessage("per sample: std::sin loop " + formatPerSample(reference) + ", module "
+                       + formatPerSample(off) + " (drive ramping " + formatPerSample(ramping) + "), ADAA 1 "
+                       + formatPerSample(first) + ", ADAA 2 " + formatPerSample(second));
+        }
+    };
+
+    // Zyklen pro Sample für das ganze Modul, Fused-Kernel (mit und ohne
+    // Drive-Rampe) und die ADAA-Stufen pro Kanal
+    class MasterBusBenchmark : public juce::UnitTest
+    {
+    public:
+        MasterBusBenchmark() : juce::UnitTest("MasterBus", "Mix2Go Benchmarks") {}
+
+        void runTest() override
+        {
+            using MasterBus = dsp::MasterBus<float>;
+
+            beginTest("Fused kernel and ADAA");
+
+            const auto measure = [&](const dsp::adaa::Order order, const bool ramping)
+            {
+                MasterBus bus;
+                juce::dsp::ProcessSpec spec { kSampleRate, static_cast<juce::uint32>(kBlockSize), 2 };
+                bus.prepare(spec);
+                bus.setAntiAliasing(order);
+                bus.setDrive(6.0f);
+
+                return measureModule(1.0f, 1.0, [&](juce::dsp::AudioBlock<float> &io, const int block)
+                {
+                    if (ramping)
+                        bus.setDrive(block % 2 == 0 ? 3.0f : 6.0f);
+
+                    bus.processBlock(io, kBlockSize);
+                });
+            };
+
+            const auto off = measure(dsp::adaa::Order::kOff, false);
+            const auto ramping = measure(dsp::adaa::Order::kOff, true);
+            const auto first = measure(dsp::adaa::Order::kFirst, false);
+            const auto second = measure(dsp::adaa::Order::kSecond, false);
+            logMessage("module per sample: fused " + formatPerSample(off) + " (drive ramping "
+                       + formatPerSample(ramping) + "), ADAA 1 " + formatPerSample(first)
+                       + ", ADAA 2 " + formatPerSample(second));
+        }
+    };
+
+    static TubeTests tube_tests;
+    static ConsoleModuleTests console_module_tests;
+    static MasterBusTests master_bus_tests;
+    static TubeBenchmark tube_benchmark;
+    static ConsoleModuleBenchmark console_module_benchmark;
+    static MasterBusBenchmark master_bus_benchmark;
+}
@@ -0,0 +1,80 @@
+#include <juce_dsp/juce_dsp.h>
+#include "DSP/Modules/Oversampler.h"
+#include "BenchmarkUtils.h"
+
+namespace viator::tests
+{
+    // Zyklen pro Sample (Basisrate, pro Kanal) für Hoch + Runter, gegen
+    // juce::dsp::Oversampling mit dem Halbband-IIR in maximaler Qualität.
+    // Stereo Rauschen, 512er Blöcke, zwei Sekunden pro Faktor.
+    class OversamplerBenchmark : public juce::UnitTest
+    {
+    public:
+        OversamplerBenchmark() : juce::UnitTest("Oversampler", "Mix2Go Benchmarks") {}
+
+        void runTest() override
+        {
+            using Oversampler = viator::dsp::Oversampler;
+
+            beginTest("FIR vs. JUCE IIR");
+
+            constexpr int num_channels = 2;
+            constexpr int block_size = 512;
+            constexpr double seconds = 2.0;
+            const int num_blocks = juce::jmax(1, static_cast<int>(48000.0 * seconds) / block_size);
+
+            juce::AudioBuffer<float> buffer(num_channels, block_size);
+            juce::Random random(1234);
+
+            const auto measure = [&](auto &oversampler)
+            {
+                oversampler.initProcessing(static_cast<size_t>(block_size));
+
+                juce::int64 ticks = 0;
+                for (int block = 0; block < num_blocks; ++block)
+                {
+                    for (int channel = 0; channel < num_channels; ++channel)
+                    {
+                        for (int sample = 0; sample < block_size; ++sample)
+                        {
+                            buffer.setSample(channel, sample, random.nextFloat() * 2.0f - 1.0f);
+                        }
+                    }
+
+                    juce::dsp::AudioBlock<float> io(buffer);
+                    const auto start = juce::Time::getHighResolutionTicks();
+                    oversampler.processSamplesUp(io);
+                    oversampler.processSamplesDown(io);
+                    ticks += juce::Time::getHighResolutionTicks() - start;
+                }
+
+                const double samples = static_cast<double>(num_blocks) * block_size * num_channels;
+                return ticksToSeconds(ticks) / samples;
+            };
+
+            for (size_t factor = 1; factor <= 4; ++factor)
+            {
+                juce::dsp::Oversampling<float> iir(num_channels, factor,
+                                                   juce::dsp::Oversampling<float>::FilterType::filterHalfBandPolyphaseIIR,
+                                                   true);
+                Oversampler linear(num_channels, factor, Oversampler::Phase::kLinear);
+                Oversampler minimum(num_channels, factor, Oversampler::Phase::kMinimum);
+                Oversampler planar(num_channels, factor, Oversampler::Phase::kLinear, Oversampler::Quality::kHigh, false);
+
+                const auto iir_time = measure(iir);
+                const auto linear_time = measure(linear);
+                const auto planar_time = measure(planar);
+                const auto minimum_time = measure(minimum);
+
+                logMessage(juce::String(1 << factor) + "X per sample: JUCE IIR "
+                           + formatPerSample(iir_time, 1) + " (" + juce::String(iir.getLatencyInSamples(), 2)
+                           + " smp), FIR linear " + formatPerSample(linear_time, 1) + " ("
+                           + juce::String(linear.getLatencyInSamples(), 2) + " smp), FIR linear planar "
+                           + formatPerSample(planar_time, 1) + ", FIR minimum " + formatPerSample(minimum_time, 1) + " ("
+                           + juce::String(minimum.getLatencyInSamples(), 2) + " smp)");
+            }
+        }
+    };
+
+    static OversamplerBenchmark oversampler_benchmark;
+}
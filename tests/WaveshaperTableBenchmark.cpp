@@ -0,0 +1,91 @@
+#include <juce_dsp/juce_dsp.h>
+#include "DSP/Modules/WaveshaperTable.h"
+#include "BenchmarkUtils.h"
+
+namespace viator::tests
+{
+    // Der Clipper Soft Clip aus der Tabelle gegen die Kennlinie direkt
+    // (std::atan pro Sample), Drive eingeschwungen, Rauschen ±1.5. Dazu der
+    // Maximalfehler der Tabelle gegen atan in double.
+    class WaveshaperTableBenchmark : public juce::UnitTest
+    {
+    public:
+        WaveshaperTableBenchmark() : juce::UnitTest("WaveshaperTable", "Mix2Go Benchmarks") {}
+
+        void runTest() override
+        {
+            beginTest("Soft clip table vs. std::atan");
+
+            constexpr int block_size = 512;
+            constexpr double seconds = 2.0;
+            const int num_blocks = juce::jmax(1, static_cast<int>(48000.0 * seconds) / block_size);
+
+            for (const float drive_db: {0.0f, 12.0f, 30.0f})
+            {
+                const auto drive = juce::Decibels::decibelsToGain(drive_db);
+                const viator::dsp::ParameterRamp<float> ramp { nullptr, drive };
+
+                viator::dsp::WaveshaperTable<SoftClipCurve> table;
+                std::vector<float> input(block_size), shaped(block_size), direct(block_size);
+                juce::Random random(1234);
+
+                // Die Tabelle baut der Builder Thread, bis dahin rechnet
+                // process() die Kennlinie direkt
+                for (int i = 0; i < 20; ++i)
+                {
+                    table.process(shaped.data(), ramp, block_size, drive);
+                    juce::Thread::sleep(5);
+                }
+
+                juce::int64 table_ticks = 0, direct_ticks = 0;
+                double max_error = 0.0;
+
+                for (int block = 0; block < num_blocks; ++block)
+                {
+                    for (auto &x: input)
+                    {
+                        x = (random.nextFloat() * 2.0f - 1.0f) * 1.5f;
+                    }
+
+                    std::copy(input.begin(), input.end(), shaped.begin());
+                    auto start = juce::Time::getHighResolutionTicks();
+                    table.process(shaped.data(), ramp, block_size, drive);
+                    table_ticks += juce::Time::getHighResolutionTicks() - start;
+
+                    std::copy(input.begin(), input.end(), direct.begin());
+                    start = juce::Time::getHighResolutionTicks();
+                    for (auto &x: direct)
+                    {
+                        x = table.getCurve()(x, drive);
+                    }
+                    direct_ticks += juce::Time::getHighResolutionTicks() - start;
+
+                    for (size_t i = 0; i < input.size(); ++i)
+                    {
+                        const auto reference = std::atan(static_cast<double>(input[i]) * drive)
+                                               * 4.0 / juce::MathConstants<double>::pi;
+                        max_error = juce::jmax(max_error, std::abs(shaped[i] - reference));
+                    }
+                }
+
+                const double samples = static_cast<double>(num_blocks) * block_size;
+                logMessage("drive " + juce::String(drive_db, 0) + " dB per sample: table "
+                           + formatPerSample(ticksToSeconds(table_ticks) / samples) + ", std::atan "
+                           + formatPerSample(ticksToSeconds(direct_ticks) / samples) + " (table error "
+                           + juce::String(juce::Decibels::gainToDecibels(max_error, -200.0), 1) + " dB)");
+            }
+        }
+
+    private:
+        // Wie ClipperProcessBlock::SoftClipCurve
+        struct SoftClipCurve
+        {
+            float operator()(const float x, const float drive) const
+            {
+                return std::atan(x * drive) * (4.0f / juce::MathConstants<float>::pi);
+            }
+        };
+    };
+
+    static WaveshaperTableBenchmark waveshaper_table_benchmark;
+}